@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Pilot
+{
+    /// Offline converter of source assets into the cooked binary assets loaded by AssetManager.
+    /// An asset is picked by the suffix of its file name, read into its reflected type and written with
+    /// PBinarySerializer, together with the size, write time and content hash of the files it was built from.
+    class AssetCooker
+    {
+    public:
+        struct CookResult
+        {
+            uint32_t m_cooked_count {0};
+            uint32_t m_up_to_date_count {0};
+            uint32_t m_failed_count {0};
+        };
+
+        AssetCooker();
+
+        // cook every asset under the asset folder, forced cooking ignores the cooked assets already there
+        CookResult cookAll(bool is_forced);
+
+        bool canCook(const std::string& asset_url) const;
+        // return false if the asset can not be read or the cooked file can not be written
+        bool cookAsset(const std::string& asset_url);
+        bool isCookedUpToDate(const std::string& asset_url) const;
+
+    private:
+        // read the source of asset_url into an archive of type_name, add the files it depends on
+        using CookFunction = bool (*)(const std::string&        asset_url,
+                                      const std::string&        type_name,
+                                      std::vector<uint8_t>&     out_archive,
+                                      std::vector<std::string>& out_dependency_urls);
+
+        struct CookRule
+        {
+            std::string  m_suffix;
+            std::string  m_type_name;
+            CookFunction m_cook_func;
+        };
+
+        const CookRule* findCookRule(const std::string& asset_url) const;
+
+        std::vector<CookRule> m_cook_rules;
+    };
+} // namespace Pilot
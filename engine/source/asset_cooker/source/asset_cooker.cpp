@@ -0,0 +1,258 @@
+#include "asset_cooker/include/asset_cooker.h"
+
+#include "runtime/core/base/macro.h"
+#include "runtime/core/meta/serializer/binary_serializer.h"
+
+#include "runtime/resource/asset_manager/asset_manager.h"
+#include "runtime/resource/asset_manager/cooked_asset.h"
+#include "runtime/resource/config_manager/config_manager.h"
+#include "runtime/resource/res_type/data/animation_clip.h"
+#include "runtime/resource/res_type/data/animation_skeleton_node_map.h"
+#include "runtime/resource/res_type/data/material.h"
+#include "runtime/resource/res_type/data/mesh_data.h"
+#include "runtime/resource/res_type/data/skeleton_data.h"
+#include "runtime/resource/res_type/data/skeleton_mask.h"
+
+#include "runtime/function/global/global_context.h"
+#include "runtime/function/render/render_resource_base.h"
+
+#include <filesystem>
+#include <fstream>
+
+namespace Pilot
+{
+    namespace
+    {
+        bool readFile(const std::filesystem::path& path, std::string& out_content)
+        {
+            std::ifstream file(path, std::ios::binary | std::ios::ate);
+            if (!file)
+            {
+                return false;
+            }
+
+            const std::streamsize file_size = file.tellg();
+            file.seekg(0, std::ios::beg);
+
+            out_content.resize(static_cast<size_t>(file_size));
+            return file_size == 0 || file.read(out_content.data(), file_size).good();
+        }
+
+        bool writeFile(const std::filesystem::path& path, const std::vector<uint8_t>& content)
+        {
+            std::error_code error;
+            std::filesystem::create_directories(path.parent_path(), error);
+
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            if (!file)
+            {
+                return false;
+            }
+            file.write(reinterpret_cast<const char*>(content.data()), static_cast<std::streamsize>(content.size()));
+            return file.flush().good();
+        }
+
+        std::filesystem::path getCookedPath(const std::string& asset_url)
+        {
+            return CookedAsset::getCookedPath(g_runtime_global_context.m_config_manager->getCookedFolder(), asset_url);
+        }
+
+        // the json source itself, AssetManager::loadAsset would take the cooked asset when it is up to date
+        template<typename AssetType>
+        bool cookJsonAsset(const std::string&        asset_url,
+                           const std::string&        type_name,
+                           std::vector<uint8_t>&     out_archive,
+                           std::vector<std::string>& out_dependency_urls)
+        {
+            static_assert(is_cookable_asset<AssetType>::value, "loadAsset would not read the cooked type");
+
+            std::string asset_json_text;
+            if (!readFile(g_runtime_global_context.m_config_manager->getRootFolder() / asset_url, asset_json_text))
+            {
+                LOG_ERROR("open file: {} failed!", asset_url);
+                return false;
+            }
+
+            std::string error;
+            auto&&      asset_json = PJsonParser::parse(asset_json_text, error);
+            if (!error.empty())
+            {
+                LOG_ERROR("parse json file {} failed!", asset_url);
+                return false;
+            }
+
+            AssetType asset;
+            PSerializer::read(asset_json, asset);
+            PBinarySerializer::write(asset, type_name, out_archive);
+
+            out_dependency_urls.push_back(asset_url);
+            return true;
+        }
+
+        bool cookObjMesh(const std::string&        asset_url,
+                         const std::string&        type_name,
+                         std::vector<uint8_t>&     out_archive,
+                         std::vector<std::string>& out_dependency_urls)
+        {
+            const std::filesystem::path mesh_path =
+                g_runtime_global_context.m_config_manager->getRootFolder() / asset_url;
+
+            MeshData mesh_data;
+            if (!RenderResourceBase::loadObjMesh(mesh_path.generic_string(), mesh_data))
+            {
+                return false;
+            }
+            PBinarySerializer::write(mesh_data, type_name, out_archive);
+
+            out_dependency_urls.push_back(asset_url);
+            return true;
+        }
+    } // namespace
+
+    AssetCooker::AssetCooker() :
+        m_cook_rules {{".animation_clip.json", "AnimationAsset", cookJsonAsset<AnimationAsset>},
+                      {".skeleton.json", "SkeletonData", cookJsonAsset<SkeletonData>},
+                      {".skeleton_map.json", "AnimSkelMap", cookJsonAsset<AnimSkelMap>},
+                      {".skeleton_mask.json", "BoneBlendMask", cookJsonAsset<BoneBlendMask>},
+                      {".material.json", "MaterialRes", cookJsonAsset<MaterialRes>},
+                      {".mesh.json", "MeshData", cookJsonAsset<MeshData>},
+                      {".obj", "MeshData", cookObjMesh}}
+    {}
+
+    AssetCooker::CookResult AssetCooker::cookAll(bool is_forced)
+    {
+        CookResult result;
+
+        const std::shared_ptr<ConfigManager>& config_manager = g_runtime_global_context.m_config_manager;
+        if (config_manager->getCookedFolder().empty())
+        {
+            LOG_ERROR("no CookedFolder in the config file, nothing to cook");
+            return result;
+        }
+
+        for (const auto& directory_entry :
+             std::filesystem::recursive_directory_iterator(config_manager->getAssetFolder()))
+        {
+            if (!directory_entry.is_regular_file())
+            {
+                continue;
+            }
+
+            const std::string asset_url =
+                directory_entry.path().lexically_relative(config_manager->getRootFolder()).generic_string();
+            if (!canCook(asset_url))
+            {
+                continue;
+            }
+
+            if (!is_forced && isCookedUpToDate(asset_url))
+            {
+                ++result.m_up_to_date_count;
+            }
+            else if (cookAsset(asset_url))
+            {
+                ++result.m_cooked_count;
+            }
+            else
+            {
+                ++result.m_failed_count;
+            }
+        }
+
+        LOG_INFO("cooked {} assets, {} up to date, {} failed",
+                 result.m_cooked_count,
+                 result.m_up_to_date_count,
+                 result.m_failed_count);
+        return result;
+    }
+
+    bool AssetCooker::canCook(const std::string& asset_url) const { return findCookRule(asset_url) != nullptr; }
+
+    bool AssetCooker::cookAsset(const std::string& asset_url)
+    {
+        const CookRule* cook_rule = findCookRule(asset_url);
+        if (cook_rule == nullptr)
+        {
+            LOG_ERROR("no cook rule for {}", asset_url);
+            return false;
+        }
+
+        CookedAssetHeader        header;
+        std::vector<uint8_t>     archive;
+        std::vector<std::string> dependency_urls;
+        header.m_type_name = cook_rule->m_type_name;
+        if (!cook_rule->m_cook_func(asset_url, cook_rule->m_type_name, archive, dependency_urls))
+        {
+            LOG_ERROR("cook {} failed", asset_url);
+            return false;
+        }
+
+        const std::filesystem::path& root_folder = g_runtime_global_context.m_config_manager->getRootFolder();
+        for (const std::string& dependency_url : dependency_urls)
+        {
+            CookedAssetDependency dependency;
+            if (!CookedAsset::makeDependency(root_folder, dependency_url, dependency))
+            {
+                LOG_ERROR("hash dependency {} of {} failed", dependency_url, asset_url);
+                return false;
+            }
+            header.m_dependencies.push_back(std::move(dependency));
+        }
+
+        std::vector<uint8_t> cooked_data;
+        CookedAsset::write(header, archive, cooked_data);
+        if (!writeFile(getCookedPath(asset_url), cooked_data))
+        {
+            LOG_ERROR("write cooked asset {} failed", asset_url);
+            return false;
+        }
+
+        LOG_INFO("cooked {}", asset_url);
+        return true;
+    }
+
+    bool AssetCooker::isCookedUpToDate(const std::string& asset_url) const
+    {
+        std::string cooked_content;
+        if (!readFile(getCookedPath(asset_url), cooked_content))
+        {
+            return false;
+        }
+
+        const uint8_t*    cooked_data = reinterpret_cast<const uint8_t*>(cooked_content.data());
+        CookedAssetHeader header;
+        size_t            archive_offset = 0;
+        if (!CookedAsset::readHeader(cooked_data, cooked_content.size(), header, archive_offset))
+        {
+            return false;
+        }
+
+        const std::filesystem::path& root_folder = g_runtime_global_context.m_config_manager->getRootFolder();
+        for (const CookedAssetDependency& dependency : header.m_dependencies)
+        {
+            if (!CookedAsset::isUpToDate(root_folder, dependency))
+            {
+                return false;
+            }
+        }
+
+        // a reflected field changed since the asset was cooked
+        PJson archive_json;
+        return PBinarySerializer::readJson(
+            cooked_data + archive_offset, cooked_content.size() - archive_offset, header.m_type_name, archive_json);
+    }
+
+    const AssetCooker::CookRule* AssetCooker::findCookRule(const std::string& asset_url) const
+    {
+        for (const CookRule& cook_rule : m_cook_rules)
+        {
+            const std::string& suffix = cook_rule.m_suffix;
+            if (asset_url.size() >= suffix.size() &&
+                asset_url.compare(asset_url.size() - suffix.size(), suffix.size(), suffix) == 0)
+            {
+                return &cook_rule;
+            }
+        }
+        return nullptr;
+    }
+} // namespace Pilot
@@ -0,0 +1,35 @@
+#include <filesystem>
+#include <string>
+
+#include "runtime/engine.h"
+
+#include "asset_cooker/include/asset_cooker.h"
+
+// https://gcc.gnu.org/onlinedocs/cpp/Stringizing.html
+#define PILOT_XSTR(s) PILOT_STR(s)
+#define PILOT_STR(s) #s
+
+// usage: PilotAssetCooker [--force]
+int main(int argc, char** argv)
+{
+    std::filesystem::path pilot_root_folder = std::filesystem::path(PILOT_XSTR(PILOT_ROOT_DIR));
+
+    Pilot::EngineInitParams params;
+    params.m_root_folder      = pilot_root_folder;
+    params.m_config_file_path = pilot_root_folder / "PilotEditor.ini";
+    params.m_is_headless      = true;
+
+    const bool is_forced = argc > 1 && std::string(argv[1]) == "--force";
+
+    Pilot::PilotEngine* engine = new Pilot::PilotEngine();
+
+    engine->startEngine(params);
+
+    Pilot::AssetCooker                  cooker;
+    const Pilot::AssetCooker::CookResult result = cooker.cookAll(is_forced);
+
+    engine->shutdownEngine();
+    delete engine;
+
+    return result.m_failed_count == 0 ? 0 : 1;
+}
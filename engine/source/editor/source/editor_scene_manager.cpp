@@ -413,9 +413,8 @@ namespace Pilot
 
             g_editor_global_context.m_render_system->setVisibleAxis(m_translation_axis);
 
-            transform_component->setPosition(new_translation);
-            transform_component->setRotation(new_rotation);
-            transform_component->setScale(new_scale);
+            // the gizmo works in world space, the component converts into the space of its parent
+            transform_component->setWorldMatrix(new_model_matrix);
         }
         else if (m_axis_mode == EditorAxisMode::RotateMode) // rotate
         {
@@ -471,15 +470,7 @@ namespace Pilot
             new_model_matrix = new_model_matrix * Matrix4x4(model_rotation);
             new_model_matrix =
                 new_model_matrix * Matrix4x4::buildScaleMatrix(model_scale.x, model_scale.y, model_scale.z);
-            Vector3    new_scale;
-            Quaternion new_rotation;
-            Vector3    new_translation;
-
-            new_model_matrix.decomposition(new_translation, new_scale, new_rotation);
-
-            transform_component->setPosition(new_translation);
-            transform_component->setRotation(new_rotation);
-            transform_component->setScale(new_scale);
+            transform_component->setWorldMatrix(new_model_matrix);
             m_scale_aixs.m_model_matrix = new_model_matrix;
         }
         else if (m_axis_mode == EditorAxisMode::ScaleMode) // scale
@@ -519,14 +510,8 @@ namespace Pilot
             Matrix4x4 scale_mat;
             scale_mat.makeTransform(Vector3::ZERO, new_model_scale, Quaternion::IDENTITY);
             new_model_matrix = axis_model_matrix * scale_mat;
-            Vector3    new_scale;
-            Quaternion new_rotation;
-            Vector3    new_translation;
-            new_model_matrix.decomposition(new_translation, new_scale, new_rotation);
 
-            transform_component->setPosition(new_translation);
-            transform_component->setRotation(new_rotation);
-            transform_component->setScale(new_scale);
+            transform_component->setWorldMatrix(new_model_matrix);
         }
         setSelectedObjectMatrix(new_model_matrix);
     }
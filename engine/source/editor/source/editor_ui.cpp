@@ -6,6 +6,7 @@
 
 #include "runtime/core/base/macro.h"
 #include "runtime/core/meta/reflection/reflection.h"
+#include "runtime/core/profile/profiler.h"
 
 #include "runtime/platform/path/path.h"
 
@@ -327,6 +328,21 @@ namespace Pilot
                 {
                     g_runtime_global_context.m_world_manager->saveCurrentLevel();
                 }
+#ifdef ENABLE_PROFILER
+                if (ImGui::MenuItem("Export Profiler Trace"))
+                {
+                    const std::filesystem::path trace_path =
+                        g_runtime_global_context.m_config_manager->getRootFolder() / "profiler_trace.json";
+                    if (Profiler::exportChromeTrace(trace_path))
+                    {
+                        LOG_INFO("profiler trace exported to {}", trace_path.generic_string());
+                    }
+                    else
+                    {
+                        LOG_ERROR("failed to export profiler trace to {}", trace_path.generic_string());
+                    }
+                }
+#endif
                 if (ImGui::MenuItem("Exit"))
                 {
                     g_editor_global_context.m_engine_runtime->shutdownEngine();
@@ -358,11 +374,10 @@ namespace Pilot
             return;
 
         const LevelObjectsMap& all_gobjects = current_active_level->getAllGObjects();
-        for (auto& id_object_pair : all_gobjects)
+        for (const std::shared_ptr<GObject>& object : all_gobjects)
         {
-            const GObjectID          object_id = id_object_pair.first;
-            std::shared_ptr<GObject> object    = id_object_pair.second;
-            const std::string        name      = object->getName();
+            const GObjectID   object_id = object->getID();
+            const std::string name      = object->getName();
             if (name.size() > 0)
             {
                 if (ImGui::Selectable(name.c_str(),
@@ -399,24 +414,24 @@ namespace Pilot
 
     void EditorUI::createLeafNodeUI(Reflection::ReflectionInstance& instance)
     {
-        Reflection::FieldAccessor* fields;
-        int                        fields_count = instance.m_meta.getFieldsList(fields);
+        // the fields are the cached ones of the meta, walking them does not allocate
+        const std::vector<Reflection::FieldAccessor>& fields = instance.m_meta.getFields();
 
-        for (size_t index = 0; index < fields_count; index++)
+        for (size_t index = 0; index < fields.size(); index++)
         {
             auto fields_count = fields[index];
             if (fields_count.isArrayType())
             {
 
                 Reflection::ArrayAccessor array_accessor;
-                if (Reflection::TypeMeta::newArrayAccessorFromName(fields_count.getFieldTypeName(), array_accessor))
+                if (fields_count.getArrayAccessor(array_accessor))
                 {
                     void* field_instance = fields_count.get(instance.m_instance);
                     int   array_count    = array_accessor.getSize(field_instance);
                     m_editor_ui_creator["TreeNodePush"](
                         std::string(fields_count.getFieldName()) + "[" + std::to_string(array_count) + "]", nullptr);
-                    auto item_type_meta_item =
-                        Reflection::TypeMeta::newMetaFromName(array_accessor.getElementTypeName());
+                    const Reflection::TypeMeta& item_type_meta_item =
+                        Reflection::TypeMeta::getMetaFromName(array_accessor.getElementTypeName());
                     auto item_ui_creator_iterator = m_editor_ui_creator.find(item_type_meta_item.getTypeName());
                     for (int index = 0; index < array_count; index++)
                     {
@@ -424,8 +439,7 @@ namespace Pilot
                         {
                             m_editor_ui_creator["TreeNodePush"]("[" + std::to_string(index) + "]", nullptr);
                             auto object_instance = Reflection::ReflectionInstance(
-                                Pilot::Reflection::TypeMeta::newMetaFromName(item_type_meta_item.getTypeName().c_str()),
-                                array_accessor.get(index, field_instance));
+                                item_type_meta_item, array_accessor.get(index, field_instance));
                             createComponentUI(object_instance);
                             m_editor_ui_creator["TreeNodePop"]("[" + std::to_string(index) + "]", nullptr);
                         }
@@ -445,8 +459,7 @@ namespace Pilot
             auto ui_creator_iterator = m_editor_ui_creator.find(fields_count.getFieldTypeName());
             if (ui_creator_iterator == m_editor_ui_creator.end())
             {
-                Reflection::TypeMeta field_meta =
-                    Reflection::TypeMeta::newMetaFromName(fields_count.getFieldTypeName());
+                Reflection::TypeMeta field_meta;
                 if (fields_count.getTypeMeta(field_meta))
                 {
                     auto child_instance =
@@ -471,7 +484,6 @@ namespace Pilot
                                                                      fields_count.get(instance.m_instance));
             }
         }
-        delete[] fields;
     }
 
     void EditorUI::showEditorDetailWindow(bool* p_open)
@@ -506,9 +518,11 @@ namespace Pilot
         auto&&                 selected_object_components = selected_object->getComponents();
         for (auto component_ptr : selected_object_components)
         {
+            // the widgets below write the fields in place, the next save serializes the object again
+            component_ptr->markSaveDirty();
             m_editor_ui_creator["TreeNodePush"](("<" + component_ptr.getTypeName() + ">").c_str(), nullptr);
             auto object_instance = Reflection::ReflectionInstance(
-                Pilot::Reflection::TypeMeta::newMetaFromName(component_ptr.getTypeName().c_str()),
+                Pilot::Reflection::TypeMeta::getMetaFromName(component_ptr.getTypeName()),
                 component_ptr.operator->());
             createComponentUI(object_instance);
             m_editor_ui_creator["TreeNodePop"](("<" + component_ptr.getTypeName() + ">").c_str(), nullptr);
@@ -0,0 +1,61 @@
+#include <csignal>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+
+#include "runtime/engine.h"
+
+// https://gcc.gnu.org/onlinedocs/cpp/Stringizing.html
+#define PILOT_XSTR(s) PILOT_STR(s)
+#define PILOT_STR(s) #s
+
+namespace
+{
+    Pilot::PilotEngine* g_launched_engine {nullptr};
+
+    // a headless run has no window to close, ctrl+c stops it after the current frame
+    void onInterrupt(int) { g_launched_engine->requestQuit(); }
+} // namespace
+
+// usage: PilotLauncher [--headless [frame rate]]
+// runs the default level in game mode without the editor, the render thread is used when EnableRenderThread is set.
+// --headless ticks the world only, without window, input and renderer, at the given frame rate or as fast as possible
+int main(int argc, char** argv)
+{
+    std::filesystem::path pilot_root_folder = std::filesystem::path(PILOT_XSTR(PILOT_ROOT_DIR));
+
+    Pilot::EngineInitParams params;
+    params.m_root_folder      = pilot_root_folder;
+    params.m_config_file_path = pilot_root_folder / "PilotEditor.ini";
+
+    for (int arg_index = 1; arg_index < argc; ++arg_index)
+    {
+        if (std::string(argv[arg_index]) == "--headless")
+        {
+            params.m_is_headless = true;
+            if (arg_index + 1 < argc && argv[arg_index + 1][0] != '-')
+            {
+                params.m_headless_frame_rate = std::strtof(argv[++arg_index], nullptr);
+            }
+        }
+    }
+
+    Pilot::PilotEngine* engine = new Pilot::PilotEngine();
+
+    engine->startEngine(params);
+    engine->initialize();
+
+    g_launched_engine = engine;
+    if (params.m_is_headless)
+    {
+        std::signal(SIGINT, onInterrupt);
+    }
+
+    engine->run();
+
+    engine->clear();
+    engine->shutdownEngine();
+    delete engine;
+
+    return 0;
+}
@@ -0,0 +1,94 @@
+#include "runtime/core/base/frame_allocator.h"
+
+#include <algorithm>
+#include <new>
+
+namespace Pilot
+{
+    static constexpr size_t k_frame_block_alignment = 64;
+
+    FrameAllocator::FrameAllocator(size_t block_size) : m_block_size(block_size)
+    {
+        m_block = allocateBlock(m_block_size);
+    }
+
+    FrameAllocator::~FrameAllocator()
+    {
+        for (Block& overflow_block : m_overflow_blocks)
+        {
+            freeBlock(overflow_block);
+        }
+        freeBlock(m_block);
+    }
+
+    void* FrameAllocator::allocate(size_t size, size_t alignment)
+    {
+        Block& current_block = m_overflow_blocks.empty() ? m_block : m_overflow_blocks.back();
+
+        const uintptr_t current_address = reinterpret_cast<uintptr_t>(current_block.m_data) + m_offset;
+        const uintptr_t aligned_address = (current_address + alignment - 1) & ~(uintptr_t(alignment) - 1);
+        const size_t    aligned_offset  = aligned_address - reinterpret_cast<uintptr_t>(current_block.m_data);
+
+        if (aligned_offset + size <= current_block.m_size)
+        {
+            m_offset = aligned_offset + size;
+            return current_block.m_data + aligned_offset;
+        }
+
+        // does not fit, fall back to the heap for the rest of the frame
+        m_used_size += current_block.m_size;
+        m_overflow_blocks.push_back(allocateBlock(std::max(m_block_size, size + alignment)));
+        m_offset = 0;
+        return allocate(size, alignment);
+    }
+
+    void FrameAllocator::reset()
+    {
+        if (!m_overflow_blocks.empty())
+        {
+            // the frame did not fit, make the main block big enough for it
+            size_t new_block_size = m_block.m_size;
+            for (Block& overflow_block : m_overflow_blocks)
+            {
+                new_block_size += overflow_block.m_size;
+                freeBlock(overflow_block);
+            }
+            m_overflow_blocks.clear();
+
+            freeBlock(m_block);
+            m_block = allocateBlock(new_block_size);
+        }
+
+        m_offset    = 0;
+        m_used_size = 0;
+    }
+
+    size_t FrameAllocator::getCapacity() const
+    {
+        size_t capacity = m_block.m_size;
+        for (const Block& overflow_block : m_overflow_blocks)
+        {
+            capacity += overflow_block.m_size;
+        }
+        return capacity;
+    }
+
+    FrameAllocator& FrameAllocator::getThreadInstance()
+    {
+        static thread_local FrameAllocator s_thread_instance;
+        return s_thread_instance;
+    }
+
+    void FrameAllocator::resetThreadInstance() { getThreadInstance().reset(); }
+
+    FrameAllocator::Block FrameAllocator::allocateBlock(size_t size)
+    {
+        return {static_cast<std::byte*>(::operator new(size, std::align_val_t(k_frame_block_alignment))), size};
+    }
+
+    void FrameAllocator::freeBlock(Block& block)
+    {
+        ::operator delete(block.m_data, std::align_val_t(k_frame_block_alignment));
+        block = {};
+    }
+} // namespace Pilot
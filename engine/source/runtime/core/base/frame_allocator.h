@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Pilot
+{
+    /// Linear (bump) allocator for data that only lives during one frame.
+    /// Every thread owns one instance, see getThreadInstance(). Memory is never freed one by one, the owner thread
+    /// resets the whole arena at the end of its frame. When a frame does not fit, the arena grows on reset so that the
+    /// following frames do not allocate from the heap at all.
+    class FrameAllocator
+    {
+    public:
+        static constexpr size_t k_default_block_size = 1024 * 1024;
+
+        explicit FrameAllocator(size_t block_size = k_default_block_size);
+        ~FrameAllocator();
+
+        FrameAllocator(const FrameAllocator&) = delete;
+        FrameAllocator& operator=(const FrameAllocator&) = delete;
+
+        void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+        // invalidate everything allocated so far
+        void reset();
+
+        // bytes taken this frame, the overflow blocks included, a block left for the next one counts as full
+        size_t getUsedSize() const { return m_used_size + m_offset; }
+        // main block and overflow blocks
+        size_t getCapacity() const;
+
+        // the arena of the calling thread
+        static FrameAllocator& getThreadInstance();
+        // end of frame for the calling thread, nothing allocated from its arena may be used afterwards
+        static void resetThreadInstance();
+
+    private:
+        struct Block
+        {
+            std::byte* m_data {nullptr};
+            size_t     m_size {0};
+        };
+
+        static Block allocateBlock(size_t size);
+        static void  freeBlock(Block& block);
+
+        size_t m_block_size {0};
+        Block  m_block;
+        // blocks taken from the heap when the main block is full, merged into the main block on reset
+        std::vector<Block> m_overflow_blocks;
+
+        // offset in the last overflow block, or in the main block when there is none
+        size_t m_offset {0};
+        // size of the blocks filled before the current one
+        size_t m_used_size {0};
+    };
+
+    /// STL allocator on top of a FrameAllocator, the container must not outlive the frame
+    template<typename T>
+    class FrameStlAllocator
+    {
+        template<typename U>
+        friend class FrameStlAllocator;
+
+    public:
+        using value_type = T;
+
+        FrameStlAllocator() noexcept : m_arena(&FrameAllocator::getThreadInstance()) {}
+        explicit FrameStlAllocator(FrameAllocator& arena) noexcept : m_arena(&arena) {}
+        template<typename U>
+        FrameStlAllocator(const FrameStlAllocator<U>& other) noexcept : m_arena(other.m_arena)
+        {}
+
+        T* allocate(size_t count) { return static_cast<T*>(m_arena->allocate(count * sizeof(T), alignof(T))); }
+        void deallocate(T*, size_t) noexcept {}
+
+        template<typename U>
+        bool operator==(const FrameStlAllocator<U>& rhs) const noexcept
+        {
+            return m_arena == rhs.m_arena;
+        }
+        template<typename U>
+        bool operator!=(const FrameStlAllocator<U>& rhs) const noexcept
+        {
+            return m_arena != rhs.m_arena;
+        }
+
+    private:
+        FrameAllocator* m_arena;
+    };
+
+    template<typename T>
+    using FrameVector = std::vector<T, FrameStlAllocator<T>>;
+} // namespace Pilot
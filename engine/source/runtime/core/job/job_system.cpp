@@ -0,0 +1,244 @@
+#include "runtime/core/job/job_system.h"
+
+#include "runtime/core/base/frame_allocator.h"
+#include "runtime/core/profile/profiler.h"
+
+#include <string>
+
+namespace Pilot
+{
+    static thread_local uint32_t s_current_worker_index = JobSystem::k_invalid_worker_index;
+
+    JobSystem::~JobSystem() { clear(); }
+
+    void JobSystem::initialize(uint32_t worker_count)
+    {
+        clear();
+
+        if (worker_count == 0)
+        {
+            const uint32_t hardware_thread_count = std::thread::hardware_concurrency();
+            worker_count = hardware_thread_count > 1 ? hardware_thread_count - 1 : 1;
+        }
+        m_worker_count = worker_count;
+
+        m_queues.clear();
+        for (uint32_t queue_index = 0; queue_index <= m_worker_count; ++queue_index)
+        {
+            m_queues.push_back(std::make_unique<JobQueue>());
+        }
+
+        m_is_quit = false;
+        for (uint32_t worker_index = 0; worker_index < m_worker_count; ++worker_index)
+        {
+            m_workers.emplace_back(&JobSystem::workerMain, this, worker_index);
+        }
+    }
+
+    void JobSystem::clear()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_sleep_mutex);
+            m_is_quit = true;
+        }
+        m_sleep_condition.notify_all();
+
+        for (std::thread& worker : m_workers)
+        {
+            worker.join();
+        }
+        m_workers.clear();
+
+        // run whatever is left so that nobody waits on a counter forever
+        Job job;
+        while (popJob(job))
+        {
+            executeJob(job);
+        }
+
+        m_queues.clear();
+        m_worker_count = 0;
+    }
+
+    uint32_t JobSystem::getCurrentWorkerIndex() { return s_current_worker_index; }
+
+    void JobSystem::run(JobFunction job, JobCounter* counter)
+    {
+        if (counter)
+        {
+            counter->m_value.fetch_add(1, std::memory_order_acq_rel);
+        }
+        schedule(Job {std::move(job), counter});
+    }
+
+    void JobSystem::runAfter(JobCounter& dependency, JobFunction job, JobCounter* counter)
+    {
+        if (counter)
+        {
+            counter->m_value.fetch_add(1, std::memory_order_acq_rel);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(dependency.m_dependent_mutex);
+            if (!dependency.isDone())
+            {
+                dependency.m_dependent_jobs.push_back({std::move(job), counter});
+                return;
+            }
+        }
+
+        schedule(Job {std::move(job), counter});
+    }
+
+    void JobSystem::wait(JobCounter& counter)
+    {
+        while (!counter.isDone())
+        {
+            if (!tryRunOneJob())
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        // the finishing thread may still hold the lock
+        std::lock_guard<std::mutex> lock(counter.m_dependent_mutex);
+    }
+
+    bool JobSystem::tryRunOneJob()
+    {
+        Job job;
+        if (!popJob(job))
+        {
+            return false;
+        }
+
+        executeJob(job);
+        return true;
+    }
+
+    void JobSystem::schedule(Job&& job)
+    {
+        if (m_queues.empty())
+        {
+            // not initialized, run inline
+            executeJob(job);
+            return;
+        }
+
+        JobQueue& queue = *m_queues[getOwnQueueIndex()];
+        {
+            std::lock_guard<std::mutex> lock(queue.m_mutex);
+            queue.m_jobs.push_back(std::move(job));
+        }
+        m_queued_job_count.fetch_add(1, std::memory_order_release);
+
+        // make sure a worker that is about to sleep sees the new job
+        {
+            std::lock_guard<std::mutex> lock(m_sleep_mutex);
+        }
+        m_sleep_condition.notify_one();
+    }
+
+    bool JobSystem::popJob(Job& out_job)
+    {
+        if (m_queues.empty() || m_queued_job_count.load(std::memory_order_acquire) <= 0)
+        {
+            return false;
+        }
+
+        const uint32_t own_queue_index = getOwnQueueIndex();
+        const uint32_t queue_count     = static_cast<uint32_t>(m_queues.size());
+
+        // newest job of the own queue first, it is most likely still in cache
+        {
+            JobQueue&                   queue = *m_queues[own_queue_index];
+            std::lock_guard<std::mutex> lock(queue.m_mutex);
+            if (!queue.m_jobs.empty())
+            {
+                out_job = std::move(queue.m_jobs.back());
+                queue.m_jobs.pop_back();
+                m_queued_job_count.fetch_sub(1, std::memory_order_acq_rel);
+                return true;
+            }
+        }
+
+        // then steal the oldest job of the others
+        for (uint32_t offset = 1; offset < queue_count; ++offset)
+        {
+            JobQueue&                   queue = *m_queues[(own_queue_index + offset) % queue_count];
+            std::lock_guard<std::mutex> lock(queue.m_mutex);
+            if (!queue.m_jobs.empty())
+            {
+                out_job = std::move(queue.m_jobs.front());
+                queue.m_jobs.pop_front();
+                m_queued_job_count.fetch_sub(1, std::memory_order_acq_rel);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void JobSystem::executeJob(Job& job)
+    {
+        if (job.m_function)
+        {
+            job.m_function();
+        }
+        finishJob(job.m_counter);
+    }
+
+    void JobSystem::finishJob(JobCounter* counter)
+    {
+        if (counter == nullptr)
+        {
+            return;
+        }
+
+        // the counter reached zero, release the jobs that depend on it. the counter is not touched after unlocking,
+        // wait() takes the same lock, so the counter can be destroyed as soon as wait() returns
+        std::vector<JobCounter::DependentJob> dependent_jobs;
+        {
+            std::lock_guard<std::mutex> lock(counter->m_dependent_mutex);
+            if (counter->m_value.fetch_sub(1, std::memory_order_acq_rel) != 1)
+            {
+                return;
+            }
+            dependent_jobs.swap(counter->m_dependent_jobs);
+        }
+
+        for (JobCounter::DependentJob& dependent_job : dependent_jobs)
+        {
+            schedule(Job {std::move(dependent_job.m_function), dependent_job.m_counter});
+        }
+    }
+
+    void JobSystem::workerMain(uint32_t worker_index)
+    {
+        s_current_worker_index = worker_index;
+        PROFILE_THREAD("job worker " + std::to_string(worker_index));
+
+        while (!m_is_quit.load(std::memory_order_acquire))
+        {
+            if (tryRunOneJob())
+            {
+                // frame allocations of a job must not outlive it, so the worker arena is reset between jobs
+                FrameAllocator::resetThreadInstance();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(m_sleep_mutex);
+            m_sleep_condition.wait(lock, [this] {
+                return m_is_quit.load(std::memory_order_acquire) ||
+                       m_queued_job_count.load(std::memory_order_acquire) > 0;
+            });
+        }
+
+        s_current_worker_index = k_invalid_worker_index;
+    }
+
+    uint32_t JobSystem::getOwnQueueIndex() const
+    {
+        return s_current_worker_index < m_worker_count ? s_current_worker_index : m_worker_count;
+    }
+} // namespace Pilot
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Pilot
+{
+    using JobFunction = std::function<void()>;
+
+    /// Counts the unfinished jobs of a group. Threads can wait on it, and jobs can be scheduled to start once it
+    /// reaches zero. A counter must outlive every job that references it, destroy it only after JobSystem::wait().
+    class JobCounter
+    {
+        friend class JobSystem;
+
+    public:
+        JobCounter() = default;
+        JobCounter(const JobCounter&) = delete;
+        JobCounter& operator=(const JobCounter&) = delete;
+
+        bool isDone() const { return m_value.load(std::memory_order_acquire) == 0; }
+        int  getValue() const { return m_value.load(std::memory_order_acquire); }
+
+    private:
+        struct DependentJob
+        {
+            JobFunction m_function;
+            JobCounter* m_counter {nullptr};
+        };
+
+        std::atomic<int>          m_value {0};
+        std::mutex                m_dependent_mutex;
+        std::vector<DependentJob> m_dependent_jobs;
+    };
+
+    /// Engine-wide work-stealing job system.
+    /// Every worker owns a deque, it pushes and pops its own jobs at the back and steals from the front of the
+    /// others. Jobs submitted from non-worker threads go to a shared queue. A thread waiting on a counter keeps
+    /// executing jobs, so waiting inside a job does not deadlock.
+    class JobSystem
+    {
+        struct Job
+        {
+            JobFunction m_function;
+            JobCounter* m_counter {nullptr};
+        };
+
+        struct alignas(64) JobQueue
+        {
+            std::mutex      m_mutex;
+            std::deque<Job> m_jobs;
+        };
+
+    public:
+        static constexpr uint32_t k_invalid_worker_index = std::numeric_limits<uint32_t>::max();
+
+        ~JobSystem();
+
+        // worker_count 0 means one worker per hardware thread, except the thread that initializes the system
+        void initialize(uint32_t worker_count = 0);
+        void clear();
+
+        uint32_t getWorkerCount() const { return m_worker_count; }
+        // the workers plus the waiting thread
+        uint32_t getMaxConcurrency() const { return m_worker_count + 1; }
+
+        // index of the calling worker thread, k_invalid_worker_index for any other thread
+        static uint32_t getCurrentWorkerIndex();
+
+        void run(JobFunction job, JobCounter* counter = nullptr);
+        // schedule the job once the dependency counter reaches zero
+        void runAfter(JobCounter& dependency, JobFunction job, JobCounter* counter = nullptr);
+
+        // execute jobs on the calling thread until the counter reaches zero
+        void wait(JobCounter& counter);
+        // execute one pending job on the calling thread, return false if there was nothing to do
+        bool tryRunOneJob();
+
+        /// call func(batch_begin, batch_end) for every batch of [begin, end) and wait for all of them,
+        /// the last batch runs on the calling thread
+        template<typename TFunc>
+        void parallelForRange(size_t begin, size_t end, size_t batch_size, TFunc&& func)
+        {
+            if (begin >= end)
+            {
+                return;
+            }
+            batch_size = std::max<size_t>(batch_size, 1);
+
+            JobCounter counter;
+            for (size_t batch_begin = begin; batch_begin < end; batch_begin += batch_size)
+            {
+                const size_t batch_end = std::min(batch_begin + batch_size, end);
+                if (batch_end == end)
+                {
+                    func(batch_begin, batch_end);
+                    break;
+                }
+                run([&func, batch_begin, batch_end]() { func(batch_begin, batch_end); }, &counter);
+            }
+            wait(counter);
+        }
+
+        /// call func(index) for every index of [begin, end) and wait for all of them
+        template<typename TFunc>
+        void parallelFor(size_t begin, size_t end, size_t batch_size, TFunc&& func)
+        {
+            parallelForRange(begin, end, batch_size, [&func](size_t batch_begin, size_t batch_end) {
+                for (size_t index = batch_begin; index < batch_end; ++index)
+                {
+                    func(index);
+                }
+            });
+        }
+
+    private:
+        void schedule(Job&& job);
+        bool popJob(Job& out_job);
+        void executeJob(Job& job);
+        void finishJob(JobCounter* counter);
+        void workerMain(uint32_t worker_index);
+
+        uint32_t getOwnQueueIndex() const;
+
+        uint32_t m_worker_count {0};
+
+        // one queue per worker, the last one is shared by the non-worker threads
+        std::vector<std::unique_ptr<JobQueue>> m_queues;
+        std::vector<std::thread>               m_workers;
+
+        std::atomic<int>        m_queued_job_count {0};
+        std::atomic<bool>       m_is_quit {false};
+        std::mutex              m_sleep_mutex;
+        std::condition_variable m_sleep_condition;
+    };
+} // namespace Pilot
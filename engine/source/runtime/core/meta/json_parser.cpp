@@ -0,0 +1,33 @@
+#include "runtime/core/meta/json_parser.h"
+
+#include "runtime/core/meta/json_reader.h"
+
+#include <atomic>
+
+namespace Pilot
+{
+    static std::atomic<PJsonBackend> s_json_backend {PJsonBackend::reader};
+
+    PJson PJsonParser::parse(const char* data, size_t size, std::string& out_error)
+    {
+        if (s_json_backend.load(std::memory_order_relaxed) == PJsonBackend::json11)
+        {
+            return PJson::parse(std::string(data, size), out_error);
+        }
+
+        PJsonReader reader(data, size);
+        PJson       json = reader.readValue();
+        if (!reader.isValid() || !reader.isAtEnd())
+        {
+            out_error = "invalid json";
+            return PJson();
+        }
+
+        out_error.clear();
+        return json;
+    }
+
+    void PJsonParser::setBackend(PJsonBackend backend) { s_json_backend.store(backend, std::memory_order_relaxed); }
+
+    PJsonBackend PJsonParser::getBackend() { return s_json_backend.load(std::memory_order_relaxed); }
+} // namespace Pilot
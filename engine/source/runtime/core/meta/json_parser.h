@@ -0,0 +1,30 @@
+#pragma once
+#include "runtime/core/meta/json.h"
+
+#include <cstddef>
+#include <string>
+
+namespace Pilot
+{
+    enum class PJsonBackend : unsigned char
+    {
+        json11, // PJson::parse
+        reader, // PJsonReader over the vectorized scanner, the default
+    };
+
+    /// Parses json text to a PJson with the selected backend. The backends build the same tree from a valid
+    /// document, so PSerializer does not depend on the backend.
+    class PJsonParser
+    {
+    public:
+        // out_error is empty on success, like PJson::parse
+        static PJson parse(const char* data, size_t size, std::string& out_error);
+        static PJson parse(const std::string& text, std::string& out_error)
+        {
+            return parse(text.data(), text.size(), out_error);
+        }
+
+        static void         setBackend(PJsonBackend backend);
+        static PJsonBackend getBackend();
+    };
+} // namespace Pilot
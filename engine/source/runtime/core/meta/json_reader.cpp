@@ -0,0 +1,647 @@
+#include "runtime/core/meta/json_reader.h"
+
+#include "runtime/core/meta/json_scanner.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+
+namespace Pilot
+{
+    namespace
+    {
+        bool isNumberChar(char c)
+        {
+            return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+        }
+
+        int parseHexDigit(char c)
+        {
+            if (c >= '0' && c <= '9')
+            {
+                return c - '0';
+            }
+            if (c >= 'a' && c <= 'f')
+            {
+                return c - 'a' + 10;
+            }
+            if (c >= 'A' && c <= 'F')
+            {
+                return c - 'A' + 10;
+            }
+            return -1;
+        }
+
+        bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+        // the json grammar of a number, stricter than strtod: no leading 0, no empty fraction or exponent
+        bool isJsonNumber(const char* cursor, const char* end)
+        {
+            if (cursor != end && *cursor == '-')
+            {
+                ++cursor;
+            }
+            if (cursor == end || !isDigit(*cursor))
+            {
+                return false;
+            }
+            if (*cursor++ == '0' && cursor != end && isDigit(*cursor))
+            {
+                return false;
+            }
+            while (cursor != end && isDigit(*cursor))
+            {
+                ++cursor;
+            }
+
+            if (cursor != end && *cursor == '.')
+            {
+                if (++cursor == end || !isDigit(*cursor))
+                {
+                    return false;
+                }
+                while (cursor != end && isDigit(*cursor))
+                {
+                    ++cursor;
+                }
+            }
+
+            if (cursor != end && (*cursor == 'e' || *cursor == 'E'))
+            {
+                ++cursor;
+                if (cursor != end && (*cursor == '-' || *cursor == '+'))
+                {
+                    ++cursor;
+                }
+                if (cursor == end || !isDigit(*cursor))
+                {
+                    return false;
+                }
+                while (cursor != end && isDigit(*cursor))
+                {
+                    ++cursor;
+                }
+            }
+            return cursor == end;
+        }
+
+        // the usual short decimals without strtod: with at most 15 digits the mantissa and the power of ten are
+        // exact doubles, so the single multiply or divide rounds like strtod. The text is a valid json number
+        bool parseShortDecimal(const char* cursor, const char* end, double& out_value)
+        {
+            static constexpr double k_powers_of_ten[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                                         1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                                         1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+            constexpr int k_max_digit_count = 15;
+            constexpr int k_max_exponent    = 22;
+
+            const bool is_negative = *cursor == '-';
+            if (is_negative)
+            {
+                ++cursor;
+            }
+
+            uint64_t mantissa    = 0;
+            int      digit_count = 0;
+            int      exponent    = 0;
+            bool     is_fraction = false;
+            for (; cursor != end && (isDigit(*cursor) || *cursor == '.'); ++cursor)
+            {
+                if (*cursor == '.')
+                {
+                    is_fraction = true;
+                    continue;
+                }
+                mantissa = mantissa * 10 + static_cast<uint64_t>(*cursor - '0');
+                ++digit_count;
+                exponent -= is_fraction ? 1 : 0;
+            }
+
+            if (cursor != end)
+            {
+                // past 'e' or 'E'
+                ++cursor;
+                const bool is_exponent_negative = *cursor == '-';
+                if (*cursor == '-' || *cursor == '+')
+                {
+                    ++cursor;
+                }
+
+                int written_exponent = 0;
+                for (; cursor != end; ++cursor)
+                {
+                    // large enough to fail the range check below, small enough not to overflow
+                    written_exponent = std::min(written_exponent * 10 + (*cursor - '0'), 10000);
+                }
+                exponent += is_exponent_negative ? -written_exponent : written_exponent;
+            }
+
+            if (digit_count > k_max_digit_count || exponent < -k_max_exponent || exponent > k_max_exponent)
+            {
+                return false;
+            }
+
+            double value = static_cast<double>(mantissa);
+            value        = exponent < 0 ? value / k_powers_of_ten[-exponent] : value * k_powers_of_ten[exponent];
+            out_value    = is_negative ? -value : value;
+            return true;
+        }
+
+        void appendUtf8(uint32_t code_point, std::string& out_text)
+        {
+            if (code_point < 0x80)
+            {
+                out_text += static_cast<char>(code_point);
+            }
+            else if (code_point < 0x800)
+            {
+                out_text += static_cast<char>(0xC0 | (code_point >> 6));
+                out_text += static_cast<char>(0x80 | (code_point & 0x3F));
+            }
+            else if (code_point < 0x10000)
+            {
+                out_text += static_cast<char>(0xE0 | (code_point >> 12));
+                out_text += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+                out_text += static_cast<char>(0x80 | (code_point & 0x3F));
+            }
+            else
+            {
+                out_text += static_cast<char>(0xF0 | (code_point >> 18));
+                out_text += static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+                out_text += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+                out_text += static_cast<char>(0x80 | (code_point & 0x3F));
+            }
+        }
+    } // namespace
+
+    bool PJsonReader::isAtEnd() { return peekChar() == 0 && m_cursor == m_end; }
+
+    PJson::Type PJsonReader::peekType()
+    {
+        const char c = peekChar();
+        switch (c)
+        {
+            case 'n':
+                return PJson::NUL;
+            case 't':
+            case 'f':
+                return PJson::BOOL;
+            case '"':
+                return PJson::STRING;
+            case '[':
+                return PJson::ARRAY;
+            case '{':
+                return PJson::OBJECT;
+            default:
+                if (c == '-' || (c >= '0' && c <= '9'))
+                {
+                    return PJson::NUMBER;
+                }
+                fail();
+                return PJson::NUL;
+        }
+    }
+
+    bool PJsonReader::skipNull()
+    {
+        if (peekChar() != 'n')
+        {
+            return false;
+        }
+        skipLiteral("null");
+        return m_is_valid;
+    }
+
+    void PJsonReader::beginObject() { beginContainer('{'); }
+
+    bool PJsonReader::nextMember(std::string_view& out_key)
+    {
+        if (!nextInContainer('}'))
+        {
+            return false;
+        }
+
+        if (peekChar() != '"')
+        {
+            fail();
+            return false;
+        }
+        ++m_cursor;
+        out_key = readStringContent(m_key_buffer);
+
+        if (peekChar() != ':')
+        {
+            fail();
+            return false;
+        }
+        ++m_cursor;
+        return true;
+    }
+
+    void PJsonReader::beginArray() { beginContainer('['); }
+
+    bool PJsonReader::nextElement() { return nextInContainer(']'); }
+
+    double PJsonReader::readNumber()
+    {
+        bool is_integer;
+        return readNumber(is_integer);
+    }
+
+    double PJsonReader::readNumber(bool& out_is_integer)
+    {
+        out_is_integer = false;
+        if (peekType() != PJson::NUMBER)
+        {
+            skipValue();
+            return 0.0;
+        }
+
+        const char* number_begin = m_cursor;
+        bool        is_plain     = true;
+        while (m_cursor != m_end && isNumberChar(*m_cursor))
+        {
+            // the sign can only be the first char
+            is_plain = is_plain && (isDigit(*m_cursor) || m_cursor == number_begin);
+            ++m_cursor;
+        }
+        const size_t number_length = static_cast<size_t>(m_cursor - number_begin);
+        if (!isJsonNumber(number_begin, m_cursor))
+        {
+            fail();
+            return 0.0;
+        }
+
+        // like json11, a short number without fraction or exponent is an int
+        out_is_integer = is_plain && number_length <= static_cast<size_t>(std::numeric_limits<int>::digits10);
+
+        double value;
+        if (parseShortDecimal(number_begin, m_cursor, value))
+        {
+            return value;
+        }
+        out_is_integer = false;
+
+        // strtod needs a terminated string, the text may end right after the number
+        char        short_number_text[64];
+        std::string long_number_text;
+        char*       number_text = short_number_text;
+        if (number_length >= sizeof(short_number_text))
+        {
+            // json11 takes numbers of any length
+            long_number_text.assign(number_begin, number_length);
+            number_text = long_number_text.data();
+        }
+        else
+        {
+            std::memcpy(short_number_text, number_begin, number_length);
+            short_number_text[number_length] = '\0';
+        }
+
+        char* number_end = nullptr;
+        value            = std::strtod(number_text, &number_end);
+        if (number_end != number_text + number_length)
+        {
+            fail();
+            return 0.0;
+        }
+        return value;
+    }
+
+    bool PJsonReader::readBool()
+    {
+        const char c = peekChar();
+        if (c == 't')
+        {
+            skipLiteral("true");
+            return m_is_valid;
+        }
+        if (c == 'f')
+        {
+            skipLiteral("false");
+            return false;
+        }
+        skipValue();
+        return false;
+    }
+
+    void PJsonReader::readString(std::string& out_text)
+    {
+        if (peekChar() != '"')
+        {
+            skipValue();
+            out_text.clear();
+            return;
+        }
+        ++m_cursor;
+
+        const std::string_view text = readStringContent(out_text);
+        if (text.data() != out_text.data())
+        {
+            out_text.assign(text.data(), text.size());
+        }
+    }
+
+    void PJsonReader::skipValue()
+    {
+        std::string_view key;
+        switch (peekChar())
+        {
+            case '{':
+                beginObject();
+                while (nextMember(key))
+                {
+                    skipValue();
+                }
+                break;
+            case '[':
+                beginArray();
+                while (nextElement())
+                {
+                    skipValue();
+                }
+                break;
+            case '"':
+                ++m_cursor;
+                readStringContent(m_key_buffer);
+                break;
+            case 'n':
+                skipLiteral("null");
+                break;
+            case 't':
+                skipLiteral("true");
+                break;
+            case 'f':
+                skipLiteral("false");
+                break;
+            default:
+                // an invalid value fails in peekType
+                if (peekType() == PJson::NUMBER)
+                {
+                    readNumber();
+                }
+                break;
+        }
+    }
+
+    PJson PJsonReader::readValue()
+    {
+        switch (peekType())
+        {
+            case PJson::BOOL:
+                return PJson(readBool());
+            case PJson::NUMBER:
+            {
+                bool         is_integer;
+                const double value = readNumber(is_integer);
+                return is_integer ? PJson(static_cast<int>(value)) : PJson(value);
+            }
+            case PJson::STRING:
+            {
+                std::string text;
+                readString(text);
+                return PJson(std::move(text));
+            }
+            case PJson::ARRAY:
+            case PJson::OBJECT:
+                return readContainer();
+            default:
+                skipNull();
+                return PJson();
+        }
+    }
+
+    PJson PJsonReader::readContainer()
+    {
+        // a small container without nested ones is looked up by its text, repeated ones share one tree
+        const char  open_char  = *m_cursor;
+        const char  close_char = open_char == '{' ? '}' : ']';
+        const char* text_begin = m_cursor;
+        const char* text_end   = static_cast<size_t>(m_end - m_cursor) > k_max_shared_text_length ?
+                                     m_cursor + k_max_shared_text_length :
+                                     m_end;
+        const char* close      = PJsonScanner::findFlatContainerEnd(m_cursor + 1, text_end, close_char);
+
+        std::string_view text;
+        if (close != nullptr)
+        {
+            text      = std::string_view(text_begin, static_cast<size_t>(close + 1 - text_begin));
+            auto iter = m_shared_values.find(text);
+            if (iter != m_shared_values.end())
+            {
+                m_cursor = close + 1;
+                return iter->second;
+            }
+        }
+
+        PJson value;
+        if (open_char == '[')
+        {
+            PJson::array elements;
+            beginArray();
+            while (nextElement())
+            {
+                elements.push_back(readValue());
+            }
+            value = PJson(std::move(elements));
+        }
+        else
+        {
+            PJson::object    members;
+            std::string_view key;
+            beginObject();
+            while (nextMember(key))
+            {
+                // the key buffer is reused by the nested reads
+                std::string member_key(key);
+                PJson       member_value = readValue();
+                // the last of duplicated keys wins, like json11
+                members.insert_or_assign(members.end(), std::move(member_key), std::move(member_value));
+            }
+            value = PJson(std::move(members));
+        }
+
+        if (close != nullptr && m_is_valid)
+        {
+            m_shared_values.emplace(text, value);
+        }
+        return value;
+    }
+
+    char PJsonReader::peekChar()
+    {
+        m_cursor = PJsonScanner::skipWhitespace(m_cursor, m_end);
+        return m_cursor != m_end ? *m_cursor : '\0';
+    }
+
+    void PJsonReader::fail()
+    {
+        m_is_valid = false;
+        m_cursor   = m_end;
+        m_first_flags.clear();
+    }
+
+    void PJsonReader::beginContainer(char open_char)
+    {
+        if (peekChar() != open_char || m_first_flags.size() >= k_max_depth)
+        {
+            fail();
+            return;
+        }
+        ++m_cursor;
+        m_first_flags.push_back(true);
+    }
+
+    bool PJsonReader::nextInContainer(char close_char)
+    {
+        if (!m_is_valid || m_first_flags.empty())
+        {
+            return false;
+        }
+
+        const char c = peekChar();
+        if (c == close_char)
+        {
+            ++m_cursor;
+            m_first_flags.pop_back();
+            return false;
+        }
+
+        if (m_first_flags.back())
+        {
+            m_first_flags.back() = false;
+        }
+        else if (c == ',')
+        {
+            ++m_cursor;
+        }
+        else
+        {
+            fail();
+            return false;
+        }
+        return true;
+    }
+
+    std::string_view PJsonReader::readStringContent(std::string& buffer)
+    {
+        const char* text_begin = m_cursor;
+        m_cursor               = PJsonScanner::findStringSpecial(m_cursor, m_end);
+
+        if (m_cursor == m_end || static_cast<unsigned char>(*m_cursor) < 0x20)
+        {
+            fail();
+            return std::string_view();
+        }
+        if (*m_cursor == '"')
+        {
+            // no escape, no copy
+            const std::string_view text(text_begin, static_cast<size_t>(m_cursor - text_begin));
+            ++m_cursor;
+            return text;
+        }
+
+        buffer.assign(text_begin, m_cursor);
+        while (m_cursor != m_end)
+        {
+            const char c = *m_cursor++;
+            if (c == '"')
+            {
+                return buffer;
+            }
+            if (static_cast<unsigned char>(c) < 0x20)
+            {
+                break;
+            }
+            if (c != '\\')
+            {
+                // copy up to the next quote, backslash or control char
+                const char* run_begin = m_cursor - 1;
+                m_cursor              = PJsonScanner::findStringSpecial(m_cursor, m_end);
+                buffer.append(run_begin, m_cursor);
+                continue;
+            }
+
+            if (m_cursor == m_end)
+            {
+                break;
+            }
+            const char escape = *m_cursor++;
+            switch (escape)
+            {
+                case '"':
+                case '\\':
+                case '/':
+                    buffer += escape;
+                    break;
+                case 'b':
+                    buffer += '\b';
+                    break;
+                case 'f':
+                    buffer += '\f';
+                    break;
+                case 'n':
+                    buffer += '\n';
+                    break;
+                case 'r':
+                    buffer += '\r';
+                    break;
+                case 't':
+                    buffer += '\t';
+                    break;
+                case 'u':
+                {
+                    uint32_t code_point = 0;
+                    for (int digit_index = 0; digit_index < 4; ++digit_index)
+                    {
+                        const int digit = m_cursor != m_end ? parseHexDigit(*m_cursor++) : -1;
+                        if (digit < 0)
+                        {
+                            fail();
+                            return std::string_view();
+                        }
+                        code_point = (code_point << 4) | static_cast<uint32_t>(digit);
+                    }
+
+                    // a surrogate pair is one code point
+                    if (code_point >= 0xD800 && code_point <= 0xDBFF && m_end - m_cursor >= 6 && m_cursor[0] == '\\' &&
+                        m_cursor[1] == 'u')
+                    {
+                        uint32_t low_surrogate = 0;
+                        for (int digit_index = 2; digit_index < 6 && low_surrogate != UINT32_MAX; ++digit_index)
+                        {
+                            const int digit = parseHexDigit(m_cursor[digit_index]);
+                            low_surrogate = digit < 0 ? UINT32_MAX : (low_surrogate << 4) | static_cast<uint32_t>(digit);
+                        }
+                        if (low_surrogate >= 0xDC00 && low_surrogate <= 0xDFFF)
+                        {
+                            code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low_surrogate - 0xDC00);
+                            m_cursor += 6;
+                        }
+                    }
+                    appendUtf8(code_point, buffer);
+                    break;
+                }
+                default:
+                    fail();
+                    return std::string_view();
+            }
+        }
+
+        fail();
+        return std::string_view();
+    }
+
+    void PJsonReader::skipLiteral(const char* literal)
+    {
+        const size_t literal_length = std::strlen(literal);
+        if (static_cast<size_t>(m_end - m_cursor) < literal_length || std::memcmp(m_cursor, literal, literal_length) != 0)
+        {
+            fail();
+            return;
+        }
+        m_cursor += literal_length;
+    }
+} // namespace Pilot
@@ -0,0 +1,80 @@
+#pragma once
+#include "runtime/core/meta/json.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Pilot
+{
+    /// Streaming reader of a json text, the values are read in document order straight into the caller without
+    /// building a PJson tree. The text is not copied, so it can be a mapped file.
+    /// Any syntax error makes the reader invalid: it then stands at the end, every read gives an empty value and
+    /// the member and element loops stop.
+    class PJsonReader
+    {
+    public:
+        PJsonReader(const char* data, size_t size) : m_cursor(data), m_end(data + size) {}
+
+        bool isValid() const { return m_is_valid; }
+        // only whitespace left
+        bool isAtEnd();
+
+        // type of the next value, NUL if the reader is invalid
+        PJson::Type peekType();
+        // consume the next value if it is null
+        bool skipNull();
+
+        // while (reader.nextMember(key)) { read or skip the value }
+        void beginObject();
+        // key stays valid until the next call
+        bool nextMember(std::string_view& out_key);
+
+        // while (reader.nextElement()) { read or skip the value }
+        void beginArray();
+        bool nextElement();
+
+        // a value of another type is skipped and read as the PJson accessors would, as 0, false or empty
+        double readNumber();
+        bool   readBool();
+        void   readString(std::string& out_text);
+
+        void skipValue();
+        // build the PJson tree of the next value, for the parts read by the generated serializers.
+        // PJson values are immutable, so equal small containers of one text share a single tree
+        PJson readValue();
+
+    private:
+        static constexpr size_t k_max_depth = 200;
+        // longest text of a container shared by readValue
+        static constexpr size_t k_max_shared_text_length = 256;
+
+        // skip whitespace, 0 at the end
+        char peekChar();
+        void fail();
+
+        // out_is_integer tells if json11 would have made the number an int
+        double readNumber(bool& out_is_integer);
+
+        PJson readContainer();
+
+        void beginContainer(char open_char);
+        bool nextInContainer(char close_char);
+
+        // the cursor is past the opening quote, the view points into the text when there is no escape
+        std::string_view readStringContent(std::string& buffer);
+        void             skipLiteral(const char* literal);
+
+        const char* m_cursor;
+        const char* m_end;
+        bool        m_is_valid {true};
+        // per open container, true until its first member or element
+        std::vector<bool> m_first_flags;
+        std::string       m_key_buffer;
+        // trees built by readValue, by their text
+        std::unordered_map<std::string_view, PJson> m_shared_values;
+    };
+} // namespace Pilot
@@ -0,0 +1,215 @@
+#include "runtime/core/meta/json_scanner.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#define PILOT_JSON_SCAN_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PILOT_JSON_SCAN_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace Pilot
+{
+    namespace
+    {
+        bool isStringSpecial(char c) { return c == '"' || c == '\\' || static_cast<unsigned char>(c) < 0x20; }
+
+        bool isStructural(char c) { return c == '"' || c == '{' || c == '}' || c == '[' || c == ']'; }
+
+#if defined(PILOT_JSON_SCAN_AVX2) || defined(PILOT_JSON_SCAN_SSE2)
+        // index of the lowest set bit, mask is not 0
+        uint32_t countTrailingZeros(uint32_t mask)
+        {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward(&index, mask);
+            return static_cast<uint32_t>(index);
+#else
+            return static_cast<uint32_t>(__builtin_ctz(mask));
+#endif
+        }
+#endif
+
+#if defined(PILOT_JSON_SCAN_AVX2)
+        constexpr size_t k_block_size = 32;
+
+        // bit i is set if byte i is not whitespace
+        uint32_t getNonWhitespaceMask(const char* block)
+        {
+            const __m256i bytes      = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+            __m256i       whitespace = _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(' '));
+            whitespace               = _mm256_or_si256(whitespace, _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\n')));
+            whitespace               = _mm256_or_si256(whitespace, _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\r')));
+            whitespace               = _mm256_or_si256(whitespace, _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\t')));
+            return ~static_cast<uint32_t>(_mm256_movemask_epi8(whitespace));
+        }
+
+        // bit i is set if byte i is a quote, a backslash or a control char
+        uint32_t getStringSpecialMask(const char* block)
+        {
+            const __m256i bytes   = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+            const __m256i control = _mm256_set1_epi8(0x1F);
+            // unsigned byte <= 0x1F
+            __m256i       special = _mm256_cmpeq_epi8(_mm256_max_epu8(bytes, control), control);
+            special               = _mm256_or_si256(special, _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('"')));
+            special               = _mm256_or_si256(special, _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\\')));
+            return static_cast<uint32_t>(_mm256_movemask_epi8(special));
+        }
+
+        // bit i is set if byte i is a quote, a brace or a bracket
+        uint32_t getStructuralMask(const char* block)
+        {
+            const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+            // '[' and ']' are '{' and '}' without the 0x20 bit
+            const __m256i folded     = _mm256_or_si256(bytes, _mm256_set1_epi8(0x20));
+            __m256i       structural = _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('"'));
+            structural               = _mm256_or_si256(structural, _mm256_cmpeq_epi8(folded, _mm256_set1_epi8('{')));
+            structural               = _mm256_or_si256(structural, _mm256_cmpeq_epi8(folded, _mm256_set1_epi8('}')));
+            return static_cast<uint32_t>(_mm256_movemask_epi8(structural));
+        }
+#elif defined(PILOT_JSON_SCAN_SSE2)
+        constexpr size_t k_block_size = 16;
+
+        uint32_t getNonWhitespaceMask(const char* block)
+        {
+            const __m128i bytes      = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+            __m128i       whitespace = _mm_cmpeq_epi8(bytes, _mm_set1_epi8(' '));
+            whitespace               = _mm_or_si128(whitespace, _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\n')));
+            whitespace               = _mm_or_si128(whitespace, _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\r')));
+            whitespace               = _mm_or_si128(whitespace, _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\t')));
+            return ~static_cast<uint32_t>(_mm_movemask_epi8(whitespace)) & 0xFFFFu;
+        }
+
+        uint32_t getStringSpecialMask(const char* block)
+        {
+            const __m128i bytes   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+            const __m128i control = _mm_set1_epi8(0x1F);
+            __m128i       special = _mm_cmpeq_epi8(_mm_max_epu8(bytes, control), control);
+            special               = _mm_or_si128(special, _mm_cmpeq_epi8(bytes, _mm_set1_epi8('"')));
+            special               = _mm_or_si128(special, _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\\')));
+            return static_cast<uint32_t>(_mm_movemask_epi8(special));
+        }
+
+        uint32_t getStructuralMask(const char* block)
+        {
+            const __m128i bytes      = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+            const __m128i folded     = _mm_or_si128(bytes, _mm_set1_epi8(0x20));
+            __m128i       structural = _mm_cmpeq_epi8(bytes, _mm_set1_epi8('"'));
+            structural               = _mm_or_si128(structural, _mm_cmpeq_epi8(folded, _mm_set1_epi8('{')));
+            structural               = _mm_or_si128(structural, _mm_cmpeq_epi8(folded, _mm_set1_epi8('}')));
+            return static_cast<uint32_t>(_mm_movemask_epi8(structural));
+        }
+#endif
+    } // namespace
+
+    const char* PJsonScanner::findStringSpecial(const char* cursor, const char* end)
+    {
+#if defined(PILOT_JSON_SCAN_AVX2) || defined(PILOT_JSON_SCAN_SSE2)
+        while (static_cast<size_t>(end - cursor) >= k_block_size)
+        {
+            const uint32_t mask = getStringSpecialMask(cursor);
+            if (mask != 0)
+            {
+                return cursor + countTrailingZeros(mask);
+            }
+            cursor += k_block_size;
+        }
+#endif
+
+        while (cursor != end && !isStringSpecial(*cursor))
+        {
+            ++cursor;
+        }
+        return cursor;
+    }
+
+    const char* PJsonScanner::findStructural(const char* cursor, const char* end)
+    {
+#if defined(PILOT_JSON_SCAN_AVX2) || defined(PILOT_JSON_SCAN_SSE2)
+        while (static_cast<size_t>(end - cursor) >= k_block_size)
+        {
+            const uint32_t mask = getStructuralMask(cursor);
+            if (mask != 0)
+            {
+                return cursor + countTrailingZeros(mask);
+            }
+            cursor += k_block_size;
+        }
+#endif
+
+        while (cursor != end && !isStructural(*cursor))
+        {
+            ++cursor;
+        }
+        return cursor;
+    }
+
+    const char* PJsonScanner::findFlatContainerEnd(const char* cursor, const char* end, char close_char)
+    {
+        while (true)
+        {
+            cursor = findStructural(cursor, end);
+            if (cursor == end)
+            {
+                return nullptr;
+            }
+            if (*cursor == close_char)
+            {
+                return cursor;
+            }
+            if (*cursor != '"')
+            {
+                return nullptr;
+            }
+
+            // skip the string, braces in it are text
+            ++cursor;
+            while (true)
+            {
+                cursor = findStringSpecial(cursor, end);
+                if (cursor == end || *cursor == '"')
+                {
+                    break;
+                }
+                if (*cursor != '\\' || end - cursor < 2)
+                {
+                    return nullptr;
+                }
+                cursor += 2;
+            }
+            if (cursor == end)
+            {
+                return nullptr;
+            }
+            ++cursor;
+        }
+    }
+
+    const char* PJsonScanner::skipWhitespaceRun(const char* cursor, const char* end)
+    {
+#if defined(PILOT_JSON_SCAN_AVX2) || defined(PILOT_JSON_SCAN_SSE2)
+        while (static_cast<size_t>(end - cursor) >= k_block_size)
+        {
+            const uint32_t mask = getNonWhitespaceMask(cursor);
+            if (mask != 0)
+            {
+                return cursor + countTrailingZeros(mask);
+            }
+            cursor += k_block_size;
+        }
+#endif
+
+        while (cursor != end && isWhitespace(*cursor))
+        {
+            ++cursor;
+        }
+        return cursor;
+    }
+} // namespace Pilot
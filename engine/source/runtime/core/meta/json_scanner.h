@@ -0,0 +1,35 @@
+#pragma once
+
+namespace Pilot
+{
+    /// Scans runs of json text 16 or 32 bytes at a time, with SSE2 or AVX2 when the target has them and byte by
+    /// byte otherwise. The scans never read past end.
+    class PJsonScanner
+    {
+    public:
+        static bool isWhitespace(char c) { return c == ' ' || c == '\n' || c == '\r' || c == '\t'; }
+
+        // first char that is not whitespace, or end
+        static const char* skipWhitespace(const char* cursor, const char* end)
+        {
+            // most values are not preceded by whitespace
+            if (cursor == end || !isWhitespace(*cursor))
+            {
+                return cursor;
+            }
+            return skipWhitespaceRun(cursor, end);
+        }
+
+        // first quote, backslash or control char of a string content, or end
+        static const char* findStringSpecial(const char* cursor, const char* end);
+        // first quote, brace or bracket, or end
+        static const char* findStructural(const char* cursor, const char* end);
+
+        // cursor is past the opening char of an object or array: its closing char if it holds no object or array,
+        // null if it does or if the container does not end before end
+        static const char* findFlatContainerEnd(const char* cursor, const char* end, char close_char);
+
+    private:
+        static const char* skipWhitespaceRun(const char* cursor, const char* end);
+    };
+} // namespace Pilot
@@ -1,6 +1,8 @@
 #include "reflection.h"
+#include <algorithm>
 #include <cstring>
-#include <map>
+#include <memory>
+#include <unordered_map>
 
 namespace Pilot
 {
@@ -9,20 +11,72 @@ namespace Pilot
         const char* k_unknown_type = "UnknownType";
         const char* k_unknown      = "Unknown";
 
-        static std::map<std::string, ClassFunctionTuple*>      m_class_map;
-        static std::multimap<std::string, FieldFunctionTuple*> m_field_map;
-        static std::map<std::string, ArrayFunctionTuple*>      m_array_map;
+        // every name seen by the registry gets one entry: classes, field types and array types
+        struct TypeMetaEntry
+        {
+            TypeMetaEntry(std::string type_name, TypeId type_id) :
+                m_type_name(std::move(type_name)), m_type_id(type_id), m_meta(this)
+            {}
+
+            std::string                m_type_name;
+            TypeId                     m_type_id;
+            std::vector<FieldAccessor> m_fields;
+            ClassFunctionTuple*        m_class_functions {nullptr};
+            ArrayFunctionTuple*        m_array_functions {nullptr};
+            // kept on unregister, so ids cached by the runtime stay valid
+            bool m_is_class {false};
+            // the handle given out by reference
+            TypeMeta m_meta;
+        };
+
+        // entries are never freed, the handles and the accessors point to them
+        static std::unordered_map<std::string, TypeId>     m_type_id_map;
+        static std::vector<std::unique_ptr<TypeMetaEntry>> m_type_entries;
+
+        static const TypeMetaEntry* getUnknownTypeEntry()
+        {
+            static const TypeMetaEntry s_unknown_entry(k_unknown_type, k_invalid_type_id);
+            return &s_unknown_entry;
+        }
+
+        static TypeMetaEntry& internType(const char* type_name)
+        {
+            auto iter = m_type_id_map.find(type_name);
+            if (iter != m_type_id_map.end())
+            {
+                return *m_type_entries[iter->second];
+            }
+
+            const TypeId type_id = static_cast<TypeId>(m_type_entries.size());
+            m_type_entries.push_back(std::make_unique<TypeMetaEntry>(type_name, type_id));
+            m_type_id_map.emplace(type_name, type_id);
+            return *m_type_entries.back();
+        }
+
+        static const TypeMetaEntry* findType(const std::string& type_name)
+        {
+            auto iter = m_type_id_map.find(type_name);
+            return iter != m_type_id_map.end() ? m_type_entries[iter->second].get() : nullptr;
+        }
 
         void TypeMetaRegisterinterface::registerToFieldMap(const char* name, FieldFunctionTuple* value)
         {
-            m_field_map.insert(std::make_pair(name, value));
+            TypeMetaEntry& owner_entry = internType(name);
+
+            FieldAccessor field(value);
+            field.m_owner_type = &owner_entry;
+            field.m_field_type = &internType(field.m_field_type_name);
+            owner_entry.m_fields.push_back(field);
         }
 
         void TypeMetaRegisterinterface::registerToArrayMap(const char* name, ArrayFunctionTuple* value)
         {
-            if (m_array_map.find(name) == m_array_map.end())
+            TypeMetaEntry& entry = internType(name);
+            if (entry.m_array_functions == nullptr)
             {
-                m_array_map.insert(std::make_pair(name, value));
+                entry.m_array_functions = value;
+                // the element type keeps its name even if it is not reflected
+                internType(std::get<4>(*value)());
             }
             else
             {
@@ -32,9 +86,11 @@ namespace Pilot
 
         void TypeMetaRegisterinterface::registerToClassMap(const char* name, ClassFunctionTuple* value)
         {
-            if (m_class_map.find(name) == m_class_map.end())
+            TypeMetaEntry& entry = internType(name);
+            if (entry.m_class_functions == nullptr)
             {
-                m_class_map.insert(std::make_pair(name, value));
+                entry.m_class_functions = value;
+                entry.m_is_class        = true;
             }
             else
             {
@@ -44,54 +100,50 @@ namespace Pilot
 
         void TypeMetaRegisterinterface::unregisterAll()
         {
-            for (const auto& itr : m_field_map)
-            {
-                delete itr.second;
-            }
-            m_field_map.clear();
-            for (const auto& itr : m_class_map)
+            for (const auto& entry : m_type_entries)
             {
-                delete itr.second;
-            }
-            m_class_map.clear();
-            for (const auto& itr : m_array_map)
-            {
-                delete itr.second;
+                for (const FieldAccessor& field : entry->m_fields)
+                {
+                    delete field.m_functions;
+                }
+                entry->m_fields.clear();
+
+                delete entry->m_class_functions;
+                entry->m_class_functions = nullptr;
+
+                delete entry->m_array_functions;
+                entry->m_array_functions = nullptr;
             }
-            m_array_map.clear();
         }
 
-        TypeMeta::TypeMeta(std::string type_name) : m_type_name(type_name)
+        TypeId TypeMeta::getTypeIdFromName(const std::string& type_name)
         {
-            m_is_valid = false;
-            m_fields.clear();
+            const TypeMetaEntry* entry = findType(type_name);
+            return entry != nullptr && entry->m_is_class ? entry->m_type_id : k_invalid_type_id;
+        }
 
-            auto fileds_iter = m_field_map.equal_range(type_name);
-            while (fileds_iter.first != fileds_iter.second)
-            {
-                FieldAccessor f_field(fileds_iter.first->second);
-                m_fields.emplace_back(f_field);
-                m_is_valid = true;
+        TypeMeta::TypeMeta() : m_entry(getUnknownTypeEntry()) {}
 
-                ++fileds_iter.first;
-            }
-        }
+        TypeMeta TypeMeta::newMetaFromName(const std::string& type_name) { return getMetaFromName(type_name); }
 
-        TypeMeta::TypeMeta() : m_type_name(k_unknown_type), m_is_valid(false) { m_fields.clear(); }
+        const TypeMeta& TypeMeta::getMetaFromName(const std::string& type_name)
+        {
+            const TypeMetaEntry* entry = findType(type_name);
+            return entry != nullptr ? entry->m_meta : getUnknownTypeEntry()->m_meta;
+        }
 
-        TypeMeta TypeMeta::newMetaFromName(std::string type_name)
+        const TypeMeta& TypeMeta::getMetaFromId(TypeId type_id)
         {
-            TypeMeta f_type(type_name);
-            return f_type;
+            return type_id < m_type_entries.size() ? m_type_entries[type_id]->m_meta : getUnknownTypeEntry()->m_meta;
         }
 
-        bool TypeMeta::newArrayAccessorFromName(std::string array_type_name, ArrayAccessor& accessor)
+        bool TypeMeta::newArrayAccessorFromName(const std::string& array_type_name, ArrayAccessor& accessor)
         {
-            auto iter = m_array_map.find(array_type_name);
+            const TypeMetaEntry* entry = findType(array_type_name);
 
-            if (iter != m_array_map.end())
+            if (entry != nullptr && entry->m_array_functions != nullptr)
             {
-                ArrayAccessor new_accessor(iter->second);
+                ArrayAccessor new_accessor(entry->m_array_functions);
                 accessor = new_accessor;
                 return true;
             }
@@ -99,77 +151,184 @@ namespace Pilot
             return false;
         }
 
-        ReflectionInstance TypeMeta::newFromNameAndPJson(std::string type_name, const PJson& json_context)
+        ReflectionInstance TypeMeta::newFromNameAndPJson(const std::string& type_name, const PJson& json_context)
         {
-            auto iter = m_class_map.find(type_name);
+            const TypeMetaEntry* entry = findType(type_name);
 
-            if (iter != m_class_map.end())
+            if (entry != nullptr && entry->m_class_functions != nullptr)
             {
-                return ReflectionInstance(TypeMeta(type_name), (std::get<1>(*iter->second)(json_context)));
+                return ReflectionInstance(entry->m_meta, (std::get<1>(*entry->m_class_functions)(json_context)));
             }
             return ReflectionInstance();
         }
 
-        PJson TypeMeta::writeByName(std::string type_name, void* instance)
+        static void copyReflectedFields(const TypeMeta& meta, void* dst_instance, void* src_instance);
+
+        // dst is a plain copy of src or was set by the constructor of its owner
+        static void copyReflectionPtr(ErasedReflectionPtr& dst_ptr, const ErasedReflectionPtr& src_ptr)
+        {
+            if (!src_ptr)
+            {
+                return;
+            }
+
+            if (!dst_ptr || dst_ptr.getPtr() == src_ptr.getPtr())
+            {
+                // a plain copy shares the pointee, the copy gets its own
+                ReflectionInstance copy = TypeMeta::newCopyFromName(src_ptr.getTypeName(), src_ptr.getPtr());
+                dst_ptr =
+                    ErasedReflectionPtr(src_ptr.getTypeName(), static_cast<ErasedReflectionTarget*>(copy.m_instance));
+            }
+            else if (dst_ptr.getTypeName() == src_ptr.getTypeName())
+            {
+                // deep copied by a copy constructor, only the reflected fields are set again
+                copyReflectedFields(
+                    TypeMeta::getMetaFromName(src_ptr.getTypeName()), dst_ptr.getPtr(), src_ptr.getPtr());
+            }
+        }
+
+        static void copyReflectedFields(const TypeMeta& meta, void* dst_instance, void* src_instance)
+        {
+            // each type only lists its own fields
+            ReflectionInstance* dst_bases  = nullptr;
+            ReflectionInstance* src_bases  = nullptr;
+            const int           base_count = meta.getBaseClassReflectionInstanceList(dst_bases, dst_instance);
+            meta.getBaseClassReflectionInstanceList(src_bases, src_instance);
+            for (int base_index = 0; base_index < base_count; ++base_index)
+            {
+                copyReflectedFields(dst_bases[base_index].m_meta,
+                                    dst_bases[base_index].m_instance,
+                                    src_bases[base_index].m_instance);
+            }
+            delete[] dst_bases;
+            delete[] src_bases;
+
+            for (const FieldAccessor& field : meta.getFields())
+            {
+                void* dst_field = field.get(dst_instance);
+                void* src_field = field.get(src_instance);
+
+                if (field.isArrayType())
+                {
+                    // the accessors cannot resize, the array is copied whole, then the elements sharing a pointee
+                    // with the source are fixed
+                    field.set(dst_instance, src_field);
+
+                    ArrayAccessor array_accessor;
+                    if (!field.getArrayAccessor(array_accessor))
+                        continue;
+
+                    const std::string element_type_name = array_accessor.getElementTypeName();
+                    const bool        is_element_ptr    = isReflectionPtrType(element_type_name);
+                    const TypeMeta&   element_meta      = TypeMeta::getMetaFromName(element_type_name);
+                    if (!is_element_ptr && element_meta.getTypeId() == k_invalid_type_id)
+                        continue;
+
+                    const int element_count = array_accessor.getSize(dst_field);
+                    for (int element_index = 0; element_index < element_count; ++element_index)
+                    {
+                        void* dst_element = array_accessor.get(element_index, dst_field);
+                        void* src_element = array_accessor.get(element_index, src_field);
+                        if (is_element_ptr)
+                        {
+                            copyReflectionPtr(*static_cast<ErasedReflectionPtr*>(dst_element),
+                                              *static_cast<const ErasedReflectionPtr*>(src_element));
+                        }
+                        else
+                        {
+                            copyReflectedFields(element_meta, dst_element, src_element);
+                        }
+                    }
+                    continue;
+                }
+
+                if (isReflectionPtrType(field.getFieldTypeName()))
+                {
+                    copyReflectionPtr(*static_cast<ErasedReflectionPtr*>(dst_field),
+                                      *static_cast<const ErasedReflectionPtr*>(src_field));
+                    continue;
+                }
+
+                TypeMeta field_meta;
+                field.getTypeMeta(field_meta);
+                if (field_meta.getTypeId() != k_invalid_type_id)
+                {
+                    // field by field, an assignment would share the pointees of its ReflectionPtr fields
+                    copyReflectedFields(field_meta, dst_field, src_field);
+                }
+                else
+                {
+                    // primitives, strings and enums
+                    field.set(dst_instance, src_field);
+                }
+            }
+        }
+
+        ReflectionInstance TypeMeta::newCopyFromName(const std::string& type_name, void* instance)
         {
-            auto iter = m_class_map.find(type_name);
+            const TypeMetaEntry* entry = findType(type_name);
 
-            if (iter != m_class_map.end())
+            if (entry == nullptr || entry->m_class_functions == nullptr)
             {
-                return std::get<2>(*iter->second)(instance);
+                return ReflectionInstance();
+            }
+
+            // an empty object reads no field, the constructor sets them all
+            void* copy = std::get<1>(*entry->m_class_functions)(PJson::object {});
+            copyReflectedFields(entry->m_meta, copy, instance);
+            return ReflectionInstance(entry->m_meta, copy);
+        }
+
+        PJson TypeMeta::writeByName(const std::string& type_name, void* instance)
+        {
+            const TypeMetaEntry* entry = findType(type_name);
+
+            if (entry != nullptr && entry->m_class_functions != nullptr)
+            {
+                return std::get<2>(*entry->m_class_functions)(instance);
             }
             return PJson();
         }
 
-        std::string TypeMeta::getTypeName() { return m_type_name; }
+        const std::string& TypeMeta::getTypeName() const { return m_entry->m_type_name; }
+
+        TypeId TypeMeta::getTypeId() const { return m_entry->m_is_class ? m_entry->m_type_id : k_invalid_type_id; }
 
-        int TypeMeta::getFieldsList(FieldAccessor*& out_list)
+        int TypeMeta::getFieldsList(FieldAccessor*& out_list) const
         {
-            int count = m_fields.size();
+            int count = m_entry->m_fields.size();
             out_list  = new FieldAccessor[count];
             for (int i = 0; i < count; ++i)
             {
-                out_list[i] = m_fields[i];
+                out_list[i] = m_entry->m_fields[i];
             }
             return count;
         }
 
-        int TypeMeta::getBaseClassReflectionInstanceList(ReflectionInstance*& out_list, void* instance)
-        {
-            auto iter = m_class_map.find(m_type_name);
+        const std::vector<FieldAccessor>& TypeMeta::getFields() const { return m_entry->m_fields; }
 
-            if (iter != m_class_map.end())
+        int TypeMeta::getBaseClassReflectionInstanceList(ReflectionInstance*& out_list, void* instance) const
+        {
+            if (m_entry->m_class_functions != nullptr)
             {
-                return (std::get<0>(*iter->second))(out_list, instance);
+                return (std::get<0>(*m_entry->m_class_functions))(out_list, instance);
             }
 
             return 0;
         }
 
-        FieldAccessor TypeMeta::getFieldByName(const char* name)
+        FieldAccessor TypeMeta::getFieldByName(const char* name) const
         {
-            const auto it = std::find_if(m_fields.begin(), m_fields.end(), [&](const auto& i) {
+            const auto it = std::find_if(m_entry->m_fields.begin(), m_entry->m_fields.end(), [&](const auto& i) {
                 return std::strcmp(i.getFieldName(), name) == 0;
             });
-            if (it != m_fields.end())
+            if (it != m_entry->m_fields.end())
                 return *it;
             return FieldAccessor(nullptr);
         }
 
-        TypeMeta& TypeMeta::operator=(const TypeMeta& dest)
-        {
-            if (this == &dest)
-            {
-                return *this;
-            }
-            m_fields.clear();
-            m_fields = dest.m_fields;
-
-            m_type_name = dest.m_type_name;
-            m_is_valid  = dest.m_is_valid;
+        bool TypeMeta::isValid() const { return !m_entry->m_fields.empty(); }
 
-            return *this;
-        }
         FieldAccessor::FieldAccessor()
         {
             m_field_type_name = k_unknown_type;
@@ -186,43 +345,38 @@ namespace Pilot
                 return;
             }
 
+            m_setter          = std::get<0>(*m_functions);
+            m_getter          = std::get<1>(*m_functions);
             m_field_type_name = (std::get<4>(*m_functions))();
             m_field_name      = (std::get<3>(*m_functions))();
+            m_is_array        = (std::get<5>(*m_functions))();
         }
 
-        void* FieldAccessor::get(void* instance)
-        {
-            // todo: should check validation
-            return static_cast<void*>((std::get<1>(*m_functions))(instance));
-        }
-
-        void FieldAccessor::set(void* instance, void* value)
+        TypeMeta FieldAccessor::getOwnerTypeMeta() const
         {
             // todo: should check validation
-            (std::get<0>(*m_functions))(instance, value);
+            return m_owner_type != nullptr ? m_owner_type->m_meta : TypeMeta();
         }
 
-        TypeMeta FieldAccessor::getOwnerTypeMeta()
+        bool FieldAccessor::getTypeMeta(TypeMeta& field_type) const
         {
-            // todo: should check validation
-            TypeMeta f_type((std::get<2>(*m_functions))());
-            return f_type;
-        }
-
-        bool FieldAccessor::getTypeMeta(TypeMeta& field_type)
-        {
-            TypeMeta f_type(m_field_type_name);
-            field_type = f_type;
-            return f_type.m_is_valid;
+            field_type = m_field_type != nullptr ? m_field_type->m_meta : TypeMeta();
+            return field_type.isValid();
         }
 
         const char* FieldAccessor::getFieldName() const { return m_field_name; }
-        const char* FieldAccessor::getFieldTypeName() { return m_field_type_name; }
+        const char* FieldAccessor::getFieldTypeName() const { return m_field_type_name; }
 
-        bool FieldAccessor::isArrayType()
+        bool FieldAccessor::getArrayAccessor(ArrayAccessor& accessor) const
         {
-            // todo: should check validation
-            return (std::get<5>(*m_functions))();
+            if (m_field_type == nullptr || m_field_type->m_array_functions == nullptr)
+            {
+                return false;
+            }
+
+            ArrayAccessor new_accessor(m_field_type->m_array_functions);
+            accessor = new_accessor;
+            return true;
         }
 
         FieldAccessor& FieldAccessor::operator=(const FieldAccessor& dest)
@@ -232,8 +386,13 @@ namespace Pilot
                 return *this;
             }
             m_functions       = dest.m_functions;
+            m_getter          = dest.m_getter;
+            m_setter          = dest.m_setter;
             m_field_name      = dest.m_field_name;
             m_field_type_name = dest.m_field_type_name;
+            m_is_array        = dest.m_is_array;
+            m_owner_type      = dest.m_owner_type;
+            m_field_type      = dest.m_field_type;
             return *this;
         }
 
@@ -250,32 +409,14 @@ namespace Pilot
                 return;
             }
 
+            m_setter            = std::get<0>(*m_func);
+            m_getter            = std::get<1>(*m_func);
+            m_size_getter       = std::get<2>(*m_func);
             m_array_type_name   = std::get<3>(*m_func)();
             m_element_type_name = std::get<4>(*m_func)();
         }
         const char* ArrayAccessor::getArrayTypeName() { return m_array_type_name; }
         const char* ArrayAccessor::getElementTypeName() { return m_element_type_name; }
-        void        ArrayAccessor::set(int index, void* instance, void* element_value)
-        {
-            // todo: should check validation
-            size_t count = getSize(instance);
-            // todo: should check validation(index < count)
-            std::get<0> (*m_func)(index, instance, element_value);
-        }
-
-        void* ArrayAccessor::get(int index, void* instance)
-        {
-            // todo: should check validation
-            size_t count = getSize(instance);
-            // todo: should check validation(index < count)
-            return std::get<1>(*m_func)(index, instance);
-        }
-
-        int ArrayAccessor::getSize(void* instance)
-        {
-            // todo: should check validation
-            return std::get<2>(*m_func)(instance);
-        }
 
         ArrayAccessor& ArrayAccessor::operator=(ArrayAccessor& dest)
         {
@@ -284,11 +425,19 @@ namespace Pilot
                 return *this;
             }
             m_func              = dest.m_func;
+            m_setter            = dest.m_setter;
+            m_getter            = dest.m_getter;
+            m_size_getter       = dest.m_size_getter;
             m_array_type_name   = dest.m_array_type_name;
             m_element_type_name = dest.m_element_type_name;
             return *this;
         }
 
+        bool isReflectionPtrType(const std::string& type_name)
+        {
+            return type_name.find("ReflectionPtr<") != std::string::npos;
+        }
+
         ReflectionInstance& ReflectionInstance::operator=(ReflectionInstance& dest)
         {
             if (this == &dest)
@@ -1,8 +1,11 @@
 #pragma once
 #include "runtime/core/meta/json.h"
 
+#include <cstdint>
 #include <functional>
+#include <limits>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -73,17 +76,18 @@ namespace Pilot
         class ArrayAccessor;
         class ReflectionInstance;
     } // namespace Reflection
-    typedef std::function<void(void*, void*)>      SetFuncion;
-    typedef std::function<void*(void*)>            GetFuncion;
-    typedef std::function<const char*()>           GetNameFuncion;
-    typedef std::function<void(int, void*, void*)> SetArrayFunc;
-    typedef std::function<void*(int, void*)>       GetArrayFunc;
-    typedef std::function<int(void*)>              GetSizeFunc;
-    typedef std::function<bool()>                  GetBoolFunc;
-
-    typedef std::function<void*(const PJson&)>                          ConstructorWithPJson;
-    typedef std::function<PJson(void*)>                                 WritePJsonByName;
-    typedef std::function<int(Reflection::ReflectionInstance*&, void*)> GetBaseClassReflectionInstanceListFunc;
+    // the generated operators are static functions, the tables hold plain pointers to them
+    typedef void (*SetFuncion)(void*, void*);
+    typedef void* (*GetFuncion)(void*);
+    typedef const char* (*GetNameFuncion)();
+    typedef void (*SetArrayFunc)(int, void*, void*);
+    typedef void* (*GetArrayFunc)(int, void*);
+    typedef int (*GetSizeFunc)(void*);
+    typedef bool (*GetBoolFunc)();
+
+    typedef void* (*ConstructorWithPJson)(const PJson&);
+    typedef PJson (*WritePJsonByName)(void*);
+    typedef int (*GetBaseClassReflectionInstanceListFunc)(Reflection::ReflectionInstance*&, void*);
 
     typedef std::tuple<SetFuncion, GetFuncion, GetNameFuncion, GetNameFuncion, GetNameFuncion, GetBoolFunc>
         FieldFunctionTuple;
@@ -93,6 +97,10 @@ namespace Pilot
 
     namespace Reflection
     {
+        using TypeId = uint32_t;
+
+        static constexpr TypeId k_invalid_type_id = std::numeric_limits<TypeId>::max();
+
         class TypeMetaRegisterinterface
         {
         public:
@@ -102,57 +110,75 @@ namespace Pilot
 
             static void unregisterAll();
         };
+        // registry entry of a type name, defined in reflection.cpp
+        struct TypeMetaEntry;
+
+        /// Handle to the registered meta of a type. The meta is built once when the type registers and never
+        /// copied, so a TypeMeta is as cheap to copy as a pointer and the queries do not allocate.
+        /// The registry is filled at startup, the queries may run on any thread afterwards.
         class TypeMeta
         {
             friend class FieldAccessor;
             friend class ArrayAccessor;
             friend class TypeMetaRegisterinterface;
+            friend struct TypeMetaEntry;
 
         public:
             TypeMeta();
 
             // static void Register();
 
-            static TypeMeta newMetaFromName(std::string type_name);
+            static TypeMeta newMetaFromName(const std::string& type_name);
 
-            static bool               newArrayAccessorFromName(std::string array_type_name, ArrayAccessor& accessor);
-            static ReflectionInstance newFromNameAndPJson(std::string type_name, const PJson& json_context);
-            static PJson              writeByName(std::string type_name, void* instance);
+            // the cached meta, an invalid meta if the type is unknown
+            static const TypeMeta& getMetaFromName(const std::string& type_name);
+            static const TypeMeta& getMetaFromId(TypeId type_id);
 
-            std::string getTypeName();
+            // id given to a class when it is registered, it stays the same until exit
+            static TypeId getTypeIdFromName(const std::string& type_name);
 
-            int getFieldsList(FieldAccessor*& out_list);
+            static bool newArrayAccessorFromName(const std::string& array_type_name, ArrayAccessor& accessor);
+            static ReflectionInstance newFromNameAndPJson(const std::string& type_name, const PJson& json_context);
+            // deep copy of the reflected fields of instance, including the objects behind its ReflectionPtr fields.
+            // The other fields keep the value given by the default constructor, like after newFromNameAndPJson
+            static ReflectionInstance newCopyFromName(const std::string& type_name, void* instance);
+            static PJson              writeByName(const std::string& type_name, void* instance);
 
-            int getBaseClassReflectionInstanceList(ReflectionInstance*& out_list, void* instance);
+            const std::string& getTypeName() const;
 
-            FieldAccessor getFieldByName(const char* name);
+            // k_invalid_type_id if the type is not a registered class
+            TypeId getTypeId() const;
 
-            bool isValid() { return m_is_valid; }
+            // the caller deletes the list, getFields does not copy
+            int                               getFieldsList(FieldAccessor*& out_list) const;
+            const std::vector<FieldAccessor>& getFields() const;
 
-            TypeMeta& operator=(const TypeMeta& dest);
+            int getBaseClassReflectionInstanceList(ReflectionInstance*& out_list, void* instance) const;
 
-        private:
-            TypeMeta(std::string type_name);
+            FieldAccessor getFieldByName(const char* name) const;
 
-        private:
-            std::vector<FieldAccessor, std::allocator<FieldAccessor>> m_fields;
+            bool isValid() const;
 
-            std::string m_type_name;
+        private:
+            explicit TypeMeta(const TypeMetaEntry* entry) : m_entry(entry) {}
 
-            bool m_is_valid;
+        private:
+            const TypeMetaEntry* m_entry;
         };
 
         class FieldAccessor
         {
             friend class TypeMeta;
+            friend class TypeMetaRegisterinterface;
 
         public:
             FieldAccessor();
 
-            void* get(void* instance);
-            void  set(void* instance, void* value);
+            // todo: should check validation
+            void* get(void* instance) const { return m_getter(instance); }
+            void  set(void* instance, void* value) const { m_setter(instance, value); }
 
-            TypeMeta getOwnerTypeMeta();
+            TypeMeta getOwnerTypeMeta() const;
 
             /**
              * param: TypeMeta out_type
@@ -162,10 +188,13 @@ namespace Pilot
              *        true: it's a reflection type
              *        false: it's not a reflection type
              */
-            bool        getTypeMeta(TypeMeta& field_type);
+            bool        getTypeMeta(TypeMeta& field_type) const;
             const char* getFieldName() const;
-            const char* getFieldTypeName();
-            bool        isArrayType();
+            const char* getFieldTypeName() const;
+            bool        isArrayType() const { return m_is_array; }
+
+            // accessor of an array field without a lookup by name
+            bool getArrayAccessor(ArrayAccessor& accessor) const;
 
             FieldAccessor& operator=(const FieldAccessor& dest);
 
@@ -174,8 +203,15 @@ namespace Pilot
 
         private:
             FieldFunctionTuple* m_functions;
-            const char*         m_field_name;
-            const char*         m_field_type_name;
+            // copied out of the tuple, get and set are a single call
+            GetFuncion  m_getter {nullptr};
+            SetFuncion  m_setter {nullptr};
+            const char* m_field_name;
+            const char* m_field_type_name;
+            bool        m_is_array {false};
+            // resolved when the field registers
+            const TypeMetaEntry* m_owner_type {nullptr};
+            const TypeMetaEntry* m_field_type {nullptr};
         };
 
         /**
@@ -184,15 +220,21 @@ namespace Pilot
         class ArrayAccessor
         {
             friend class TypeMeta;
+            friend class FieldAccessor;
 
         public:
             ArrayAccessor();
             const char* getArrayTypeName();
             const char* getElementTypeName();
-            void        set(int index, void* instance, void* element_value);
 
-            void* get(int index, void* instance);
-            int   getSize(void* instance);
+            // todo: should check validation(index < count)
+            void set(int index, void* instance, void* element_value) const
+            {
+                m_setter(index, instance, element_value);
+            }
+
+            void* get(int index, void* instance) const { return m_getter(index, instance); }
+            int   getSize(void* instance) const { return m_size_getter(instance); }
 
             ArrayAccessor& operator=(ArrayAccessor& dest);
 
@@ -201,6 +243,9 @@ namespace Pilot
 
         private:
             ArrayFunctionTuple* m_func;
+            SetArrayFunc        m_setter {nullptr};
+            GetArrayFunc        m_getter {nullptr};
+            GetSizeFunc         m_size_getter {nullptr};
             const char*         m_array_type_name;
             const char*         m_element_type_name;
         };
@@ -278,7 +323,7 @@ namespace Pilot
                 return *this;
             }
 
-            std::string getTypeName() const { return m_type_name; }
+            const std::string& getTypeName() const { return m_type_name; }
 
             void setTypeName(std::string name) { m_type_name = name; }
 
@@ -340,6 +385,14 @@ namespace Pilot
             T*          m_instance {nullptr};
         };
 
+        /// Pointee of a ReflectionPtr reached through a field accessor, whose T is only known by name.
+        /// ReflectionPtr<T> has the same layout whatever T is, so the field can be read and written as an
+        /// ErasedReflectionPtr, the address of the pointee is the address of its dynamic type.
+        class ErasedReflectionTarget;
+        using ErasedReflectionPtr = ReflectionPtr<ErasedReflectionTarget>;
+
+        // true if a field or an array element of this type is a ReflectionPtr
+        bool isReflectionPtrType(const std::string& type_name);
     } // namespace Reflection
 
 } // namespace Pilot
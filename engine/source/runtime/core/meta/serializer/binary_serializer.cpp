@@ -0,0 +1,515 @@
+#include "runtime/core/meta/serializer/binary_serializer.h"
+
+#include "runtime/core/meta/reflection/reflection.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace Pilot
+{
+    namespace
+    {
+        constexpr uint32_t k_binary_archive_magic = 0x4E494250; // "PBIN"
+
+        enum class BinaryTag : uint8_t
+        {
+            null,
+            // a field of the schema missing from the json, read back as no key at all
+            missing,
+            boolean_false,
+            boolean_true,
+            int32,
+            float32,
+            float64,
+            string,
+            array,
+            // reflected object, values in field order
+            schema_object,
+            // any other object, with its keys
+            object,
+            // {"$typeName", "$context"} written for ReflectionPtr and raw pointers
+            pointer
+        };
+
+        struct BinarySchemaField
+        {
+            std::string m_name;
+            std::string m_type_name;
+        };
+
+        struct BinarySchema
+        {
+            // fields of the base classes first
+            std::vector<BinarySchemaField> m_fields;
+        };
+
+        uint64_t hashBytes(uint64_t hash, const void* bytes, size_t size)
+        {
+            // FNV-1a
+            const uint8_t* first = static_cast<const uint8_t*>(bytes);
+            for (size_t index = 0; index < size; ++index)
+            {
+                hash ^= first[index];
+                hash *= 0x100000001B3ull;
+            }
+            return hash;
+        }
+
+        uint64_t hashString(uint64_t hash, const std::string& text)
+        {
+            // the terminator keeps "ab" + "c" apart from "a" + "bc"
+            return hashBytes(hash, text.c_str(), text.size() + 1);
+        }
+
+        void appendSchemaFields(const Reflection::TypeMeta& meta, std::vector<BinarySchemaField>& fields)
+        {
+            // the generated writer merges the json of the base classes into the object
+            Reflection::ReflectionInstance* base_instances = nullptr;
+            const int base_count = meta.getBaseClassReflectionInstanceList(base_instances, nullptr);
+            for (int base_index = 0; base_index < base_count; ++base_index)
+            {
+                appendSchemaFields(base_instances[base_index].m_meta, fields);
+            }
+            delete[] base_instances;
+
+            for (const Reflection::FieldAccessor& field_accessor : meta.getFields())
+            {
+                fields.push_back({field_accessor.getFieldName(), field_accessor.getFieldTypeName()});
+            }
+        }
+
+        // null if the type is not a reflected class, schemas are never freed
+        const BinarySchema* getSchema(const std::string& type_name)
+        {
+            static std::mutex                                                     s_schema_mutex;
+            static std::unordered_map<std::string, std::unique_ptr<BinarySchema>> s_schemas;
+
+            if (type_name.empty())
+            {
+                return nullptr;
+            }
+
+            std::lock_guard<std::mutex> lock(s_schema_mutex);
+
+            auto iter = s_schemas.find(type_name);
+            if (iter != s_schemas.end())
+            {
+                return iter->second.get();
+            }
+
+            std::unique_ptr<BinarySchema> schema;
+            if (Reflection::TypeMeta::getTypeIdFromName(type_name) != Reflection::k_invalid_type_id)
+            {
+                schema = std::make_unique<BinarySchema>();
+                appendSchemaFields(Reflection::TypeMeta::getMetaFromName(type_name), schema->m_fields);
+            }
+            return s_schemas.emplace(type_name, std::move(schema)).first->second.get();
+        }
+
+        // element type of an array type, empty if type_name is not a reflected array
+        std::string getElementTypeName(const std::string& type_name)
+        {
+            Reflection::ArrayAccessor array_accessor;
+            if (type_name.empty() || !Reflection::TypeMeta::newArrayAccessorFromName(type_name, array_accessor))
+            {
+                return std::string();
+            }
+            return array_accessor.getElementTypeName();
+        }
+
+        // static type pointed by "Reflection::ReflectionPtr<T>" or "T*", type_name itself otherwise
+        std::string getPointeeTypeName(const std::string& type_name)
+        {
+            const size_t template_begin = type_name.find("ReflectionPtr<");
+            if (template_begin != std::string::npos)
+            {
+                const size_t name_begin = template_begin + std::strlen("ReflectionPtr<");
+                const size_t name_end   = type_name.rfind('>');
+                return name_end > name_begin ? type_name.substr(name_begin, name_end - name_begin) : std::string();
+            }
+            if (!type_name.empty() && type_name.back() == '*')
+            {
+                return type_name.substr(0, type_name.size() - 1);
+            }
+            return type_name;
+        }
+
+        uint64_t computeSchemaHash(const std::string& type_name, std::unordered_set<std::string>& visiting_type_names)
+        {
+            uint64_t hash = hashString(0xCBF29CE484222325ull, type_name);
+
+            const std::string element_type_name = getElementTypeName(type_name);
+            if (!element_type_name.empty())
+            {
+                const uint64_t element_hash = computeSchemaHash(element_type_name, visiting_type_names);
+                return hashBytes(hash, &element_hash, sizeof(element_hash));
+            }
+
+            const BinarySchema* schema = getSchema(getPointeeTypeName(type_name));
+            // a type holding itself is only hashed once
+            if (schema == nullptr || !visiting_type_names.insert(type_name).second)
+            {
+                return hash;
+            }
+
+            for (const BinarySchemaField& field : schema->m_fields)
+            {
+                hash                      = hashString(hash, field.m_name);
+                const uint64_t field_hash = computeSchemaHash(field.m_type_name, visiting_type_names);
+                hash                      = hashBytes(hash, &field_hash, sizeof(field_hash));
+            }
+
+            visiting_type_names.erase(type_name);
+            return hash;
+        }
+
+        uint64_t getCachedSchemaHash(const std::string& type_name)
+        {
+            static std::mutex                                s_hash_mutex;
+            static std::unordered_map<std::string, uint64_t> s_hashes;
+
+            {
+                std::lock_guard<std::mutex> lock(s_hash_mutex);
+
+                auto iter = s_hashes.find(type_name);
+                if (iter != s_hashes.end())
+                {
+                    return iter->second;
+                }
+            }
+
+            std::unordered_set<std::string> visiting_type_names;
+            const uint64_t                  hash = computeSchemaHash(type_name, visiting_type_names);
+
+            std::lock_guard<std::mutex> lock(s_hash_mutex);
+            s_hashes.emplace(type_name, hash);
+            return hash;
+        }
+
+        bool isPointerJson(const PJson& json)
+        {
+            const PJson::object& items = json.object_items();
+            return items.size() == 2 && items.count("$typeName") && items.count("$context") &&
+                   json["$typeName"].is_string();
+        }
+
+        class BinaryWriter
+        {
+        public:
+            explicit BinaryWriter(std::vector<uint8_t>& data) : m_data(data) {}
+
+            void writeBytes(const void* bytes, size_t size)
+            {
+                const uint8_t* first = static_cast<const uint8_t*>(bytes);
+                m_data.insert(m_data.end(), first, first + size);
+            }
+
+            template<typename T>
+            void writeValue(const T& value)
+            {
+                writeBytes(&value, sizeof(T));
+            }
+
+            void writeTag(BinaryTag tag) { m_data.push_back(static_cast<uint8_t>(tag)); }
+
+            void writeString(const std::string& text)
+            {
+                writeValue(static_cast<uint32_t>(text.size()));
+                writeBytes(text.data(), text.size());
+            }
+
+            void writeNumber(double value)
+            {
+                // most numbers are ints or floats widened to double, keep the smallest exact encoding
+                if (std::nearbyint(value) == value && value >= std::numeric_limits<int32_t>::min() &&
+                    value <= std::numeric_limits<int32_t>::max())
+                {
+                    writeTag(BinaryTag::int32);
+                    writeValue(static_cast<int32_t>(value));
+                }
+                else if (static_cast<double>(static_cast<float>(value)) == value)
+                {
+                    writeTag(BinaryTag::float32);
+                    writeValue(static_cast<float>(value));
+                }
+                else
+                {
+                    writeTag(BinaryTag::float64);
+                    writeValue(value);
+                }
+            }
+
+            // type_name is the static type of the value, it may be empty for values outside of any schema
+            void writeJson(const PJson& json, const std::string& type_name)
+            {
+                switch (json.type())
+                {
+                    case PJson::NUL:
+                        writeTag(BinaryTag::null);
+                        break;
+                    case PJson::BOOL:
+                        writeTag(json.bool_value() ? BinaryTag::boolean_true : BinaryTag::boolean_false);
+                        break;
+                    case PJson::NUMBER:
+                        writeNumber(json.number_value());
+                        break;
+                    case PJson::STRING:
+                        writeTag(BinaryTag::string);
+                        writeString(json.string_value());
+                        break;
+                    case PJson::ARRAY:
+                    {
+                        const std::string element_type_name = getElementTypeName(type_name);
+
+                        writeTag(BinaryTag::array);
+                        writeValue(static_cast<uint32_t>(json.array_items().size()));
+                        for (const PJson& element : json.array_items())
+                        {
+                            writeJson(element, element_type_name);
+                        }
+                        break;
+                    }
+                    case PJson::OBJECT:
+                        writeObject(json, type_name);
+                        break;
+                    default:
+                        break;
+                }
+            }
+
+        private:
+            void writeObject(const PJson& json, const std::string& type_name)
+            {
+                if (isPointerJson(json))
+                {
+                    // "*" means the static type, anything else is the name of the dynamic type
+                    const std::string& pointer_type_name = json["$typeName"].string_value();
+                    const std::string  context_type_name =
+                        pointer_type_name == "*" ? getPointeeTypeName(type_name) : pointer_type_name;
+
+                    writeTag(BinaryTag::pointer);
+                    writeString(pointer_type_name);
+                    writeValue(getCachedSchemaHash(context_type_name));
+                    writeJson(json["$context"], context_type_name);
+                    return;
+                }
+
+                const PJson::object& items  = json.object_items();
+                const BinarySchema*  schema = getSchema(type_name);
+                if (schema && hasOnlySchemaKeys(items, *schema))
+                {
+                    writeTag(BinaryTag::schema_object);
+                    for (const BinarySchemaField& field : schema->m_fields)
+                    {
+                        auto iter = items.find(field.m_name);
+                        if (iter == items.end())
+                        {
+                            writeTag(BinaryTag::missing);
+                            continue;
+                        }
+                        writeJson(iter->second, field.m_type_name);
+                    }
+                    return;
+                }
+
+                writeTag(BinaryTag::object);
+                writeValue(static_cast<uint32_t>(items.size()));
+                for (const auto& item : items)
+                {
+                    writeString(item.first);
+                    writeJson(item.second, std::string());
+                }
+            }
+
+            static bool hasOnlySchemaKeys(const PJson::object& items, const BinarySchema& schema)
+            {
+                size_t schema_key_count = 0;
+                for (const BinarySchemaField& field : schema.m_fields)
+                {
+                    schema_key_count += items.count(field.m_name);
+                }
+                return schema_key_count == items.size();
+            }
+
+            std::vector<uint8_t>& m_data;
+        };
+
+        class BinaryReader
+        {
+        public:
+            BinaryReader(const uint8_t* data, size_t size) : m_cursor(data), m_end(data + size) {}
+
+            bool isValid() const { return m_is_valid; }
+            bool isAtEnd() const { return m_cursor == m_end; }
+
+            // null once the data is exhausted, the reader stays invalid from then on
+            const uint8_t* readBytes(size_t size)
+            {
+                if (!m_is_valid || static_cast<size_t>(m_end - m_cursor) < size)
+                {
+                    m_is_valid = false;
+                    return nullptr;
+                }
+                const uint8_t* bytes = m_cursor;
+                m_cursor += size;
+                return bytes;
+            }
+
+            template<typename T>
+            T readValue()
+            {
+                T              value {};
+                const uint8_t* bytes = readBytes(sizeof(T));
+                if (bytes)
+                {
+                    std::memcpy(&value, bytes, sizeof(T));
+                }
+                return value;
+            }
+
+            std::string readString()
+            {
+                const uint32_t length = readValue<uint32_t>();
+                const uint8_t* chars  = readBytes(length);
+                return chars ? std::string(reinterpret_cast<const char*>(chars), length) : std::string();
+            }
+
+            BinaryTag readTag() { return static_cast<BinaryTag>(readValue<uint8_t>()); }
+
+            PJson readJson(const std::string& type_name) { return readJson(readTag(), type_name); }
+
+            PJson readJson(BinaryTag tag, const std::string& type_name)
+            {
+                switch (tag)
+                {
+                    case BinaryTag::null:
+                        return PJson();
+                    case BinaryTag::boolean_false:
+                        return PJson(false);
+                    case BinaryTag::boolean_true:
+                        return PJson(true);
+                    case BinaryTag::int32:
+                        return PJson(static_cast<int>(readValue<int32_t>()));
+                    case BinaryTag::float32:
+                        return PJson(static_cast<double>(readValue<float>()));
+                    case BinaryTag::float64:
+                        return PJson(readValue<double>());
+                    case BinaryTag::string:
+                        return PJson(readString());
+                    case BinaryTag::array:
+                    {
+                        const std::string element_type_name = getElementTypeName(type_name);
+                        const uint32_t    element_count     = readValue<uint32_t>();
+
+                        PJson::array elements;
+                        // every element takes one byte at least, a corrupted count cannot reserve too much
+                        elements.reserve(std::min<size_t>(element_count, m_end - m_cursor));
+                        for (uint32_t element_index = 0; element_index < element_count && m_is_valid; ++element_index)
+                        {
+                            elements.push_back(readJson(element_type_name));
+                        }
+                        return PJson(std::move(elements));
+                    }
+                    case BinaryTag::schema_object:
+                    {
+                        const BinarySchema* schema = getSchema(type_name);
+                        if (schema == nullptr)
+                        {
+                            m_is_valid = false;
+                            return PJson();
+                        }
+
+                        PJson::object items;
+                        for (const BinarySchemaField& field : schema->m_fields)
+                        {
+                            const BinaryTag field_tag = readTag();
+                            if (field_tag != BinaryTag::missing)
+                            {
+                                items.emplace(field.m_name, readJson(field_tag, field.m_type_name));
+                            }
+                        }
+                        return PJson(std::move(items));
+                    }
+                    case BinaryTag::object:
+                    {
+                        const uint32_t item_count = readValue<uint32_t>();
+
+                        PJson::object items;
+                        for (uint32_t item_index = 0; item_index < item_count && m_is_valid; ++item_index)
+                        {
+                            std::string key = readString();
+                            items.emplace(std::move(key), readJson(std::string()));
+                        }
+                        return PJson(std::move(items));
+                    }
+                    case BinaryTag::pointer:
+                    {
+                        std::string       pointer_type_name = readString();
+                        const uint64_t    schema_hash       = readValue<uint64_t>();
+                        const std::string context_type_name =
+                            pointer_type_name == "*" ? getPointeeTypeName(type_name) : pointer_type_name;
+
+                        // the root hash does not cover the dynamic types
+                        if (schema_hash != getCachedSchemaHash(context_type_name))
+                        {
+                            m_is_valid = false;
+                            return PJson();
+                        }
+
+                        PJson context = readJson(context_type_name);
+                        return PJson(PJson::object {{"$typeName", PJson(std::move(pointer_type_name))},
+                                                    {"$context", std::move(context)}});
+                    }
+                    default:
+                        m_is_valid = false;
+                        return PJson();
+                }
+            }
+
+        private:
+            const uint8_t* m_cursor;
+            const uint8_t* m_end;
+            bool           m_is_valid {true};
+        };
+    } // namespace
+
+    void PBinarySerializer::writeJson(const PJson& json, const std::string& type_name, std::vector<uint8_t>& out_data)
+    {
+        BinaryWriter writer(out_data);
+        writer.writeValue(k_binary_archive_magic);
+        writer.writeValue(k_format_version);
+        writer.writeValue(getCachedSchemaHash(type_name));
+        writer.writeString(type_name);
+        writer.writeJson(json, type_name);
+    }
+
+    bool PBinarySerializer::readJson(const uint8_t* data, size_t size, const std::string& type_name, PJson& out_json)
+    {
+        BinaryReader reader(data, size);
+        if (reader.readValue<uint32_t>() != k_binary_archive_magic || reader.readValue<uint32_t>() != k_format_version ||
+            reader.readValue<uint64_t>() != getCachedSchemaHash(type_name) || reader.readString() != type_name)
+        {
+            return false;
+        }
+
+        PJson json = reader.readJson(type_name);
+        if (!reader.isValid() || !reader.isAtEnd())
+        {
+            return false;
+        }
+
+        out_json = std::move(json);
+        return true;
+    }
+
+    uint64_t PBinarySerializer::getSchemaHash(const std::string& type_name)
+    {
+        return getSchema(type_name) ? getCachedSchemaHash(type_name) : 0;
+    }
+} // namespace Pilot
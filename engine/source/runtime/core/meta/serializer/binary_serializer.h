@@ -0,0 +1,49 @@
+#pragma once
+#include "runtime/core/meta/json.h"
+#include "runtime/core/meta/serializer/serializer.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Pilot
+{
+    /// Binary archive of the reflected types, the compact counterpart of the PJson text.
+    /// The json written by the generated PSerializer code is encoded against the fields listed by TypeMeta: objects
+    /// of a reflected type store their values in field order without any key, numbers are stored as raw int, float
+    /// or double and strings are length prefixed. The archive starts with a format version and the schema hash of
+    /// the root type, so an archive written before any reflected field changed is rejected instead of misread.
+    class PBinarySerializer
+    {
+    public:
+        // bump when the encoding changes
+        static constexpr uint32_t k_format_version = 1;
+
+        // type_name is the reflected name of T, as given to the REFLECTION_TYPE macro
+        template<typename T>
+        static void write(const T& instance, const std::string& type_name, std::vector<uint8_t>& out_data)
+        {
+            writeJson(PSerializer::write(instance), type_name, out_data);
+        }
+
+        // return false, leaving instance untouched, if the archive is not a valid archive of the current schema
+        template<typename T>
+        static bool read(const uint8_t* data, size_t size, const std::string& type_name, T& instance)
+        {
+            PJson json;
+            if (!readJson(data, size, type_name, json))
+            {
+                return false;
+            }
+            PSerializer::read(json, instance);
+            return true;
+        }
+
+        static void writeJson(const PJson& json, const std::string& type_name, std::vector<uint8_t>& out_data);
+        static bool readJson(const uint8_t* data, size_t size, const std::string& type_name, PJson& out_json);
+
+        // hash of the fields of the type and of the types they hold, 0 if the type is not reflected
+        static uint64_t getSchemaHash(const std::string& type_name);
+    };
+} // namespace Pilot
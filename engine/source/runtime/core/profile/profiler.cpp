@@ -0,0 +1,184 @@
+#include "runtime/core/profile/profiler.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace Pilot
+{
+    std::mutex                                           Profiler::s_buffer_mutex;
+    std::vector<std::shared_ptr<Profiler::ThreadBuffer>> Profiler::s_buffers;
+
+    namespace
+    {
+        void writeJsonString(std::ofstream& out, const std::string& text)
+        {
+            out << '"';
+            for (char c : text)
+            {
+                if (c == '"' || c == '\\')
+                {
+                    out << '\\' << c;
+                }
+                else if (static_cast<unsigned char>(c) >= 0x20)
+                {
+                    out << c;
+                }
+            }
+            out << '"';
+        }
+    } // namespace
+
+    Profiler::ThreadBuffer& Profiler::getThreadBuffer()
+    {
+        // the buffer is shared with the registry so events of a finished thread can still be exported
+        thread_local std::shared_ptr<ThreadBuffer> thread_buffer = [] {
+            std::shared_ptr<ThreadBuffer> buffer = std::make_shared<ThreadBuffer>();
+            buffer->m_events = std::make_unique<EventSlot[]>(k_events_per_thread);
+
+            std::lock_guard<std::mutex> lock(s_buffer_mutex);
+            buffer->m_thread_index = static_cast<uint32_t>(s_buffers.size());
+            buffer->m_thread_name  = "thread " + std::to_string(buffer->m_thread_index);
+            s_buffers.push_back(buffer);
+            return buffer;
+        }();
+        return *thread_buffer;
+    }
+
+    void Profiler::setThreadName(const std::string& thread_name)
+    {
+        ThreadBuffer& buffer = getThreadBuffer();
+
+        std::lock_guard<std::mutex> lock(s_buffer_mutex);
+        buffer.m_thread_name = thread_name;
+    }
+
+    void Profiler::recordEvent(const char* name, uint64_t begin_ns, uint64_t end_ns)
+    {
+        ThreadBuffer&  buffer      = getThreadBuffer();
+        const uint64_t write_count = buffer.m_write_count.load(std::memory_order_relaxed);
+
+        // the fields are not written before the slot is marked as being written
+        EventSlot& slot = buffer.m_events[write_count % k_events_per_thread];
+        slot.m_sequence.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        slot.m_name.store(name, std::memory_order_relaxed);
+        slot.m_begin_ns.store(begin_ns, std::memory_order_relaxed);
+        slot.m_end_ns.store(end_ns, std::memory_order_relaxed);
+
+        slot.m_sequence.store(write_count + 1, std::memory_order_release);
+        buffer.m_write_count.store(write_count + 1, std::memory_order_release);
+    }
+
+    const char* Profiler::internName(const std::string& name)
+    {
+        // most names repeat every frame, look them up without locking first
+        thread_local std::unordered_map<std::string, const char*> thread_names;
+
+        auto iter = thread_names.find(name);
+        if (iter != thread_names.end())
+        {
+            return iter->second;
+        }
+
+        static std::mutex                      s_name_mutex;
+        static std::unordered_set<std::string> s_names;
+
+        const char* interned_name = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(s_name_mutex);
+            interned_name = s_names.insert(name).first->c_str();
+        }
+        thread_names.emplace(name, interned_name);
+        return interned_name;
+    }
+
+    bool Profiler::exportChromeTrace(const std::filesystem::path& trace_path)
+    {
+        std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+        std::vector<std::string>                   thread_names;
+        {
+            std::lock_guard<std::mutex> lock(s_buffer_mutex);
+            buffers = s_buffers;
+            for (const std::shared_ptr<ThreadBuffer>& buffer : buffers)
+            {
+                thread_names.push_back(buffer->m_thread_name);
+            }
+        }
+
+        // copy the events first, the threads keep recording meanwhile
+        std::vector<std::vector<ProfileEvent>> thread_events(buffers.size());
+        uint64_t                               time_origin_ns = std::numeric_limits<uint64_t>::max();
+        for (size_t buffer_index = 0; buffer_index < buffers.size(); ++buffer_index)
+        {
+            const ThreadBuffer& buffer      = *buffers[buffer_index];
+            const uint64_t      end_count   = buffer.m_write_count.load(std::memory_order_acquire);
+            const uint64_t      begin_count = end_count > k_events_per_thread ? end_count - k_events_per_thread : 0;
+
+            std::vector<ProfileEvent>& events = thread_events[buffer_index];
+            events.reserve(static_cast<size_t>(end_count - begin_count));
+            for (uint64_t event_index = begin_count; event_index < end_count; ++event_index)
+            {
+                const EventSlot& slot     = buffer.m_events[event_index % k_events_per_thread];
+                const uint64_t   sequence = slot.m_sequence.load(std::memory_order_acquire);
+                if (sequence != event_index + 1)
+                    continue;
+
+                ProfileEvent event;
+                event.m_name     = slot.m_name.load(std::memory_order_relaxed);
+                event.m_begin_ns = slot.m_begin_ns.load(std::memory_order_relaxed);
+                event.m_end_ns   = slot.m_end_ns.load(std::memory_order_relaxed);
+
+                // drop the event if the owner thread overwrote the slot while it was copied
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.m_sequence.load(std::memory_order_relaxed) == sequence)
+                {
+                    events.push_back(event);
+                }
+            }
+
+            for (const ProfileEvent& event : events)
+            {
+                time_origin_ns = std::min(time_origin_ns, event.m_begin_ns);
+            }
+        }
+
+        std::ofstream trace_file(trace_path);
+        if (!trace_file)
+        {
+            return false;
+        }
+
+        trace_file << std::fixed << std::setprecision(3);
+        trace_file << "{\"traceEvents\":[";
+        bool is_first_event = true;
+        for (size_t buffer_index = 0; buffer_index < buffers.size(); ++buffer_index)
+        {
+            const uint32_t thread_index = buffers[buffer_index]->m_thread_index;
+
+            trace_file << (is_first_event ? "\n" : ",\n");
+            trace_file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << thread_index
+                       << ",\"args\":{\"name\":";
+            writeJsonString(trace_file, thread_names[buffer_index]);
+            trace_file << "}}";
+            is_first_event = false;
+
+            for (const ProfileEvent& event : thread_events[buffer_index])
+            {
+                // chrome trace timestamps are in microseconds
+                trace_file << ",\n{\"name\":";
+                writeJsonString(trace_file, event.m_name);
+                trace_file << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << thread_index
+                           << ",\"ts\":" << (event.m_begin_ns - time_origin_ns) / 1000.0
+                           << ",\"dur\":" << (event.m_end_ns - event.m_begin_ns) / 1000.0 << "}";
+            }
+        }
+        trace_file << "\n]}\n";
+
+        return trace_file.good();
+    }
+} // namespace Pilot
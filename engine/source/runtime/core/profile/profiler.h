@@ -0,0 +1,107 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Pilot
+{
+    struct ProfileEvent
+    {
+        // static string, or a name interned by Profiler::internName
+        const char* m_name {nullptr};
+        uint64_t    m_begin_ns {0};
+        uint64_t    m_end_ns {0};
+    };
+
+    /// CPU profiler recording scoped events into a ring buffer per thread.
+    /// Recording only touches the buffer of the calling thread, so there is no lock and no allocation on the hot
+    /// path. Old events are overwritten once a buffer is full, the export holds the latest ones of every thread and
+    /// drops the ones overwritten while it copied them.
+    class Profiler
+    {
+    public:
+        static constexpr uint32_t k_events_per_thread = 1 << 16;
+
+        // name the calling thread in the exported trace
+        static void setThreadName(const std::string& thread_name);
+
+        static void recordEvent(const char* name, uint64_t begin_ns, uint64_t end_ns);
+
+        // return a pointer valid until exit for a name built at runtime
+        static const char* internName(const std::string& name);
+
+        // write the recorded events in chrome trace event format, open it with chrome://tracing or perfetto
+        static bool exportChromeTrace(const std::filesystem::path& trace_path);
+
+        static uint64_t getTimeNs()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now().time_since_epoch())
+                .count();
+        }
+
+    private:
+        // the owner thread writes a slot while the export reads it, every field is atomic and the sequence tells
+        // the export whether the slot changed during the copy
+        struct EventSlot
+        {
+            // index of the event in the slot plus one, 0 while it is being written
+            std::atomic<uint64_t>    m_sequence {0};
+            std::atomic<const char*> m_name {nullptr};
+            std::atomic<uint64_t>    m_begin_ns {0};
+            std::atomic<uint64_t>    m_end_ns {0};
+        };
+
+        struct ThreadBuffer
+        {
+            uint32_t                     m_thread_index {0};
+            std::string                  m_thread_name;
+            std::unique_ptr<EventSlot[]> m_events;
+            // number of events ever written, only the owner thread writes it
+            std::atomic<uint64_t> m_write_count {0};
+        };
+
+        static ThreadBuffer& getThreadBuffer();
+
+        static std::mutex                                 s_buffer_mutex;
+        static std::vector<std::shared_ptr<ThreadBuffer>> s_buffers;
+    };
+
+    class ProfileScope
+    {
+    public:
+        explicit ProfileScope(const char* name) : m_name(name), m_begin_ns(Profiler::getTimeNs()) {}
+        ~ProfileScope() { Profiler::recordEvent(m_name, m_begin_ns, Profiler::getTimeNs()); }
+
+        ProfileScope(const ProfileScope&) = delete;
+        ProfileScope& operator=(const ProfileScope&) = delete;
+
+    private:
+        const char* m_name;
+        uint64_t    m_begin_ns;
+    };
+} // namespace Pilot
+
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef ENABLE_PROFILER
+// name must be a string literal or any string living until exit
+#define PROFILE_SCOPE(name) Pilot::ProfileScope PROFILE_CONCAT(profile_scope_, __LINE__)(name)
+// name is a std::string built at runtime, it is interned first
+#define PROFILE_SCOPE_DYNAMIC(name) \
+    Pilot::ProfileScope PROFILE_CONCAT(profile_scope_, __LINE__)(Pilot::Profiler::internName(name))
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__FUNCTION__)
+#define PROFILE_THREAD(name) Pilot::Profiler::setThreadName(name)
+#else
+#define PROFILE_SCOPE(name)
+#define PROFILE_SCOPE_DYNAMIC(name)
+#define PROFILE_FUNCTION()
+#define PROFILE_THREAD(name)
+#endif
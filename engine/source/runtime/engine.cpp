@@ -1,7 +1,11 @@
 ﻿#include "runtime/engine.h"
 
+#include "runtime/core/base/frame_allocator.h"
 #include "runtime/core/base/macro.h"
 #include "runtime/core/meta/reflection/reflection_register.h"
+#include "runtime/core/profile/profiler.h"
+
+#include "runtime/resource/config_manager/config_manager.h"
 
 #include "runtime/function/framework/world/world_manager.h"
 #include "runtime/function/global/global_context.h"
@@ -13,11 +17,15 @@
 namespace Pilot
 {
     bool                            g_is_editor_mode {false};
+    bool                            g_is_headless_mode {false};
     std::unordered_set<std::string> g_editor_tick_component_types {};
 
     void PilotEngine::startEngine(const EngineInitParams& param)
     {
-        m_init_params = param;
+        m_init_params      = param;
+        g_is_headless_mode = param.m_is_headless;
+
+        PROFILE_THREAD("main thread");
 
         Reflection::TypeMetaRegister::Register();
 
@@ -40,14 +48,88 @@ namespace Pilot
 
     void PilotEngine::run()
     {
+        if (g_is_headless_mode)
+        {
+            runHeadless();
+            return;
+        }
+
         std::shared_ptr<WindowSystem> window_system = g_runtime_global_context.m_window_system;
         ASSERT(window_system);
 
+        if (g_runtime_global_context.m_config_manager->isRenderThreadEnabled() && !g_is_editor_mode)
+        {
+            startRenderThread();
+        }
+
         while (!window_system->shouldClose())
         {
             const float delta_time = calculateDeltaTime();
             tickOneFrame(delta_time);
         }
+
+        stopRenderThread();
+    }
+
+    void PilotEngine::runHeadless()
+    {
+        using namespace std::chrono;
+
+        const float                  frame_rate = m_init_params.m_headless_frame_rate;
+        const steady_clock::duration frame_duration =
+            frame_rate > 0.f ? duration_cast<steady_clock::duration>(duration<float>(1.f / frame_rate))
+                             : steady_clock::duration::zero();
+
+        steady_clock::time_point next_frame_time_point = steady_clock::now();
+        while (!isQuit())
+        {
+            const float delta_time = calculateDeltaTime();
+            tickOneFrame(delta_time);
+
+            if (frame_duration > steady_clock::duration::zero())
+            {
+                next_frame_time_point += frame_duration;
+                std::this_thread::sleep_until(next_frame_time_point);
+            }
+        }
+    }
+
+    void PilotEngine::startRenderThread()
+    {
+        if (isRenderThreadRunning())
+        {
+            return;
+        }
+
+        g_runtime_global_context.m_render_system->getSwapContext().startFrameHandoff();
+        m_render_thread = std::thread(&PilotEngine::renderThreadMain, this);
+
+        LOG_INFO("render thread start");
+    }
+
+    void PilotEngine::stopRenderThread()
+    {
+        if (!isRenderThreadRunning())
+        {
+            return;
+        }
+
+        g_runtime_global_context.m_render_system->getSwapContext().stopFrameHandoff();
+        m_render_thread.join();
+
+        LOG_INFO("render thread stop");
+    }
+
+    void PilotEngine::renderThreadMain()
+    {
+        PROFILE_THREAD("render thread");
+
+        RenderSwapContext& swap_context = g_runtime_global_context.m_render_system->getSwapContext();
+        while (swap_context.acquireRenderSwapData())
+        {
+            rendererTick();
+            FrameAllocator::resetThreadInstance();
+        }
     }
 
     float PilotEngine::calculateDeltaTime()
@@ -67,19 +149,44 @@ namespace Pilot
 
     bool PilotEngine::tickOneFrame(float delta_time)
     {
+        PROFILE_SCOPE("PilotEngine::tickOneFrame");
+
         logicalTick(delta_time);
         calculateFPS(delta_time);
 
-        // single thread
-        // exchange data between logic and render contexts
-        g_runtime_global_context.m_render_system->swapLogicRenderData();
+        if (g_is_headless_mode)
+        {
+            FrameAllocator::resetThreadInstance();
+            return !isQuit();
+        }
 
-        rendererTick();
+        // GLFW is only touched on the main thread, the render side gets the framebuffer size with the frame
+        g_runtime_global_context.m_render_system->updateFramebufferSize(
+            g_runtime_global_context.m_window_system->getFramebufferSize());
+
+        if (isRenderThreadRunning())
+        {
+            // pipelined
+            // hand this frame over to the render thread, blocks while the render thread is still on the previous one
+            PROFILE_SCOPE("RenderSwapContext::submitLogicSwapData");
+            g_runtime_global_context.m_render_system->getSwapContext().submitLogicSwapData();
+        }
+        else
+        {
+            // single thread
+            // exchange data between logic and render contexts
+            g_runtime_global_context.m_render_system->swapLogicRenderData();
+
+            rendererTick();
+        }
 
 #ifdef ENABLE_PHYSICS_DEBUG_RENDERER
         g_runtime_global_context.m_physics_manager->renderPhysicsWorld(delta_time);
 #endif
 
+        // transient data of this frame is not needed anymore
+        FrameAllocator::resetThreadInstance();
+
         g_runtime_global_context.m_window_system->pollEvents();
 
 
@@ -92,12 +199,19 @@ namespace Pilot
 
     void PilotEngine::logicalTick(float delta_time)
     {
+        PROFILE_SCOPE("PilotEngine::logicalTick");
+
         g_runtime_global_context.m_world_manager->tick(delta_time);
-        g_runtime_global_context.m_input_system->tick();
+        if (g_runtime_global_context.m_input_system)
+        {
+            g_runtime_global_context.m_input_system->tick();
+        }
     }
 
     bool PilotEngine::rendererTick()
     {
+        PROFILE_SCOPE("PilotEngine::rendererTick");
+
         g_runtime_global_context.m_render_system->tick();
         return true;
     }
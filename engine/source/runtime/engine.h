@@ -3,17 +3,24 @@
 #include <atomic>
 #include <chrono>
 #include <filesystem>
+#include <thread>
 #include <unordered_set>
 
 namespace Pilot
 {
     extern bool                            g_is_editor_mode;
+    extern bool                            g_is_headless_mode;
     extern std::unordered_set<std::string> g_editor_tick_component_types;
 
     struct EngineInitParams
     {
         std::filesystem::path m_root_folder;
         std::filesystem::path m_config_file_path;
+
+        // run without window, input and renderer, only the world is ticked
+        bool m_is_headless {false};
+        // frames per second of a headless run, 0 ticks as fast as possible
+        float m_headless_frame_rate {0.f};
     };
 
     class PilotEngine
@@ -29,7 +36,9 @@ namespace Pilot
         void initialize();
         void clear();
 
-        bool isQuit() const { return m_is_quit; }
+        bool isQuit() const { return m_is_quit.load(); }
+        // can be called from any thread, the main loop stops after the current frame
+        void requestQuit() { m_is_quit.store(true); }
         void run();
         bool tickOneFrame(float delta_time);
 
@@ -41,6 +50,18 @@ namespace Pilot
 
         void calculateFPS(float delta_time);
 
+        void runHeadless();
+
+        /**
+         *  Pipelined mode: the render thread renders frame N while the logic thread simulates frame N+1.
+         *  Only used by run(), which PilotLauncher calls. The editor builds its UI inside the render tick, ImGui reads
+         *  GLFW there, so the editor stays single threaded.
+         */
+        void startRenderThread();
+        void stopRenderThread();
+        void renderThreadMain();
+        bool isRenderThreadRunning() const { return m_render_thread.joinable(); }
+
         /**
          *  Each frame can only be called once
          */
@@ -49,13 +70,15 @@ namespace Pilot
     protected:
         EngineInitParams m_init_params;
 
-        bool m_is_quit {false};
+        std::atomic<bool> m_is_quit {false};
 
         std::chrono::steady_clock::time_point m_last_tick_time_point {std::chrono::steady_clock::now()};
 
         float m_average_duration {0.f};
         int   m_frame_count {0};
         int   m_fps {0};
+
+        std::thread m_render_thread;
     };
 
 } // namespace Pilot
@@ -3,30 +3,16 @@
 namespace Pilot
 {
     AnimationFSM::AnimationFSM() {}
-    float tryGetFloat(const json11::Json::object& json, const std::string& key, float default_value)
-    {
-        auto found_iter = json.find(key);
-        if (found_iter != json.end() && found_iter->second.is_number())
-        {
-            return found_iter->second.number_value();
-        }
-        return default_value;
-    }
-    bool tryGetBool(const json11::Json::object& json, const std::string& key, float default_value)
-    {
-        auto found_iter = json.find(key);
-        if (found_iter != json.end() && found_iter->second.is_bool())
-        {
-            return found_iter->second.bool_value();
-        }
-        return default_value;
-    }
-    bool AnimationFSM::update(const json11::Json::object& signals)
+    bool AnimationFSM::update(const AnimationBlackboard& signals)
     {
+        static const BlackboardKey clip_finish_key = AnimationBlackboard::internKey("clip_finish");
+        static const BlackboardKey jumping_key     = AnimationBlackboard::internKey("jumping");
+        static const BlackboardKey speed_key       = AnimationBlackboard::internKey("speed");
+
         States last_state     = m_state;
-        bool   is_clip_finish = tryGetBool(signals, "clip_finish", false);
-        bool   is_jumping     = tryGetBool(signals, "jumping", false);
-        float  speed          = tryGetFloat(signals, "speed", 0);
+        bool   is_clip_finish = signals.getBool(clip_finish_key, false);
+        bool   is_jumping     = signals.getBool(jumping_key, false);
+        float  speed          = signals.getFloat(speed_key, 0);
         bool   is_moving      = speed > 0.01f;
         bool   start_walk_end = false;
 
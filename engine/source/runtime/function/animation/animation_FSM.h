@@ -1,6 +1,8 @@
 #pragma once
+#include "runtime/function/animation/animation_blackboard.h"
+
 #include <functional>
-#include <json11.hpp>
+#include <string>
 #include <vector>
 namespace Pilot
 {
@@ -26,7 +28,7 @@ namespace Pilot
 
     public:
         AnimationFSM();
-        bool        update(const json11::Json::object& signals);
+        bool        update(const AnimationBlackboard& signals);
         std::string getCurrentClipBaseName() const;
     };
 } // namespace Pilot
\ No newline at end of file
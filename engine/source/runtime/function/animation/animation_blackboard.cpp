@@ -0,0 +1,57 @@
+#include "runtime/function/animation/animation_blackboard.h"
+
+#include <mutex>
+#include <unordered_map>
+
+namespace Pilot
+{
+    BlackboardKey AnimationBlackboard::internKey(const std::string& name)
+    {
+        static std::mutex                                     s_key_mutex;
+        static std::unordered_map<std::string, BlackboardKey> s_keys;
+
+        std::lock_guard<std::mutex> lock(s_key_mutex);
+        return s_keys.emplace(name, static_cast<BlackboardKey>(s_keys.size())).first->second;
+    }
+
+    BlackboardValue& AnimationBlackboard::getValue(BlackboardKey key)
+    {
+        if (key >= m_values.size())
+        {
+            m_values.resize(key + 1);
+        }
+        return m_values[key];
+    }
+
+    void AnimationBlackboard::setBool(BlackboardKey key, bool value)
+    {
+        BlackboardValue& entry = getValue(key);
+        entry.m_type           = BlackboardValueType::boolean;
+        entry.m_bool           = value;
+    }
+
+    void AnimationBlackboard::setFloat(BlackboardKey key, float value)
+    {
+        BlackboardValue& entry = getValue(key);
+        entry.m_type           = BlackboardValueType::number;
+        entry.m_number         = value;
+    }
+
+    bool AnimationBlackboard::getBool(BlackboardKey key, bool default_value) const
+    {
+        if (key < m_values.size() && m_values[key].m_type == BlackboardValueType::boolean)
+        {
+            return m_values[key].m_bool;
+        }
+        return default_value;
+    }
+
+    float AnimationBlackboard::getFloat(BlackboardKey key, float default_value) const
+    {
+        if (key < m_values.size() && m_values[key].m_type == BlackboardValueType::number)
+        {
+            return m_values[key].m_number;
+        }
+        return default_value;
+    }
+} // namespace Pilot
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Pilot
+{
+    // interned name of a blackboard entry, the same name gives the same key in every blackboard
+    using BlackboardKey = uint32_t;
+
+    enum class BlackboardValueType : unsigned char
+    {
+        none,
+        boolean,
+        number
+    };
+
+    struct BlackboardValue
+    {
+        BlackboardValueType m_type {BlackboardValueType::none};
+        union
+        {
+            bool  m_bool;
+            float m_number {0.f};
+        };
+    };
+
+    /// Signals read by the animation state machine.
+    /// Values are stored in a flat array indexed by their key, so reading one is an index and a type check.
+    class AnimationBlackboard
+    {
+    public:
+        // intern once and keep the key, the lookup takes a lock
+        static BlackboardKey internKey(const std::string& name);
+
+        void setBool(BlackboardKey key, bool value);
+        void setFloat(BlackboardKey key, float value);
+
+        // default_value if the entry is not set or holds another type
+        bool  getBool(BlackboardKey key, bool default_value) const;
+        float getFloat(BlackboardKey key, float default_value) const;
+
+    private:
+        BlackboardValue& getValue(BlackboardKey key);
+
+        std::vector<BlackboardValue> m_values;
+    };
+} // namespace Pilot
@@ -5,124 +5,102 @@
 #include "runtime/function/animation/animation_loader.h"
 #include "runtime/function/animation/skeleton.h"
 
+#include <mutex>
+
 namespace Pilot
 {
     std::map<std::string, std::shared_ptr<SkeletonData>>  AnimationManager::m_skeleton_definition_cache;
     std::map<std::string, std::shared_ptr<AnimationClip>> AnimationManager::m_animation_data_cache;
     std::map<std::string, std::shared_ptr<AnimSkelMap>>   AnimationManager::m_animation_skeleton_map_cache;
     std::map<std::string, std::shared_ptr<BoneBlendMask>> AnimationManager::m_skeleton_mask_cache;
+    std::shared_mutex                                     AnimationManager::m_cache_mutex;
 
-    std::shared_ptr<SkeletonData> AnimationManager::tryLoadSkeleton(std::string file_path)
+    namespace
     {
-        std::shared_ptr<SkeletonData> res;
-        AnimationLoader               loader;
-        auto                          found = m_skeleton_definition_cache.find(file_path);
-        if (found == m_skeleton_definition_cache.end())
+        // the caches are read by components ticking in parallel, loading happens outside of the lock and the first
+        // inserted result wins
+        template<typename TData, typename TLoadFunc>
+        std::shared_ptr<TData> tryLoadCached(std::map<std::string, std::shared_ptr<TData>>& cache,
+                                             std::shared_mutex&                             cache_mutex,
+                                             const std::string&                             file_path,
+                                             TLoadFunc&&                                    load_func)
         {
-            res = loader.loadSkeletonData(file_path);
-            m_skeleton_definition_cache.emplace(file_path, res);
-        }
-        else
-        {
-            res = found->second;
+            {
+                std::shared_lock<std::shared_mutex> lock(cache_mutex);
+                auto                                found = cache.find(file_path);
+                if (found != cache.end())
+                {
+                    return found->second;
+                }
+            }
+
+            std::shared_ptr<TData> res = load_func(file_path);
+
+            std::unique_lock<std::shared_mutex> lock(cache_mutex);
+            return cache.emplace(file_path, res).first->second;
         }
-        return res;
+    } // namespace
+
+    std::shared_ptr<SkeletonData> AnimationManager::tryLoadSkeleton(std::string file_path)
+    {
+        return tryLoadCached(m_skeleton_definition_cache, m_cache_mutex, file_path, [](const std::string& path) {
+            AnimationLoader loader;
+            return loader.loadSkeletonData(path);
+        });
     }
 
     std::shared_ptr<AnimationClip> AnimationManager::tryLoadAnimation(std::string file_path)
     {
-        std::shared_ptr<AnimationClip> res;
-        AnimationLoader                loader;
-        auto                           found = m_animation_data_cache.find(file_path);
-        if (found == m_animation_data_cache.end())
-        {
-            res = loader.loadAnimationClipData(file_path);
-            m_animation_data_cache.emplace(file_path, res);
-        }
-        else
-        {
-            res = found->second;
-        }
-        return res;
+        return tryLoadCached(m_animation_data_cache, m_cache_mutex, file_path, [](const std::string& path) {
+            AnimationLoader loader;
+            return loader.loadAnimationClipData(path);
+        });
     }
 
     std::shared_ptr<AnimSkelMap> AnimationManager::tryLoadAnimationSkeletonMap(std::string file_path)
     {
-        std::shared_ptr<AnimSkelMap> res;
-        AnimationLoader              loader;
-        auto                         found = m_animation_skeleton_map_cache.find(file_path);
-        if (found == m_animation_skeleton_map_cache.end())
-        {
-            res = loader.loadAnimSkelMap(file_path);
-            m_animation_skeleton_map_cache.emplace(file_path, res);
-        }
-        else
-        {
-            res = found->second;
-        }
-        return res;
+        return tryLoadCached(m_animation_skeleton_map_cache, m_cache_mutex, file_path, [](const std::string& path) {
+            AnimationLoader loader;
+            return loader.loadAnimSkelMap(path);
+        });
     }
 
     std::shared_ptr<BoneBlendMask> AnimationManager::tryLoadSkeletonMask(std::string file_path)
     {
-        std::shared_ptr<BoneBlendMask> res;
-        AnimationLoader                loader;
-        auto                           found = m_skeleton_mask_cache.find(file_path);
-        if (found == m_skeleton_mask_cache.end())
-        {
-            res = loader.loadSkeletonMask(file_path);
-            m_skeleton_mask_cache.emplace(file_path, res);
-        }
-        else
-        {
-            res = found->second;
-        }
-        return res;
+        return tryLoadCached(m_skeleton_mask_cache, m_cache_mutex, file_path, [](const std::string& path) {
+            AnimationLoader loader;
+            return loader.loadSkeletonMask(path);
+        });
     }
     ClipData AnimationManager::getClipData(const BasicClip& basic_clip) {
-        tryLoadAnimation(basic_clip.m_clip_file_path);
-        tryLoadAnimationSkeletonMap(basic_clip.m_anim_skel_map_path);
-
         ClipData clip_data;
-        clip_data.m_clip= *m_animation_data_cache[basic_clip.m_clip_file_path];
-        clip_data.m_anim_skel_map = *m_animation_skeleton_map_cache[basic_clip.m_anim_skel_map_path];
+        clip_data.m_clip          = *tryLoadAnimation(basic_clip.m_clip_file_path);
+        clip_data.m_anim_skel_map = *tryLoadAnimationSkeletonMap(basic_clip.m_anim_skel_map_path);
         return clip_data;
     }
 
-    BlendStateWithClipData AnimationManager::getBlendStateWithClipData(const BlendState& blend_state)
+    BlendStateWithClipData AnimationManager::getBlendStateWithClipData(const BlendState&         blend_state,
+                                                                       const std::vector<float>& blend_weights,
+                                                                       float                     blend_ratio)
     {
-
-        for (auto animation_file_path : blend_state.m_blend_clip_file_path)
-        {
-            tryLoadAnimation(animation_file_path);
-        }
-        for (auto anim_skel_map_path : blend_state.m_blend_anim_skel_map_path)
-        {
-            tryLoadAnimationSkeletonMap(anim_skel_map_path);
-        }
-        for (auto skeleton_mask_path : blend_state.m_blend_mask_file_path)
-        {
-            tryLoadSkeletonMask(skeleton_mask_path);
-        }
-
         BlendStateWithClipData blend_state_with_clip_data;
-        blend_state_with_clip_data.m_clip_count  = blend_state.m_clip_count;
-        blend_state_with_clip_data.m_blend_ratio = blend_state.m_blend_ratio;
+        blend_state_with_clip_data.m_clip_count = blend_state.m_clip_count;
+        blend_state_with_clip_data.m_blend_ratio.assign(blend_state.m_clip_count, blend_ratio);
         for (const auto& iter : blend_state.m_blend_clip_file_path)
         {
-            blend_state_with_clip_data.m_blend_clip.push_back(*m_animation_data_cache[iter]);
+            blend_state_with_clip_data.m_blend_clip.push_back(*tryLoadAnimation(iter));
         }
         for (const auto& iter : blend_state.m_blend_anim_skel_map_path)
         {
-            blend_state_with_clip_data.m_blend_anim_skel_map.push_back(*m_animation_skeleton_map_cache[iter]);
+            blend_state_with_clip_data.m_blend_anim_skel_map.push_back(*tryLoadAnimationSkeletonMap(iter));
         }
         std::vector<std::shared_ptr<BoneBlendMask>> blend_masks;
         for (auto& iter : blend_state.m_blend_mask_file_path)
         {
-            blend_masks.push_back(m_skeleton_mask_cache[iter]);
-            tryLoadAnimationSkeletonMap(m_skeleton_mask_cache[iter]->skeleton_file_path);
+            blend_masks.push_back(tryLoadSkeletonMask(iter));
+            tryLoadAnimationSkeletonMap(blend_masks.back()->skeleton_file_path);
         }
-        size_t skeleton_bone_count = m_skeleton_definition_cache[blend_masks[0]->skeleton_file_path]->bones_map.size();
+        size_t skeleton_bone_count = tryLoadSkeleton(blend_masks[0]->skeleton_file_path)->bones_map.size();
         blend_state_with_clip_data.m_blend_weight.resize(blend_state.m_clip_count);
         for (size_t clip_index = 0; clip_index < blend_state.m_clip_count; clip_index++)
         {
@@ -135,7 +113,7 @@ namespace Pilot
             {
                 if (blend_masks[clip_index]->enabled[bone_index])
                 {
-                    sum_weight += blend_state.m_blend_weight[clip_index];
+                    sum_weight += blend_weights[clip_index];
                 }
             }
             if (fabs(sum_weight) < 0.0001f)
@@ -148,7 +126,7 @@ namespace Pilot
                 {
 
                     blend_state_with_clip_data.m_blend_weight[clip_index].m_blend_weight[bone_index] =
-                        blend_state.m_blend_weight[clip_index] / sum_weight;
+                        blend_weights[clip_index] / sum_weight;
                 }
                 else
                 {
@@ -8,6 +8,7 @@
 
 #include <map>
 #include <memory>
+#include <shared_mutex>
 #include <string>
 
 namespace Pilot
@@ -19,6 +20,7 @@ namespace Pilot
         static std::map<std::string, std::shared_ptr<AnimationClip>> m_animation_data_cache;
         static std::map<std::string, std::shared_ptr<AnimSkelMap>>   m_animation_skeleton_map_cache;
         static std::map<std::string, std::shared_ptr<BoneBlendMask>> m_skeleton_mask_cache;
+        static std::shared_mutex                                     m_cache_mutex;
 
     public:
         static std::shared_ptr<SkeletonData>  tryLoadSkeleton(std::string file_path);
@@ -26,7 +28,10 @@ namespace Pilot
         static std::shared_ptr<AnimSkelMap>   tryLoadAnimationSkeletonMap(std::string file_path);
         static std::shared_ptr<BoneBlendMask> tryLoadSkeletonMask(std::string file_path);
         static ClipData                       getClipData(const BasicClip& basic_clip);
-        static BlendStateWithClipData         getBlendStateWithClipData(const BlendState& blend_state);
+        // the weights and the ratio are the ones being played, not the ones saved in the blend state
+        static BlendStateWithClipData getBlendStateWithClipData(const BlendState&         blend_state,
+                                                                const std::vector<float>& blend_weights,
+                                                                float                     blend_ratio);
 
         AnimationManager() = default;
     };
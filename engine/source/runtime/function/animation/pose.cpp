@@ -6,14 +6,7 @@ AnimationPose::AnimationPose() { m_reorder = false; }
 
 AnimationPose::AnimationPose(const AnimationClip& clip, float ratio, const AnimSkelMap& animSkelMap)
 {
-    m_bone_indexs = animSkelMap.convert;
-    m_reorder     = true;
-    extractFromClip(m_bone_poses, clip, ratio);
-    m_weight.m_blend_weight.resize(m_bone_poses.size());
-    for (auto& weight : m_weight.m_blend_weight)
-    {
-        weight = 1.f;
-    }
+    extract(clip, ratio, animSkelMap);
 }
 AnimationPose::AnimationPose(const AnimationClip& clip, const BoneBlendWeight& weight, float ratio)
 {
@@ -25,6 +18,22 @@ AnimationPose::AnimationPose(const AnimationClip&   clip,
                              const BoneBlendWeight& weight,
                              float                  ratio,
                              const AnimSkelMap&     animSkelMap)
+{
+    extract(clip, weight, ratio, animSkelMap);
+}
+
+void AnimationPose::extract(const AnimationClip& clip, float ratio, const AnimSkelMap& animSkelMap)
+{
+    m_bone_indexs = animSkelMap.convert;
+    m_reorder     = true;
+    extractFromClip(m_bone_poses, clip, ratio);
+    m_weight.m_blend_weight.assign(m_bone_poses.size(), 1.f);
+}
+
+void AnimationPose::extract(const AnimationClip&   clip,
+                            const BoneBlendWeight& weight,
+                            float                  ratio,
+                            const AnimSkelMap&     animSkelMap)
 {
     m_weight      = weight;
     m_bone_indexs = animSkelMap.convert;
@@ -16,6 +16,12 @@ namespace Pilot
         AnimationPose(const AnimationClip& clip, float ratio, const AnimSkelMap& animSkelMap);
         AnimationPose(const AnimationClip& clip, const BoneBlendWeight& weight, float ratio);
         AnimationPose(const AnimationClip& clip, const BoneBlendWeight& weight, float ratio, const AnimSkelMap& animSkelMap);
+        // same as the constructors, the arrays keep their capacity so that a pose can be reused every frame
+        void extract(const AnimationClip& clip, float ratio, const AnimSkelMap& animSkelMap);
+        void extract(const AnimationClip&   clip,
+                     const BoneBlendWeight& weight,
+                     float                  ratio,
+                     const AnimSkelMap&     animSkelMap);
         void blend(const AnimationPose& pose);
     };
 } // namespace Pilot
@@ -173,6 +173,29 @@ namespace Pilot
         }
     }
 
+    int32_t Skeleton::getBoneIndex(const std::string& bone_name) const
+    {
+        for (int32_t i = 0; i < m_bone_count; i++)
+        {
+            if (m_bones[i].getName() == bone_name)
+            {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    Matrix4x4 Skeleton::getBoneModelMatrix(int32_t bone_index) const
+    {
+        if (bone_index < 0 || bone_index >= m_bone_count)
+        {
+            return Matrix4x4::IDENTITY;
+        }
+        const Bone& bone = m_bones[bone_index];
+        return Transform(bone._getDerivedPosition(), bone._getDerivedOrientation(), bone._getDerivedScale())
+            .getMatrix();
+    }
+
     AnimationResult Skeleton::outputAnimationResult()
     {
         AnimationResult animation_result;
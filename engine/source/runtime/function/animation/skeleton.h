@@ -27,5 +27,10 @@ namespace Pilot
         void            applyAnimation(const BlendStateWithClipData& blend_state);
         AnimationResult outputAnimationResult();
         void            resetSkeleton();
+
+        // -1 if there is no bone of this name
+        int32_t getBoneIndex(const std::string& bone_name) const;
+        // transform of the bone in the space of the skeleton, as posed by the last update
+        Matrix4x4 getBoneModelMatrix(int32_t bone_index) const;
     };
 } // namespace Pilot
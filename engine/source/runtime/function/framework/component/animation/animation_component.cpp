@@ -13,24 +13,31 @@ namespace Pilot
         auto skeleton_res = AnimationManager::tryLoadSkeleton(m_animation_res.m_skeleton_file_path);
 
         m_skeleton.buildSkeleton(*skeleton_res);
+
+        // the blend spaces read the blackboard every tick, their keys are interned once
+        m_blend_keys.clear();
+        m_blend_weights.clear();
+        for (auto& clip : m_animation_res.m_clips)
+        {
+            m_blend_keys.push_back(clip.getTypeName() == "BlendSpace1D" ?
+                                       AnimationBlackboard::internKey(static_cast<BlendSpace1D*>(clip)->m_key) :
+                                       0);
+
+            const bool is_blend_state = clip.getTypeName() == "BlendState" || clip.getTypeName() == "BlendSpace1D";
+            m_blend_weights.push_back(is_blend_state ? static_cast<BlendState*>(clip)->m_blend_weight :
+                                                       std::vector<float>());
+        }
     }
 
-    void AnimationComponent::blend1D(float desired_ratio, BlendSpace1D* blend_state)
+    void AnimationComponent::blend1D(float desired_ratio, const BlendSpace1D* blend_state, size_t clip_index)
     {
         if (blend_state->m_values.size() < 2)
         {
             // no need to interpolate
             return;
         }
-        const auto& key_it    = m_signal.find(blend_state->m_key);
-        double      key_value = 0;
-        if (key_it != m_signal.end())
-        {
-            if (key_it->second.is_number())
-            {
-                key_value = key_it->second.number_value();
-            }
-        }
+        double              key_value     = m_signal.getFloat(m_blend_keys[clip_index], 0);
+        std::vector<float>& blend_weights = m_blend_weights[clip_index];
         int max_smaller = -1;
         for (auto value : blend_state->m_values)
         {
@@ -44,17 +51,17 @@ namespace Pilot
             }
         }
 
-        for (auto& weight : blend_state->m_blend_weight)
+        for (auto& weight : blend_weights)
         {
             weight = 0;
         }
         if (max_smaller == -1)
         {
-            blend_state->m_blend_weight[0] = 1.0f;
+            blend_weights[0] = 1.0f;
         }
         else if (max_smaller == blend_state->m_values.size() - 1)
         {
-            blend_state->m_blend_weight[max_smaller] = 1.0f;
+            blend_weights[max_smaller] = 1.0f;
         }
         else
         {
@@ -68,31 +75,37 @@ namespace Pilot
 
             float weight = (key_value - l) / (r - l);
 
-            blend_state->m_blend_weight[max_smaller + 1] = weight;
-            blend_state->m_blend_weight[max_smaller]     = 1 - weight;
+            blend_weights[max_smaller + 1] = weight;
+            blend_weights[max_smaller]     = 1 - weight;
         }
-        blend(desired_ratio, blend_state);
+        blend(desired_ratio, blend_state, blend_weights);
     }
     void AnimationComponent::tick(float delta_time)
     {
         if ((m_tick_in_editor_mode == false) && g_is_editor_mode)
             return;
+        static const BlackboardKey clip_finish_key = AnimationBlackboard::internKey("clip_finish");
+
         std::string name = m_animation_fsm.getCurrentClipBaseName();
-        for (auto blend_state : m_animation_res.m_clips)
+        for (size_t clip_index = 0; clip_index < m_animation_res.m_clips.size(); ++clip_index)
         {
+            auto blend_state = m_animation_res.m_clips[clip_index];
             if (blend_state->m_name == name)
             {
-                float length        = blend_state->getLength();
+                // a blend being played is as long as its current weights say
+                float length        = m_blend_weights[clip_index].empty() ?
+                                          blend_state->getLength() :
+                                          static_cast<BlendState*>(blend_state)->getLength(m_blend_weights[clip_index]);
                 float delta_ratio   = delta_time / length;
                 float desired_ratio = delta_ratio + m_ratio;
                 if (desired_ratio >= 1.f)
                 {
                     desired_ratio = desired_ratio - floor(desired_ratio);
-                    updateSignal("clip_finish", true);
+                    updateSignal(clip_finish_key, true);
                 }
                 else
                 {
-                    updateSignal("clip_finish", false);
+                    updateSignal(clip_finish_key, false);
                 }
                 bool restart = m_animation_fsm.update(m_signal);
                 if (!restart)
@@ -108,19 +121,20 @@ namespace Pilot
         }
 
         name = m_animation_fsm.getCurrentClipBaseName();
-        for (auto clip : m_animation_res.m_clips)
+        for (size_t clip_index = 0; clip_index < m_animation_res.m_clips.size(); ++clip_index)
         {
+            auto clip = m_animation_res.m_clips[clip_index];
             if (clip->m_name == name)
             {
                 if (clip.getTypeName() == "BlendSpace1D")
                 {
                     auto blend_state_1d_pre = static_cast<BlendSpace1D*>(clip);
-                    blend1D(m_ratio, blend_state_1d_pre);
+                    blend1D(m_ratio, blend_state_1d_pre, clip_index);
                 }
                 else if (clip.getTypeName() == "BlendState")
                 {
                     auto blend_state = static_cast<BlendState*>(clip);
-                    blend(m_ratio, blend_state);
+                    blend(m_ratio, blend_state, m_blend_weights[clip_index]);
                 }
                 else if (clip.getTypeName() == "BasicClip")
                 {
@@ -138,7 +152,9 @@ namespace Pilot
     {
         auto clip_data = AnimationManager::getClipData(*basic_clip);
 
-        AnimationPose pose(clip_data.m_clip, desired_ratio, clip_data.m_anim_skel_map);
+        m_poses.resize(1);
+        AnimationPose& pose = m_poses[0];
+        pose.extract(clip_data.m_clip, desired_ratio, clip_data.m_anim_skel_map);
         m_skeleton.resetSkeleton();
         m_skeleton.applyAdditivePose(pose);
         m_skeleton.extractPose(pose);
@@ -146,31 +162,31 @@ namespace Pilot
         m_skeleton.applyPose(pose);
         m_animation_result = m_skeleton.outputAnimationResult();
     }
-    void AnimationComponent::blend(float desired_ratio, BlendState* blend_state)
+    void AnimationComponent::blend(float                     desired_ratio,
+                                   const BlendState*         blend_state,
+                                   const std::vector<float>& blend_weights)
     {
-
-        for (auto& ratio : blend_state->m_blend_ratio)
-        {
-            ratio = desired_ratio;
-        }
-        auto                       blendStateData = AnimationManager::getBlendStateWithClipData(*blend_state);
-        std::vector<AnimationPose> poses;
+        // the ratio and the weights being played are not written to the clip, the saved fields do not change
+        auto blendStateData = AnimationManager::getBlendStateWithClipData(*blend_state, blend_weights, desired_ratio);
+        // the poses of the last tick are overwritten in place
+        std::vector<AnimationPose>& poses = m_poses;
+        poses.resize(blendStateData.m_clip_count);
         for (int i = 0; i < blendStateData.m_clip_count; i++)
         {
-            AnimationPose pose(blendStateData.m_blend_clip[i],
-                               blendStateData.m_blend_weight[i],
-                               blendStateData.m_blend_ratio[i],
-                               blendStateData.m_blend_anim_skel_map[i]);
+            AnimationPose& pose = poses[i];
+            pose.extract(blendStateData.m_blend_clip[i],
+                         blendStateData.m_blend_weight[i],
+                         blendStateData.m_blend_ratio[i],
+                         blendStateData.m_blend_anim_skel_map[i]);
             m_skeleton.resetSkeleton();
             m_skeleton.applyAdditivePose(pose);
             m_skeleton.extractPose(pose);
-            poses.push_back(pose);
         }
         for (int i = 1; i < blendStateData.m_clip_count; i++)
         {
             for (auto& pose : poses[i].m_weight.m_blend_weight)
             {
-                pose = blend_state->m_blend_weight[i];
+                pose = blend_weights[i];
             }
             poses[0].blend(poses[i]);
         }
@@ -5,7 +5,9 @@
 #include "runtime/function/framework/component/component.h"
 #include "runtime/resource/res_type/components/animation.h"
 #include "runtime/function/animation/animation_FSM.h"
-#include "json11.hpp"
+#include "runtime/function/animation/animation_blackboard.h"
+
+#include <vector>
 namespace Pilot
 {
     REFLECTION_TYPE(AnimationComponent)
@@ -19,25 +21,34 @@ namespace Pilot
         void postLoadResource(std::weak_ptr<GObject> parent_object) override;
 
         void tick(float delta_time) override;
+        bool canTickConcurrently() const override { return true; }
 
         const AnimationResult& getResult() const;
+        const Skeleton&        getSkeleton() const { return m_skeleton; }
         void                   animateBasicClip(float ratio, BasicClip* basic_clip);
-        void                   blend(float desired_ratio, BlendState* blend_state);
-        void                   blend1D(float desired_ratio, BlendSpace1D* blend_state);
-        template<typename T>
-        void updateSignal(const std::string& key, const T& value)
-        {
-            m_signal[key] = value;
-        }
+        void blend(float desired_ratio, const BlendState* blend_state, const std::vector<float>& blend_weights);
+        // clip_index is the index of blend_state in the clips of the animation resource
+        void blend1D(float desired_ratio, const BlendSpace1D* blend_state, size_t clip_index);
+        // key from AnimationBlackboard::internKey
+        void updateSignal(BlackboardKey key, bool value) { m_signal.setBool(key, value); }
+        void updateSignal(BlackboardKey key, float value) { m_signal.setFloat(key, value); }
 
     protected:
         META(Enable)
         AnimationComponentRes m_animation_res;
 
-        Skeleton m_skeleton;
-        AnimationResult       m_animation_result;
-        AnimationFSM          m_animation_fsm;
-        json11::Json::object  m_signal;
-        float                 m_ratio {0};
+        Skeleton            m_skeleton;
+        AnimationResult     m_animation_result;
+        AnimationFSM        m_animation_fsm;
+        AnimationBlackboard m_signal;
+        float               m_ratio {0};
+
+        // key of every BlendSpace1D clip, in the order of m_animation_res.m_clips
+        std::vector<BlackboardKey> m_blend_keys;
+        // weights of every BlendState clip being played, in the order of m_animation_res.m_clips. They change while
+        // playing, so they are kept out of the saved clips
+        std::vector<std::vector<float>> m_blend_weights;
+        // poses of the clips being blended, reused every tick
+        std::vector<AnimationPose> m_poses;
     };
 } // namespace Pilot
@@ -3,6 +3,8 @@
 #include "runtime/core/base/macro.h"
 #include "runtime/core/math/math_headers.h"
 
+#include "runtime/engine.h"
+
 #include "runtime/function/character/character.h"
 #include "runtime/function/framework/component/transform/transform_component.h"
 #include "runtime/function/framework/level/level.h"
@@ -39,15 +41,12 @@ namespace Pilot
             LOG_ERROR("invalid camera type");
         }
 
-        RenderSwapContext& swap_context = g_runtime_global_context.m_render_system->getSwapContext();
-        CameraSwapData     camera_swap_data;
-        camera_swap_data.m_fov_x                           = m_camera_res.m_parameter->m_fov;
-        swap_context.getLogicSwapData().m_camera_swap_data = camera_swap_data;
+        m_is_fov_dirty = true;
     }
 
     void CameraComponent::tick(float delta_time)
     {
-        if (!m_parent_object.lock())
+        if (!m_parent_object.lock() || g_is_headless_mode)
             return;
 
         std::shared_ptr<Level> current_level = g_runtime_global_context.m_world_manager->getCurrentActiveLevel().lock();
@@ -71,6 +70,23 @@ namespace Pilot
             default:
                 break;
         }
+
+        if (m_is_fov_dirty)
+        {
+            RenderSwapContext&             swap_context     = g_runtime_global_context.m_render_system->getSwapContext();
+            std::optional<CameraSwapData>& camera_swap_data = swap_context.getLogicSwapData().m_camera_swap_data;
+            if (!camera_swap_data.has_value())
+            {
+                camera_swap_data.emplace();
+            }
+            camera_swap_data->m_fov_x = m_camera_res.m_parameter->m_fov;
+
+            // keep the logic side copy in step, the render camera only changes fov x
+            std::shared_ptr<InputSystem> input_system = g_runtime_global_context.m_input_system;
+            input_system->setCameraFOV(Vector2(*camera_swap_data->m_fov_x, input_system->getCameraFOV().y));
+
+            m_is_fov_dirty = false;
+        }
     }
 
     void CameraComponent::tickFirstPersonCamera(float delta_time)
@@ -121,7 +137,13 @@ namespace Pilot
         q_yaw.fromAngleAxis(g_runtime_global_context.m_input_system->m_cursor_delta_yaw, Vector3::UNIT_Z);
         q_pitch.fromAngleAxis(g_runtime_global_context.m_input_system->m_cursor_delta_pitch, Vector3::UNIT_X);
 
-        param->m_cursor_pitch = q_pitch * param->m_cursor_pitch;
+        // the pitch is a saved field
+        const Quaternion cursor_pitch = q_pitch * param->m_cursor_pitch;
+        if (cursor_pitch != param->m_cursor_pitch)
+        {
+            param->m_cursor_pitch = cursor_pitch;
+            markSaveDirty();
+        }
 
         const float vertical_offset   = param->m_vertical_offset;
         const float horizontal_offset = param->m_horizontal_offset;
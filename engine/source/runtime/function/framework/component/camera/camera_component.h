@@ -29,6 +29,8 @@ namespace Pilot
         void postLoadResource(std::weak_ptr<GObject> parent_object) override;
 
         void tick(float delta_time) override;
+        // follow the character once it moved
+        ComponentTickGroup getTickGroup() const override { return ComponentTickGroup::late; }
 
     private:
         void tickFirstPersonCamera(float delta_time);
@@ -43,5 +45,8 @@ namespace Pilot
         Vector3 m_foward {Vector3::NEGATIVE_UNIT_Y};
         Vector3 m_up {Vector3::UNIT_Z};
         Vector3 m_left {Vector3::UNIT_X};
+
+        // the fov is sent once the camera drives the view, not on load, levels can stream in the background
+        bool m_is_fov_dirty {true};
     };
 } // namespace Pilot
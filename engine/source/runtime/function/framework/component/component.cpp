@@ -0,0 +1,27 @@
+#include "runtime/function/framework/component/component.h"
+
+#include "runtime/function/framework/component/component_store.h"
+#include "runtime/function/framework/component/component_tick_scheduler.h"
+
+namespace Pilot
+{
+    void Component::operator delete(void* pointer)
+    {
+        if (!ComponentPoolBase::freePooledSlot(pointer))
+        {
+            ::operator delete(pointer);
+        }
+    }
+
+    void Component::setDormant(bool is_dormant)
+    {
+        if (m_is_dormant == is_dormant)
+            return;
+
+        m_is_dormant = is_dormant;
+        if (m_tick_scheduler)
+        {
+            m_tick_scheduler->requestUpdate(*this);
+        }
+    }
+} // namespace Pilot
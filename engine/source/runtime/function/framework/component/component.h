@@ -3,30 +3,87 @@
 
 namespace Pilot
 {
+    class AxisAlignedBox;
     class GObject;
+    class ComponentPoolBase;
+    class ComponentTickScheduler;
+
+    // when a component ticks within the frame of its level
+    enum class ComponentTickGroup : unsigned char
+    {
+        pre_physics,
+        post_physics,
+        late,
+        count
+    };
+
     // Component
     REFLECTION_TYPE(Component)
     CLASS(Component, WhiteListFields)
     {
         REFLECTION_BODY(Component)
+        friend class ComponentPoolBase;
+        friend class ComponentTickScheduler;
+
     protected:
         std::weak_ptr<GObject> m_parent_object;
         bool     m_is_dirty {false};
+        bool     m_is_save_dirty {true};
 
     public:
         Component() = default;
         virtual ~Component() {}
 
+        // a pooled component lives in the memory of its ComponentPool, deleting it gives the slot back to the pool
+        // instead of freeing it, so PILOT_REFLECTION_DELETE is safe on any component
+        static void operator delete(void* pointer);
+
         // Instantiating the component after definition loaded
         virtual void postLoadResource(std::weak_ptr<GObject> parent_object) { m_parent_object = parent_object;}
 
         virtual void tick(float delta_time) {};
 
+        // the reflected fields were overwritten by a LevelSnapshot, refresh the state derived from them
+        virtual void postRestoreState() {}
+
+        // true if tick() only touches this component, its own object and thread-safe systems, so objects made of such
+        // components can be ticked on worker threads
+        virtual bool canTickConcurrently() const { return false; }
+
+        virtual ComponentTickGroup getTickGroup() const { return ComponentTickGroup::pre_physics; }
+
+        // bounds in object space used by the spatial index of the level, false if the component has no extent
+        virtual bool getLocalBounds(AxisAlignedBox& out_bounds) const { return false; }
+
+        // a dormant component is skipped by its level until it is woken up, it costs nothing per frame
+        // call it from the thread ticking the object, the change applies from the next tick group
+        void setDormant(bool is_dormant);
+        bool isDormant() const { return m_is_dormant; }
+        // true if the component has to tick when the world matrix of its object changes, it is woken up then
+        virtual bool isWokenByTransform() const { return false; }
+
         bool isDirty() const { return m_is_dirty; }
 
         void setDirtyFlag(bool is_dirty) { m_is_dirty = is_dirty; }
 
+        // the saved fields changed since the level last serialized the object
+        // a component writing its reflected fields at runtime calls markSaveDirty(). A change it misses is still
+        // saved, the level also compares a hash of the reflected fields before reusing the json of an object
+        bool isSaveDirty() const { return m_is_save_dirty; }
+        void markSaveDirty() { m_is_save_dirty = true; }
+        void clearSaveDirty() { m_is_save_dirty = false; }
+
+        // true if the component lives in a ComponentPool, it is ticked by the pool instead of its object
+        bool isPooled() const { return m_is_pooled; }
+
         bool m_tick_in_editor_mode {false};
+
+    private:
+        bool m_is_pooled {false};
+
+        // set while the component is registered to the tick scheduler of its level
+        ComponentTickScheduler* m_tick_scheduler {nullptr};
+        bool                    m_is_dormant {false};
     };
 
 } // namespace Pilot
@@ -0,0 +1,116 @@
+#include "runtime/function/framework/component/component_store.h"
+
+#include "runtime/core/base/macro.h"
+#include "runtime/core/profile/profiler.h"
+
+#include "runtime/resource/config_manager/config_manager.h"
+
+#include "runtime/engine.h"
+#include "runtime/function/global/global_context.h"
+
+#include <map>
+#include <mutex>
+
+namespace Pilot
+{
+    namespace
+    {
+        struct PooledChunk
+        {
+            const unsigned char* m_end {nullptr};
+            ComponentPoolBase*   m_pool {nullptr};
+            size_t               m_chunk_index {0};
+        };
+
+        // chunks of every pool by the address of their memory, the levels load on worker threads
+        std::mutex                                  g_pooled_chunk_mutex;
+        std::map<const unsigned char*, PooledChunk> g_pooled_chunks;
+    } // namespace
+
+    bool ComponentPoolBase::freePooledSlot(void* pointer)
+    {
+        const unsigned char* address = static_cast<const unsigned char*>(pointer);
+
+        ComponentPoolBase* pool        = nullptr;
+        size_t             chunk_index = 0;
+        {
+            std::lock_guard<std::mutex> lock(g_pooled_chunk_mutex);
+
+            auto iter = g_pooled_chunks.upper_bound(address);
+            if (iter == g_pooled_chunks.begin())
+                return false;
+            --iter;
+            if (address >= iter->second.m_end)
+                return false;
+
+            pool        = iter->second.m_pool;
+            chunk_index = iter->second.m_chunk_index;
+        }
+
+        pool->freeSlot(chunk_index, pointer);
+        return true;
+    }
+
+    void ComponentPoolBase::registerChunk(const void* storage, size_t byte_size, size_t chunk_index)
+    {
+        const unsigned char* begin = static_cast<const unsigned char*>(storage);
+
+        std::lock_guard<std::mutex> lock(g_pooled_chunk_mutex);
+        g_pooled_chunks[begin] = {begin + byte_size, this, chunk_index};
+    }
+
+    void ComponentPoolBase::unregisterChunk(const void* storage)
+    {
+        std::lock_guard<std::mutex> lock(g_pooled_chunk_mutex);
+        g_pooled_chunks.erase(static_cast<const unsigned char*>(storage));
+    }
+
+    void ComponentStore::adoptComponents(std::vector<Reflection::ReflectionPtr<Component>>& components)
+    {
+        for (Reflection::ReflectionPtr<Component>& component : components)
+        {
+            if (!component || component->isPooled())
+            {
+                continue;
+            }
+
+            ComponentPoolBase* pool = findPool(component.getTypeName());
+            if (pool)
+            {
+                pool->adopt(component);
+            }
+        }
+    }
+
+    void ComponentStore::tick(float delta_time)
+    {
+        JobSystem* job_system = g_runtime_global_context.m_config_manager->isParallelTickEnabled() ?
+                                    g_runtime_global_context.m_job_system.get() :
+                                    nullptr;
+
+        for (const std::unique_ptr<ComponentPoolBase>& pool : m_pools)
+        {
+            // same rule as ComponentTickScheduler::tickEntries
+            if (g_is_editor_mode &&
+                g_editor_tick_component_types.find(pool->getTypeName()) == g_editor_tick_component_types.end())
+            {
+                continue;
+            }
+
+            PROFILE_SCOPE_DYNAMIC(pool->getTypeName());
+            pool->tick(delta_time, job_system);
+        }
+    }
+
+    ComponentPoolBase* ComponentStore::findPool(const std::string& type_name) const
+    {
+        for (const std::unique_ptr<ComponentPoolBase>& pool : m_pools)
+        {
+            if (pool->getTypeName() == type_name)
+            {
+                return pool.get();
+            }
+        }
+        return nullptr;
+    }
+} // namespace Pilot
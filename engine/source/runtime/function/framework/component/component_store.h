@@ -0,0 +1,220 @@
+#pragma once
+
+#include "runtime/core/job/job_system.h"
+
+#include "runtime/function/framework/component/component.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace Pilot
+{
+    /// Type erased pool of components of one type, see ComponentPool
+    class ComponentPoolBase
+    {
+    public:
+        explicit ComponentPoolBase(std::string type_name) : m_type_name(std::move(type_name)) {}
+        virtual ~ComponentPoolBase() = default;
+
+        const std::string& getTypeName() const { return m_type_name; }
+
+        // move a component created through reflection into the pool, the original instance is deleted.
+        // Call it before postLoadResource, a component may hand out pointers to itself there
+        virtual void adopt(Reflection::ReflectionPtr<Component>& component) = 0;
+
+        // tick every component, spread over the job system when it is given and the type allows it
+        virtual void   tick(float delta_time, JobSystem* job_system) = 0;
+        virtual size_t getSize() const = 0;
+
+        // called by Component::operator delete once the component is destroyed. Return false if the memory is not
+        // a slot of any pool, it was allocated by new then
+        static bool freePooledSlot(void* pointer);
+
+    protected:
+        static void markPooled(Component& component) { component.m_is_pooled = true; }
+
+        // the memory of a chunk is known to Component::operator delete while it is registered
+        void registerChunk(const void* storage, size_t byte_size, size_t chunk_index);
+        void unregisterChunk(const void* storage);
+
+        // the component in the slot is already destroyed
+        virtual void freeSlot(size_t chunk_index, void* pointer) = 0;
+
+        std::string m_type_name;
+    };
+
+    /// Keeps all components of one type in fixed size chunks so that they are ticked in a linear loop.
+    /// A chunk never moves, so pointers to pooled components stay valid like heap allocated ones. The pool owns the
+    /// memory: deleting a pooled component through its ReflectionPtr frees its slot, see Component::operator delete.
+    /// The components are whole objects, the reflection, the editor and the snapshots reach their fields by address.
+    /// TComponent must be safe to move, pooling a component owning raw pointers would free them twice.
+    template<typename TComponent>
+    class ComponentPool final : public ComponentPoolBase
+    {
+    public:
+        static constexpr size_t k_chunk_capacity = 128;
+
+        using ComponentPoolBase::ComponentPoolBase;
+
+        ~ComponentPool() override
+        {
+            // the objects keep the store alive, so no component is expected to be left here
+            for (std::unique_ptr<Chunk>& chunk : m_chunks)
+            {
+                for (size_t slot_index = 0; slot_index < k_chunk_capacity; ++slot_index)
+                {
+                    if (chunk->m_is_alive[slot_index])
+                    {
+                        chunk->getSlot(slot_index)->~TComponent();
+                    }
+                }
+                unregisterChunk(chunk->m_storage);
+            }
+        }
+
+        void adopt(Reflection::ReflectionPtr<Component>& component) override
+        {
+            TComponent* source = static_cast<TComponent*>(component.getPtr());
+
+            const uint32_t slot_id    = allocateSlot();
+            Chunk&         chunk      = *m_chunks[slot_id / k_chunk_capacity];
+            const size_t   slot_index = slot_id % k_chunk_capacity;
+
+            TComponent* pooled_component = new (chunk.getSlot(slot_index)) TComponent(std::move(*source));
+            chunk.m_is_alive[slot_index] = true;
+            markPooled(*pooled_component);
+
+            m_can_tick_concurrently = m_can_tick_concurrently && pooled_component->canTickConcurrently();
+            ++m_size;
+
+            delete source;
+            component = Reflection::ReflectionPtr<Component>(component.getTypeName(), pooled_component);
+        }
+        // call function on every component, in memory order
+        template<typename TFunction>
+        void forEach(TFunction&& function)
+        {
+            for (std::unique_ptr<Chunk>& chunk : m_chunks)
+            {
+                forEachInChunk(*chunk, function);
+            }
+        }
+
+        void tick(float delta_time, JobSystem* job_system) override
+        {
+            // qualified call, the whole loop goes without virtual dispatch, a dormant component is skipped
+            auto tick_component = [delta_time](TComponent& component) {
+                if (!component.isDormant())
+                {
+                    component.TComponent::tick(delta_time);
+                }
+            };
+
+            if (job_system && m_can_tick_concurrently && m_chunks.size() > 1)
+            {
+                job_system->parallelFor(0, m_chunks.size(), 1, [this, &tick_component](size_t chunk_index) {
+                    forEachInChunk(*m_chunks[chunk_index], tick_component);
+                });
+                return;
+            }
+
+            forEach(tick_component);
+        }
+
+        size_t getSize() const override { return m_size; }
+
+    protected:
+        void freeSlot(size_t chunk_index, void* pointer) override
+        {
+            Chunk&       chunk      = *m_chunks[chunk_index];
+            const size_t slot_index = static_cast<size_t>(static_cast<TComponent*>(pointer) - chunk.getSlot(0));
+
+            chunk.m_is_alive[slot_index] = false;
+            m_free_slots.push_back(static_cast<uint32_t>(chunk_index * k_chunk_capacity + slot_index));
+            --m_size;
+        }
+
+    private:
+        struct Chunk
+        {
+            alignas(TComponent) unsigned char m_storage[sizeof(TComponent) * k_chunk_capacity];
+            bool m_is_alive[k_chunk_capacity] {};
+
+            TComponent* getSlot(size_t slot_index)
+            {
+                return std::launder(reinterpret_cast<TComponent*>(m_storage)) + slot_index;
+            }
+        };
+
+        template<typename TFunction>
+        static void forEachInChunk(Chunk& chunk, TFunction& function)
+        {
+            for (size_t slot_index = 0; slot_index < k_chunk_capacity; ++slot_index)
+            {
+                if (chunk.m_is_alive[slot_index])
+                {
+                    function(*chunk.getSlot(slot_index));
+                }
+            }
+        }
+
+        uint32_t allocateSlot()
+        {
+            if (m_free_slots.empty())
+            {
+                // slots are handed out from the front, so that the live components stay packed
+                const uint32_t first_slot_id = static_cast<uint32_t>(m_chunks.size() * k_chunk_capacity);
+                m_chunks.push_back(std::make_unique<Chunk>());
+                registerChunk(m_chunks.back()->m_storage, sizeof(Chunk::m_storage), m_chunks.size() - 1);
+                for (uint32_t slot_id = first_slot_id + k_chunk_capacity; slot_id > first_slot_id; --slot_id)
+                {
+                    m_free_slots.push_back(slot_id - 1);
+                }
+            }
+
+            const uint32_t slot_id = m_free_slots.back();
+            m_free_slots.pop_back();
+            return slot_id;
+        }
+
+        std::vector<std::unique_ptr<Chunk>> m_chunks;
+        std::vector<uint32_t>               m_free_slots;
+        size_t                              m_size {0};
+        bool                                m_can_tick_concurrently {true};
+    };
+
+    /// Optional pooled storage of a level.
+    /// Components of a registered type are moved out of their objects into a ComponentPool on load and ticked by
+    /// the store before the ComponentTickScheduler of the level, which does not list them.
+    class ComponentStore
+    {
+    public:
+        template<typename TComponent>
+        void registerPool(const std::string& type_name)
+        {
+            m_pools.push_back(std::make_unique<ComponentPool<TComponent>>(type_name));
+        }
+
+        // return null if the type is not pooled
+        template<typename TComponent>
+        ComponentPool<TComponent>* getPool(const std::string& type_name)
+        {
+            return static_cast<ComponentPool<TComponent>*>(findPool(type_name));
+        }
+
+        // replace the components of pooled types by their pooled instance, before postLoadResource.
+        // A pooled component is deleted like any other one, its slot goes back to its pool
+        void adoptComponents(std::vector<Reflection::ReflectionPtr<Component>>& components);
+
+        void tick(float delta_time);
+
+    private:
+        ComponentPoolBase* findPool(const std::string& type_name) const;
+
+        std::vector<std::unique_ptr<ComponentPoolBase>> m_pools;
+    };
+} // namespace Pilot
@@ -0,0 +1,283 @@
+#include "runtime/function/framework/component/component_tick_scheduler.h"
+
+#include "runtime/core/base/frame_allocator.h"
+#include "runtime/core/job/job_system.h"
+#include "runtime/core/profile/profiler.h"
+
+#include "runtime/engine.h"
+#include "runtime/function/framework/object/object.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace Pilot
+{
+    // objects ticked by one job in parallel tick mode
+    static constexpr size_t k_parallel_tick_batch_size = 16;
+    // bits of the entry order given to the component index within its object
+    static constexpr uint32_t k_component_index_bits = 16;
+
+    ComponentTickScheduler::~ComponentTickScheduler() { clear(); }
+
+    void ComponentTickScheduler::addObject(GObject& object)
+    {
+        const uint64_t object_order = m_next_object_order++;
+        m_object_orders[&object]    = object_order;
+
+        const auto& components = object.getComponents();
+        for (size_t component_index = 0; component_index < components.size(); ++component_index)
+        {
+            Component* component = components[component_index].getPtr();
+            if (!component || component->isPooled())
+                continue;
+
+            const std::string& type_name = components[component_index].getTypeName();
+
+            TickEntry entry;
+            entry.m_component           = component;
+            entry.m_object              = &object;
+            entry.m_type_name           = Profiler::internName(type_name);
+            entry.m_order               = (object_order << k_component_index_bits) | component_index;
+            entry.m_is_ticked_in_editor = g_editor_tick_component_types.find(type_name) !=
+                                          g_editor_tick_component_types.end();
+
+            component->m_tick_scheduler = this;
+            if (component->m_is_dormant)
+            {
+                m_dormant_entries.emplace(component, entry);
+            }
+            else
+            {
+                // the object is the newest one, the list stays sorted
+                m_lists[static_cast<size_t>(component->getTickGroup())].m_entries.push_back(entry);
+            }
+        }
+    }
+
+    void ComponentTickScheduler::removeObject(GObject& object)
+    {
+        auto order_iter = m_object_orders.find(&object);
+        if (order_iter == m_object_orders.end())
+            return;
+
+        // the entries leave the lists before the next tick, many objects removed together cost one pass
+        m_removed_object_orders.insert(order_iter->second);
+        m_object_orders.erase(order_iter);
+
+        const auto& components = object.getComponents();
+        for (const auto& component : components)
+        {
+            if (component && component->m_tick_scheduler == this)
+            {
+                component->m_tick_scheduler = nullptr;
+                m_dormant_entries.erase(component.getPtr());
+            }
+        }
+
+        // the components are about to be deleted, forget their pending updates
+        std::lock_guard<std::mutex> lock(m_pending_mutex);
+        m_pending_components.erase(std::remove_if(m_pending_components.begin(),
+                                                  m_pending_components.end(),
+                                                  [&components](Component* pending_component) {
+                                                      return std::any_of(components.begin(),
+                                                                         components.end(),
+                                                                         [pending_component](const auto& component) {
+                                                                             return component.getPtr() ==
+                                                                                    pending_component;
+                                                                         });
+                                                  }),
+                                   m_pending_components.end());
+    }
+
+    void ComponentTickScheduler::clear()
+    {
+        // the components of the removed objects may be deleted already
+        dropRemovedEntries();
+        m_object_orders.clear();
+
+        for (TickList& list : m_lists)
+        {
+            for (TickEntry& entry : list.m_entries)
+            {
+                entry.m_component->m_tick_scheduler = nullptr;
+            }
+            list.m_entries.clear();
+            list.m_has_fallen_dormant = false;
+        }
+        for (auto& dormant_entry : m_dormant_entries)
+        {
+            dormant_entry.first->m_tick_scheduler = nullptr;
+        }
+        m_dormant_entries.clear();
+
+        std::lock_guard<std::mutex> lock(m_pending_mutex);
+        m_pending_components.clear();
+    }
+
+    void ComponentTickScheduler::requestUpdate(Component& component)
+    {
+        std::lock_guard<std::mutex> lock(m_pending_mutex);
+        m_pending_components.push_back(&component);
+    }
+
+    size_t ComponentTickScheduler::getAwakeCount(ComponentTickGroup group) const
+    {
+        const std::vector<TickEntry>& entries = m_lists[static_cast<size_t>(group)].m_entries;
+        return std::count_if(entries.begin(), entries.end(), [this](const TickEntry& entry) {
+            // the component of a removed object may be deleted already
+            return m_removed_object_orders.count(entry.m_order >> k_component_index_bits) == 0 &&
+                   !entry.m_component->m_is_dormant;
+        });
+    }
+
+    void ComponentTickScheduler::dropRemovedEntries()
+    {
+        if (m_removed_object_orders.empty())
+            return;
+
+        // removing keeps the order of the remaining entries
+        for (TickList& list : m_lists)
+        {
+            list.m_entries.erase(std::remove_if(list.m_entries.begin(),
+                                                list.m_entries.end(),
+                                                [this](const TickEntry& entry) {
+                                                    return m_removed_object_orders.count(entry.m_order >>
+                                                                                         k_component_index_bits) != 0;
+                                                }),
+                                 list.m_entries.end());
+        }
+        m_removed_object_orders.clear();
+    }
+
+    void ComponentTickScheduler::applyPendingUpdates(ComponentTickGroup group)
+    {
+        dropRemovedEntries();
+
+        std::vector<Component*> pending_components;
+        {
+            std::lock_guard<std::mutex> lock(m_pending_mutex);
+            pending_components.swap(m_pending_components);
+        }
+
+        size_t sorted_counts[static_cast<size_t>(ComponentTickGroup::count)];
+        for (size_t group_index = 0; group_index < static_cast<size_t>(ComponentTickGroup::count); ++group_index)
+        {
+            sorted_counts[group_index] = m_lists[group_index].m_entries.size();
+        }
+
+        for (Component* component : pending_components)
+        {
+            if (component->m_tick_scheduler != this)
+                continue;
+
+            TickList& list = m_lists[static_cast<size_t>(component->getTickGroup())];
+            if (component->m_is_dormant)
+            {
+                // left in the list until the group ticks, a component woken up meanwhile keeps its entry
+                list.m_has_fallen_dormant = true;
+                continue;
+            }
+
+            // a component woken up twice, or before it left its list, is not in the dormant entries
+            auto iter = m_dormant_entries.find(component);
+            if (iter != m_dormant_entries.end())
+            {
+                list.m_entries.push_back(iter->second);
+                m_dormant_entries.erase(iter);
+            }
+        }
+
+        // merge the woken entries into their lists, the lists stay sorted without sorting them again
+        auto is_before = [](const TickEntry& lhs, const TickEntry& rhs) { return lhs.m_order < rhs.m_order; };
+        for (size_t group_index = 0; group_index < static_cast<size_t>(ComponentTickGroup::count); ++group_index)
+        {
+            std::vector<TickEntry>& entries = m_lists[group_index].m_entries;
+            if (entries.size() > sorted_counts[group_index])
+            {
+                const auto woken_begin = entries.begin() + sorted_counts[group_index];
+                std::sort(woken_begin, entries.end(), is_before);
+                std::inplace_merge(entries.begin(), woken_begin, entries.end(), is_before);
+            }
+        }
+
+        TickList& list = m_lists[static_cast<size_t>(group)];
+        if (list.m_has_fallen_dormant)
+        {
+            size_t awake_count = 0;
+            for (TickEntry& entry : list.m_entries)
+            {
+                if (entry.m_component->m_is_dormant)
+                {
+                    m_dormant_entries.emplace(entry.m_component, entry);
+                }
+                else
+                {
+                    list.m_entries[awake_count++] = entry;
+                }
+            }
+            list.m_entries.resize(awake_count);
+            list.m_has_fallen_dormant = false;
+        }
+    }
+
+    void ComponentTickScheduler::tickGroup(ComponentTickGroup group, float delta_time, JobSystem* job_system)
+    {
+        applyPendingUpdates(group);
+
+        const std::vector<TickEntry>& entries = m_lists[static_cast<size_t>(group)].m_entries;
+        if (job_system == nullptr)
+        {
+            tickEntries(entries.data(), entries.size(), delta_time);
+            return;
+        }
+
+        // the components of an object stay on one thread, objects made only of concurrent components are spread
+        // over the workers and the others tick on this thread
+        FrameVector<std::pair<size_t, size_t>> concurrent_runs;
+        FrameVector<std::pair<size_t, size_t>> serial_runs;
+        for (size_t run_begin = 0; run_begin < entries.size();)
+        {
+            GObject* object  = entries[run_begin].m_object;
+            size_t   run_end = run_begin + 1;
+            while (run_end < entries.size() && entries[run_end].m_object == object)
+            {
+                ++run_end;
+            }
+
+            if (object->canTickConcurrently())
+            {
+                concurrent_runs.emplace_back(run_begin, run_end);
+            }
+            else
+            {
+                serial_runs.emplace_back(run_begin, run_end);
+            }
+            run_begin = run_end;
+        }
+
+        job_system->parallelFor(
+            0, concurrent_runs.size(), k_parallel_tick_batch_size, [&, this](size_t run_index) {
+                const std::pair<size_t, size_t>& run = concurrent_runs[run_index];
+                tickEntries(entries.data() + run.first, run.second - run.first, delta_time);
+            });
+
+        for (const std::pair<size_t, size_t>& run : serial_runs)
+        {
+            tickEntries(entries.data() + run.first, run.second - run.first, delta_time);
+        }
+    }
+
+    void ComponentTickScheduler::tickEntries(const TickEntry* entries, size_t entry_count, float delta_time) const
+    {
+        const bool is_editor_mode = g_is_editor_mode;
+        for (size_t entry_index = 0; entry_index < entry_count; ++entry_index)
+        {
+            const TickEntry& entry = entries[entry_index];
+            if (is_editor_mode && !entry.m_is_ticked_in_editor)
+                continue;
+
+            PROFILE_SCOPE(entry.m_type_name);
+            entry.m_component->tick(delta_time);
+        }
+    }
+} // namespace Pilot
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "runtime/function/framework/component/component.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace Pilot
+{
+    class GObject;
+    class JobSystem;
+
+    /// Components of a level to tick, by tick group.
+    /// Only the awake components are listed, kept in the order of their objects and of the components within an
+    /// object. A dormant component is moved out of its list until it is woken up, so it costs nothing per frame. It
+    /// leaves the list right before its group ticks, and a woken component is merged back in order.
+    class ComponentTickScheduler
+    {
+    public:
+        ~ComponentTickScheduler();
+
+        // pooled components are ticked by the ComponentStore of the level, they are not registered
+        void addObject(GObject& object);
+        void removeObject(GObject& object);
+        void clear();
+
+        // thread safe, the dormancy of the component changed, it is applied before the next tick group
+        void requestUpdate(Component& component);
+
+        // tick the awake components of the group, objects which can tick concurrently are spread over job_system
+        void tickGroup(ComponentTickGroup group, float delta_time, JobSystem* job_system);
+
+        size_t getAwakeCount(ComponentTickGroup group) const;
+        size_t getDormantCount() const { return m_dormant_entries.size(); }
+
+    private:
+        struct TickEntry
+        {
+            Component* m_component {nullptr};
+            GObject*   m_object {nullptr};
+            // interned type name, used by the profiler
+            const char* m_type_name {nullptr};
+            // object order then component index, the order of the entries in a list
+            uint64_t m_order {0};
+            bool     m_is_ticked_in_editor {false};
+        };
+
+        struct TickList
+        {
+            std::vector<TickEntry> m_entries;
+            // some entries fell dormant, they leave the list right before the group ticks
+            bool m_has_fallen_dormant {false};
+        };
+
+        // the woken components join their lists, the dormant ones leave the list of group
+        void applyPendingUpdates(ComponentTickGroup group);
+        void dropRemovedEntries();
+        void tickEntries(const TickEntry* entries, size_t entry_count, float delta_time) const;
+
+        TickList                                  m_lists[static_cast<size_t>(ComponentTickGroup::count)];
+        std::unordered_map<Component*, TickEntry> m_dormant_entries;
+        uint64_t                                  m_next_object_order {0};
+
+        // order of each registered object, shared by the entries of its components
+        std::unordered_map<const GObject*, uint64_t> m_object_orders;
+        // objects removed since the lists were last compacted, their entries are dropped in one pass
+        std::unordered_set<uint64_t>                 m_removed_object_orders;
+
+        std::mutex              m_pending_mutex;
+        std::vector<Component*> m_pending_components;
+    };
+} // namespace Pilot
@@ -0,0 +1,34 @@
+#include "runtime/function/framework/component/component_type.h"
+
+#include <mutex>
+#include <vector>
+
+namespace Pilot
+{
+    ComponentTypeId ComponentTypeRegistry::getTypeId(const std::string& type_name)
+    {
+        const Reflection::TypeId reflection_type_id = Reflection::TypeMeta::getTypeIdFromName(type_name);
+        if (reflection_type_id == Reflection::k_invalid_type_id)
+        {
+            return k_invalid_component_type_id;
+        }
+
+        // objects are loaded on the streaming thread as well
+        static std::mutex                   s_type_id_mutex;
+        static std::vector<ComponentTypeId> s_component_type_ids;
+        static ComponentTypeId              s_component_type_count {0};
+
+        std::lock_guard<std::mutex> lock(s_type_id_mutex);
+        if (reflection_type_id >= s_component_type_ids.size())
+        {
+            s_component_type_ids.resize(reflection_type_id + 1, k_invalid_component_type_id);
+        }
+
+        ComponentTypeId& component_type_id = s_component_type_ids[reflection_type_id];
+        if (component_type_id == k_invalid_component_type_id)
+        {
+            component_type_id = s_component_type_count++;
+        }
+        return component_type_id;
+    }
+} // namespace Pilot
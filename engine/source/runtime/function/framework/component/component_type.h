@@ -0,0 +1,45 @@
+#pragma once
+
+#include "runtime/core/meta/reflection/reflection.h"
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+namespace Pilot
+{
+    using ComponentTypeId = uint32_t;
+
+    static constexpr ComponentTypeId k_invalid_component_type_id = std::numeric_limits<ComponentTypeId>::max();
+
+    /// Dense ids of the component types, used as index in the component table of every object.
+    /// A type gets its id from its reflection type id the first time it is asked for, so the ids only span the
+    /// component types and not all the reflected ones.
+    class ComponentTypeRegistry
+    {
+    public:
+        // return k_invalid_component_type_id if the type is not reflected
+        static ComponentTypeId getTypeId(const std::string& type_name);
+
+        // type_name is the name of TComponent, as the tryGetComponent macros pass it. The id is cached per type once
+        // it is valid, a call before the reflection is registered resolves the name again next time
+        template<typename TComponent>
+        static ComponentTypeId getTypeId(const char* type_name)
+        {
+            static std::atomic<ComponentTypeId> s_type_id {k_invalid_component_type_id};
+
+            ComponentTypeId type_id = s_type_id.load(std::memory_order_relaxed);
+            if (type_id == k_invalid_component_type_id)
+            {
+                // every thread resolving it gets the same id
+                type_id = getTypeId(std::string(type_name));
+                if (type_id != k_invalid_component_type_id)
+                {
+                    s_type_id.store(type_id, std::memory_order_relaxed);
+                }
+            }
+            return type_id;
+        }
+    };
+} // namespace Pilot
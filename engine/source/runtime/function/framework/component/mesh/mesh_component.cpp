@@ -1,5 +1,9 @@
 #include "runtime/function/framework/component/mesh/mesh_component.h"
 
+#include "runtime/core/base/frame_allocator.h"
+
+#include "runtime/engine.h"
+
 #include "runtime/resource/asset_manager/asset_manager.h"
 #include "runtime/resource/res_type/data/material.h"
 
@@ -8,11 +12,48 @@
 #include "runtime/function/framework/object/object.h"
 #include "runtime/function/global/global_context.h"
 
+#include "runtime/function/render/render_resource_base.h"
 #include "runtime/function/render/render_swap_context.h"
 #include "runtime/function/render/render_system.h"
 
+#include <filesystem>
+
 namespace Pilot
 {
+    namespace
+    {
+        // box of the vertices of a mesh file, the render resource stores it when it loads the mesh first
+        bool getMeshFileBounds(const std::string& mesh_file, AxisAlignedBox& out_bounds)
+        {
+            std::shared_ptr<AssetManager> asset_manager = g_runtime_global_context.m_asset_manager;
+            ASSERT(asset_manager);
+
+            auto load_bounds = [&asset_manager, &mesh_file](AxisAlignedBox& out_mesh_bounds) {
+                // read the way the render resource reads it
+                MeshData                    mesh_data;
+                const std::filesystem::path extension = std::filesystem::path(mesh_file).extension();
+                if (extension == ".obj")
+                {
+                    if (!asset_manager->loadCookedAsset(mesh_file, mesh_data))
+                    {
+                        RenderResourceBase::loadObjMesh(mesh_file, mesh_data);
+                    }
+                }
+                else if (extension == ".json")
+                {
+                    asset_manager->loadAsset(mesh_file, mesh_data);
+                }
+
+                for (const Vertex& vertex : mesh_data.vertex_buffer)
+                {
+                    out_mesh_bounds.merge(Vector3(vertex.px, vertex.py, vertex.pz));
+                }
+                return !mesh_data.vertex_buffer.empty();
+            };
+            return asset_manager->getMeshBoundsCache().getBounds(mesh_file, load_bounds, out_bounds);
+        }
+    } // namespace
+
     void MeshComponent::postLoadResource(std::weak_ptr<GObject> parent_object)
     {
         m_parent_object = parent_object;
@@ -56,41 +97,81 @@ namespace Pilot
         }
     }
 
+    bool MeshComponent::getLocalBounds(AxisAlignedBox& out_bounds) const
+    {
+        bool has_bounds = false;
+        for (const GameObjectPartDesc& mesh_part : m_raw_meshes)
+        {
+            AxisAlignedBox mesh_bounds;
+            if (!getMeshFileBounds(mesh_part.m_mesh_desc.m_mesh_file, mesh_bounds))
+            {
+                continue;
+            }
+
+            // corners of the mesh box, in object space
+            const Matrix4x4& part_matrix = mesh_part.m_transform_desc.m_transform_matrix;
+            const Vector3&   min_corner  = mesh_bounds.getMinCorner();
+            const Vector3&   max_corner  = mesh_bounds.getMaxCorner();
+            for (int corner = 0; corner < 8; ++corner)
+            {
+                const Vector3 mesh_corner((corner & 1) ? max_corner.x : min_corner.x,
+                                          (corner & 2) ? max_corner.y : min_corner.y,
+                                          (corner & 4) ? max_corner.z : min_corner.z);
+                out_bounds.merge(part_matrix.transformAffine(mesh_corner));
+            }
+            has_bounds = true;
+        }
+        return has_bounds;
+    }
+
     void MeshComponent::tick(float delta_time)
     {
-        if (!m_parent_object.lock())
+        std::shared_ptr<GObject> parent_object = m_parent_object.lock();
+        if (!parent_object)
             return;
 
-        TransformComponent*       transform_component = m_parent_object.lock()->tryGetComponent(TransformComponent);
-        const AnimationComponent* animation_component =
-            m_parent_object.lock()->tryGetComponentConst(AnimationComponent);
+        TransformComponent*       transform_component = parent_object->tryGetComponent(TransformComponent);
+        const AnimationComponent* animation_component = parent_object->tryGetComponentConst(AnimationComponent);
 
         if (transform_component->isDirty())
         {
-            std::vector<GameObjectPartDesc> dirty_mesh_parts;
-            SkeletonAnimationResult         animation_result;
-            animation_result.m_transforms.push_back({Matrix4x4::IDENTITY});
+            if (g_is_headless_mode)
+            {
+                // nothing to render
+                return;
+            }
+
+            // copy assigned every frame, the parts keep the capacity of their arrays
+            m_dirty_mesh_parts.resize(m_raw_meshes.size());
+
+            FrameVector<SkeletonAnimationResultTransform> animation_transforms;
             if (animation_component != nullptr)
             {
-                for (auto& node : animation_component->getResult().m_node)
+                const auto& animation_nodes = animation_component->getResult().m_node;
+                animation_transforms.reserve(animation_nodes.size() + 1);
+                animation_transforms.push_back({Matrix4x4::IDENTITY});
+                for (auto& node : animation_nodes)
                 {
                     Pilot::SkeletonAnimationResultTransform tmp {Matrix4x4(node.m_transform)};
-                    animation_result.m_transforms.push_back(tmp);
+                    animation_transforms.push_back(tmp);
                 }
             }
-            for (GameObjectPartDesc& mesh_part : m_raw_meshes)
+            for (size_t part_index = 0; part_index < m_raw_meshes.size(); ++part_index)
             {
+                GameObjectPartDesc& mesh_part = m_raw_meshes[part_index];
                 if (animation_component)
                 {
-                    mesh_part.m_with_animation                                = true;
-                    mesh_part.m_skeleton_animation_result                     = animation_result;
+                    mesh_part.m_with_animation = true;
+                    // assign keeps the capacity of the previous frame
+                    mesh_part.m_skeleton_animation_result.m_transforms.assign(animation_transforms.begin(),
+                                                                              animation_transforms.end());
                     mesh_part.m_skeleton_binding_desc.m_skeleton_binding_file = mesh_part.m_mesh_desc.m_mesh_file;
                 }
                 Matrix4x4 object_transform_matrix = mesh_part.m_transform_desc.m_transform_matrix;
 
                 mesh_part.m_transform_desc.m_transform_matrix =
                     transform_component->getMatrix() * object_transform_matrix;
-                dirty_mesh_parts.push_back(mesh_part);
+                m_dirty_mesh_parts[part_index] = mesh_part;
 
                 mesh_part.m_transform_desc.m_transform_matrix = object_transform_matrix;
             }
@@ -98,9 +179,12 @@ namespace Pilot
             RenderSwapContext& render_swap_context = g_runtime_global_context.m_render_system->getSwapContext();
             RenderSwapData&    logic_swap_data     = render_swap_context.getLogicSwapData();
 
-            logic_swap_data.addDirtyGameObject(GameObjectDesc {m_parent_object.lock()->getID(), dirty_mesh_parts});
-
-            transform_component->setDirtyFlag(false);
+            logic_swap_data.addDirtyGameObject(parent_object->getID(), m_dirty_mesh_parts);
+        }
+        else if (animation_component == nullptr)
+        {
+            // static mesh, it is woken up with its object when the transform changes
+            setDormant(true);
         }
     }
 } // namespace Pilot
@@ -23,12 +23,22 @@ namespace Pilot
 
         const std::vector<GameObjectPartDesc>& getRawMeshes() const { return m_raw_meshes; }
 
+        // box of the sub meshes, each mesh file is read once for its bounds and the box is shared
+        bool getLocalBounds(AxisAlignedBox& out_bounds) const override;
+
         void tick(float delta_time) override;
+        bool canTickConcurrently() const override { return true; }
+        // after everything moved the transforms
+        ComponentTickGroup getTickGroup() const override { return ComponentTickGroup::late; }
+        // sends the new world matrix to the render side
+        bool isWokenByTransform() const override { return true; }
 
     private:
         META(Enable)
         MeshComponentRes m_mesh_res;
 
         std::vector<GameObjectPartDesc> m_raw_meshes;
+        // the parts sent to the render side, reused every frame
+        std::vector<GameObjectPartDesc> m_dirty_mesh_parts;
     };
 } // namespace Pilot
@@ -54,7 +54,8 @@ namespace Pilot
 
     void MotorComponent::tickPlayerMotor(float delta_time)
     {
-        if (!m_parent_object.lock())
+        std::shared_ptr<GObject> parent_object = m_parent_object.lock();
+        if (!parent_object)
             return;
 
         std::shared_ptr<Level>     current_level     = g_runtime_global_context.m_world_manager->getCurrentActiveLevel().lock();
@@ -62,15 +63,14 @@ namespace Pilot
         if (current_character == nullptr)
             return;
 
-        if (current_character->getObjectID() != m_parent_object.lock()->getID())
+        if (current_character->getObjectID() != parent_object->getID())
             return;
 
-        TransformComponent* transform_component =
-            m_parent_object.lock()->tryGetComponent<TransformComponent>("TransformComponent");
+        TransformComponent* transform_component = parent_object->tryGetComponent(TransformComponent);
 
-        Radian turn_angle_yaw = g_runtime_global_context.m_input_system->m_cursor_delta_yaw;
-
-        unsigned int command = g_runtime_global_context.m_input_system->getGameCommand();
+        // without input (headless) the character stands still but still falls
+        std::shared_ptr<InputSystem> input_system = g_runtime_global_context.m_input_system;
+        unsigned int                 command      = input_system ? input_system->getGameCommand() : 0;
 
         if (command >= (unsigned int)GameCommand::invalid)
             return;
@@ -83,12 +83,14 @@ namespace Pilot
 
         transform_component->setPosition(m_target_position);
 
-        AnimationComponent* animation_component =
-            m_parent_object.lock()->tryGetComponent<AnimationComponent>("AnimationComponent");
+        AnimationComponent* animation_component = parent_object->tryGetComponent(AnimationComponent);
         if (animation_component != nullptr)
         {
-            animation_component->updateSignal("speed", m_target_position.distance(transform_component->getPosition()) / delta_time);
-            animation_component->updateSignal("jumping", m_jump_state != JumpState::idle);
+            static const BlackboardKey speed_key   = AnimationBlackboard::internKey("speed");
+            static const BlackboardKey jumping_key = AnimationBlackboard::internKey("jumping");
+
+            animation_component->updateSignal(speed_key, m_target_position.distance(transform_component->getPosition()) / delta_time);
+            animation_component->updateSignal(jumping_key, m_jump_state != JumpState::idle);
         }
     }
 
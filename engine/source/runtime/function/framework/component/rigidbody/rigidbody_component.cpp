@@ -1,8 +1,10 @@
 #include "runtime/function/framework/component/rigidbody/rigidbody_component.h"
 
 #include "runtime/core/base/macro.h"
+#include "runtime/core/math/axis_aligned.h"
 
 #include "runtime/function/framework/component/transform/transform_component.h"
+#include "runtime/function/framework/level/level.h"
 #include "runtime/function/framework/object/object.h"
 #include "runtime/function/framework/world/world_manager.h"
 #include "runtime/function/global/global_context.h"
@@ -14,6 +16,7 @@ namespace Pilot
     void RigidBodyComponent::postLoadResource(std::weak_ptr<GObject> parent_object)
     {
         m_parent_object = parent_object;
+        setDormant(true);
 
         const TransformComponent* parent_transform = m_parent_object.lock()->tryGetComponentConst(TransformComponent);
         if (parent_transform == nullptr)
@@ -22,12 +25,15 @@ namespace Pilot
             return;
         }
 
-        m_physics_actor = g_runtime_global_context.m_legacy_physics_system->createPhysicsActor(
-            parent_object, parent_transform->getTransformConst(), m_rigidbody_res);
+        std::shared_ptr<Level> level = m_parent_object.lock()->getLevel().lock();
+        ASSERT(level);
 
-        std::shared_ptr<PhysicsScene> physics_scene =
-            g_runtime_global_context.m_world_manager->getCurrentActivePhysicsScene().lock();
+        std::shared_ptr<PhysicsScene> physics_scene = level->getPhysicsScene().lock();
         ASSERT(physics_scene);
+        m_physics_scene = physics_scene;
+
+        m_physics_actor = g_runtime_global_context.m_legacy_physics_system->createPhysicsActor(
+            parent_object, parent_transform->getTransformConst(), m_rigidbody_res);
 
         const uint32_t body_id = physics_scene->createRigidBody(parent_transform->getTransformConst(), m_rigidbody_res);
         m_physics_actor->setBodyID(body_id);
@@ -39,17 +45,60 @@ namespace Pilot
         {
             const uint32_t body_id = m_physics_actor->getBodyID();
 
-            std::shared_ptr<PhysicsScene> physics_scene =
-                g_runtime_global_context.m_world_manager->getCurrentActivePhysicsScene().lock();
-            ASSERT(physics_scene);
-
-            physics_scene->removeRigidBody(body_id);
+            std::shared_ptr<PhysicsScene> physics_scene = m_physics_scene.lock();
+            if (physics_scene)
+            {
+                physics_scene->removeRigidBody(body_id);
+            }
 
             g_runtime_global_context.m_legacy_physics_system->removePhyicsActor(m_physics_actor);
             m_physics_actor = nullptr;
         }
     }
 
+    bool RigidBodyComponent::getLocalBounds(AxisAlignedBox& out_bounds) const
+    {
+        bool has_bounds = false;
+        for (const RigidBodyShape& shape : m_rigidbody_res.m_shapes)
+        {
+            const std::string shape_type_name = shape.m_geometry.getTypeName();
+
+            Vector3 half_extent;
+            if (shape_type_name == "Box")
+            {
+                half_extent = static_cast<const Box*>(shape.m_geometry.getPtr())->m_half_extents;
+            }
+            else if (shape_type_name == "Sphere")
+            {
+                const float radius = static_cast<const Sphere*>(shape.m_geometry.getPtr())->m_radius;
+                half_extent        = Vector3(radius, radius, radius);
+            }
+            else if (shape_type_name == "Capsule")
+            {
+                // the sphere around the capsule, whatever its axis
+                const Capsule* capsule = static_cast<const Capsule*>(shape.m_geometry.getPtr());
+                const float    radius  = capsule->m_radius + capsule->m_half_height;
+                half_extent            = Vector3(radius, radius, radius);
+            }
+            else
+            {
+                continue;
+            }
+
+            // corners of the shape box, in object space
+            const Matrix4x4 shape_matrix = shape.m_local_transform.getMatrix();
+            for (int corner = 0; corner < 8; ++corner)
+            {
+                const Vector3 local_corner((corner & 1) ? half_extent.x : -half_extent.x,
+                                           (corner & 2) ? half_extent.y : -half_extent.y,
+                                           (corner & 4) ? half_extent.z : -half_extent.z);
+                out_bounds.merge(shape_matrix.transformAffine(local_corner));
+            }
+            has_bounds = true;
+        }
+        return has_bounds;
+    }
+
     void RigidBodyComponent::updateGlobalTransform(const Transform& transform)
     {
         m_physics_actor->setGlobalTransform(transform);
@@ -61,4 +110,32 @@ namespace Pilot
         //physics_scene->updateRigidBodyGlobalTransform(m_physics_actor->getBodyID(), transform);
     }
 
+    void RigidBodyComponent::updateTransformFromPhysics(const PhysicsScene& physics_scene)
+    {
+        if (m_physics_actor == nullptr)
+        {
+            return;
+        }
+
+        Vector3    position;
+        Quaternion rotation;
+        if (!physics_scene.getInterpolatedObjectTransform(m_physics_actor->getBodyID(), position, rotation))
+        {
+            return;
+        }
+
+        std::shared_ptr<GObject> parent_object = m_parent_object.lock();
+        if (!parent_object)
+        {
+            return;
+        }
+
+        TransformComponent* transform_component = parent_object->tryGetComponent(TransformComponent);
+        if (transform_component)
+        {
+            transform_component->setPosition(position);
+            transform_component->setRotation(rotation);
+        }
+    }
+
 } // namespace Pilot
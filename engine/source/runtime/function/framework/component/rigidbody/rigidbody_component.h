@@ -7,6 +7,8 @@
 
 namespace Pilot
 {
+    class PhysicsScene;
+
     REFLECTION_TYPE(RigidBodyComponent)
     CLASS(RigidBodyComponent : public Component, WhiteListFields)
     {
@@ -17,13 +19,22 @@ namespace Pilot
 
         void postLoadResource(std::weak_ptr<GObject> parent_object) override;
 
-        void tick(float delta_time) override {}
+        // nothing to tick, the level moves the body with the physics scene, fall back asleep when woken up
+        void tick(float delta_time) override { setDormant(true); }
+        bool canTickConcurrently() const override { return true; }
+        bool getLocalBounds(AxisAlignedBox& out_bounds) const override;
+
         void updateGlobalTransform(const Transform& transform);
+        // write the interpolated body pose to the transform component, static bodies are left untouched
+        void updateTransformFromPhysics(const PhysicsScene& physics_scene);
 
     protected:
         META(Enable)
         RigidBodyComponentRes m_rigidbody_res;
 
         PhysicsActor* m_physics_actor {nullptr};
+
+        // scene of the owner level, which is not the active one while the level streams in
+        std::weak_ptr<PhysicsScene> m_physics_scene;
     };
 } // namespace Pilot
@@ -2,6 +2,8 @@
 
 #include "runtime/engine.h"
 #include "runtime/function/framework/component/rigidbody/rigidbody_component.h"
+#include "runtime/function/framework/component/transform/transform_hierarchy.h"
+#include "runtime/function/framework/level/level.h"
 
 namespace Pilot
 {
@@ -10,37 +12,102 @@ namespace Pilot
         m_parent_object       = parent_gobject;
         m_transform_buffer[0] = m_transform;
         m_transform_buffer[1] = m_transform;
+        m_world_matrix        = m_transform.getMatrix();
+        m_is_local_dirty      = true;
         m_is_dirty            = true;
     }
 
+    void TransformComponent::postRestoreState()
+    {
+        // the parent names are not resolved again, reparenting goes through setParent
+        m_transform_buffer[0] = m_transform;
+        m_transform_buffer[1] = m_transform;
+        m_is_local_dirty      = true;
+        m_has_pending_write   = true;
+        m_is_dirty            = true;
+        setDormant(false);
+    }
+
     void TransformComponent::setPosition(const Vector3& new_translation)
     {
         m_transform_buffer[m_next_index].m_position = new_translation;
         m_transform.m_position                      = new_translation;
-        m_is_dirty                                  = true;
+        m_is_local_dirty                            = true;
+        m_has_pending_write                         = true;
+        m_is_save_dirty                             = true;
+        setDormant(false);
     }
 
     void TransformComponent::setScale(const Vector3& new_scale)
     {
         m_transform_buffer[m_next_index].m_scale = new_scale;
         m_transform.m_scale                      = new_scale;
-        m_is_dirty                               = true;
+        m_is_local_dirty                         = true;
+        m_has_pending_write                      = true;
+        m_is_save_dirty                          = true;
+        setDormant(false);
     }
 
     void TransformComponent::setRotation(const Quaternion& new_rotation)
     {
         m_transform_buffer[m_next_index].m_rotation = new_rotation;
         m_transform.m_rotation                      = new_rotation;
-        m_is_dirty                                  = true;
+        m_is_local_dirty                            = true;
+        m_has_pending_write                         = true;
+        m_is_save_dirty                             = true;
+        setDormant(false);
+    }
+
+    void TransformComponent::setWorldMatrix(const Matrix4x4& world_matrix)
+    {
+        const Matrix4x4 local_matrix = m_parent_world_matrix.inverseAffine() * world_matrix;
+
+        Vector3    position;
+        Vector3    scale;
+        Quaternion rotation;
+        local_matrix.decomposition(position, scale, rotation);
+
+        setPosition(position);
+        setRotation(rotation);
+        setScale(scale);
+    }
+
+    void TransformComponent::setParent(GObjectID parent_id, const std::string& bone_name)
+    {
+        std::shared_ptr<GObject> parent_object = m_parent_object.lock();
+        if (!parent_object)
+            return;
+
+        std::shared_ptr<Level> level = parent_object->getLevel().lock();
+        if (!level)
+            return;
+
+        // the name is what gets saved
+        std::shared_ptr<GObject> new_parent_object = level->getGObjectByID(parent_id).lock();
+        m_parent_id        = new_parent_object ? parent_id : k_invalid_gobject_id;
+        m_parent_name      = new_parent_object ? new_parent_object->getName() : std::string();
+        m_parent_bone_name = new_parent_object ? bone_name : std::string();
+        m_is_save_dirty    = true;
+
+        level->getTransformHierarchy().setStructureDirty();
     }
 
     void TransformComponent::tick(float delta_time)
     {
+        if (!m_has_pending_write && !m_is_dirty && !g_is_editor_mode)
+        {
+            // nothing written since the last swap, keep both buffers equal and sleep until the next write
+            m_transform_buffer[m_next_index] = m_transform_buffer[m_current_index];
+            setDormant(true);
+            return;
+        }
+        m_has_pending_write = false;
+
         std::swap(m_current_index, m_next_index);
 
         if (m_is_dirty)
         {
-            // update transform component, dirty flag will be reset in mesh component
+            // the world matrix changed in the last hierarchy update, which also clears the flag
             tryUpdateRigidBodyComponent();
         }
 
@@ -52,13 +119,25 @@ namespace Pilot
 
     void TransformComponent::tryUpdateRigidBodyComponent()
     {
-        if (!m_parent_object.lock())
+        std::shared_ptr<GObject> parent_object = m_parent_object.lock();
+        if (!parent_object)
             return;
 
-        RigidBodyComponent* rigid_body_component = m_parent_object.lock()->tryGetComponent(RigidBodyComponent);
+        RigidBodyComponent* rigid_body_component = parent_object->tryGetComponent(RigidBodyComponent);
         if (rigid_body_component)
         {
-            rigid_body_component->updateGlobalTransform(m_transform_buffer[m_current_index]);
+            if (m_parent_id == k_invalid_gobject_id)
+            {
+                rigid_body_component->updateGlobalTransform(m_transform_buffer[m_current_index]);
+            }
+            else
+            {
+                // attached, the body follows the world transform
+                Transform world_transform;
+                m_world_matrix.decomposition(
+                    world_transform.m_position, world_transform.m_scale, world_transform.m_rotation);
+                rigid_body_component->updateGlobalTransform(world_transform);
+            }
         }
     }
 
@@ -6,17 +6,21 @@
 #include "runtime/function/framework/component/component.h"
 #include "runtime/function/framework/object/object.h"
 
+#include <string>
+
 namespace Pilot
 {
     REFLECTION_TYPE(TransformComponent)
     CLASS(TransformComponent : public Component, WhiteListFields)
     {
         REFLECTION_BODY(TransformComponent)
+        friend class TransformHierarchy;
 
     public:
         TransformComponent() = default;
 
         void postLoadResource(std::weak_ptr<GObject> parent_object) override;
+        void postRestoreState() override;
 
         Vector3    getPosition() const { return m_transform_buffer[m_current_index].m_position; }
         Vector3    getScale() const { return m_transform_buffer[m_current_index].m_scale; }
@@ -31,18 +35,46 @@ namespace Pilot
         const Transform& getTransformConst() const { return m_transform_buffer[m_current_index]; }
         Transform&       getTransform() { return m_transform_buffer[m_next_index]; }
 
-        Matrix4x4 getMatrix() const { return m_transform_buffer[m_current_index].getMatrix(); }
+        // world matrix, computed by the TransformHierarchy of the level
+        const Matrix4x4& getMatrix() const { return m_world_matrix; }
+        Matrix4x4        getLocalMatrix() const { return m_transform.getMatrix(); }
+        // set the local transform so that the world matrix becomes world_matrix
+        void setWorldMatrix(const Matrix4x4& world_matrix);
+        // the next hierarchy update publishes the world matrix again, as if the transform moved
+        void setLocalDirty() { m_is_local_dirty = true; }
+
+        // k_invalid_gobject_id for a root
+        GObjectID getParentID() const { return m_parent_id; }
+        // attach to another object of the level, to one of its bones if bone_name is not empty
+        void setParent(GObjectID parent_id, const std::string& bone_name = "");
 
         void tick(float delta_time) override;
+        bool canTickConcurrently() const override { return true; }
+        // moves the rigid body to the new world matrix
+        bool isWokenByTransform() const override { return true; }
 
         void tryUpdateRigidBodyComponent();
 
     protected:
         META(Enable)
         Transform m_transform;
+        // name of the parent object in the level, empty for a root
+        META(Enable)
+        std::string m_parent_name;
+        // bone of the parent to attach to, empty to attach to the object itself
+        META(Enable)
+        std::string m_parent_bone_name;
 
         Transform m_transform_buffer[2];
         size_t    m_current_index {0};
         size_t    m_next_index {1};
+
+        GObjectID m_parent_id {k_invalid_gobject_id};
+        Matrix4x4 m_world_matrix {Matrix4x4::IDENTITY};
+        Matrix4x4 m_parent_world_matrix {Matrix4x4::IDENTITY};
+        // the local transform changed since the last hierarchy update
+        bool m_is_local_dirty {true};
+        // a setter wrote the next buffer since the last tick
+        bool m_has_pending_write {true};
     };
 } // namespace Pilot
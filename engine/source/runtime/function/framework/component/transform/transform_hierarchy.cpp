@@ -0,0 +1,275 @@
+#include "runtime/function/framework/component/transform/transform_hierarchy.h"
+
+#include "runtime/core/base/macro.h"
+#include "runtime/core/profile/profiler.h"
+
+#include "runtime/function/framework/component/animation/animation_component.h"
+#include "runtime/function/framework/component/transform/transform_component.h"
+#include "runtime/function/framework/level/level.h"
+#include "runtime/function/framework/level/spatial_index.h"
+#include "runtime/function/framework/object/object.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace Pilot
+{
+    void TransformHierarchy::addNode(TransformComponent* transform)
+    {
+        ASSERT(transform);
+        m_nodes.push_back(transform);
+        m_is_structure_dirty = true;
+    }
+
+    void TransformHierarchy::removeNode(TransformComponent* transform)
+    {
+        auto iter = std::find(m_nodes.begin(), m_nodes.end(), transform);
+        if (iter != m_nodes.end())
+        {
+            *iter = m_nodes.back();
+            m_nodes.pop_back();
+        }
+        m_is_structure_dirty = true;
+    }
+
+    void TransformHierarchy::clear()
+    {
+        m_nodes.clear();
+        m_transforms.clear();
+        m_object_ids.clear();
+        m_parent_indices.clear();
+        m_socket_animations.clear();
+        m_socket_bone_indices.clear();
+        m_local_matrices.clear();
+        m_parent_world_matrices.clear();
+        m_world_matrices.clear();
+        m_dirty_flags.clear();
+        m_is_structure_dirty = false;
+    }
+
+    void TransformHierarchy::resolveParent(TransformComponent& transform)
+    {
+        // the parent is saved by name, it is looked up once after load, the level keeps the names unique
+        if (transform.m_parent_id != k_invalid_gobject_id || transform.m_parent_name.empty())
+            return;
+
+        transform.m_parent_id = m_level.getGObjectIDByName(transform.m_parent_name);
+        if (transform.m_parent_id == k_invalid_gobject_id)
+        {
+            LOG_WARN("cannot find parent object {}", transform.m_parent_name);
+        }
+    }
+
+    void TransformHierarchy::rebuild()
+    {
+        PROFILE_SCOPE("TransformHierarchy::rebuild");
+
+        const size_t node_count = m_nodes.size();
+
+        std::unordered_map<GObjectID, size_t> node_index_by_object;
+        std::vector<GObjectID>                node_object_ids(node_count, k_invalid_gobject_id);
+        node_index_by_object.reserve(node_count);
+        for (size_t node_index = 0; node_index < node_count; ++node_index)
+        {
+            std::shared_ptr<GObject> object = m_nodes[node_index]->m_parent_object.lock();
+            if (object)
+            {
+                node_index_by_object.emplace(object->getID(), node_index);
+                node_object_ids[node_index] = object->getID();
+            }
+        }
+
+        // parent of every node in m_nodes, -1 for a root
+        std::vector<int32_t>             node_parents(node_count, -1);
+        std::vector<std::vector<size_t>> node_children(node_count);
+        for (size_t node_index = 0; node_index < node_count; ++node_index)
+        {
+            TransformComponent& transform = *m_nodes[node_index];
+            resolveParent(transform);
+            if (transform.m_parent_id == k_invalid_gobject_id)
+                continue;
+
+            auto parent_iter = node_index_by_object.find(transform.m_parent_id);
+            if (parent_iter == node_index_by_object.end() || parent_iter->second == node_index)
+            {
+                transform.m_parent_id = k_invalid_gobject_id;
+                continue;
+            }
+            node_parents[node_index] = static_cast<int32_t>(parent_iter->second);
+            node_children[parent_iter->second].push_back(node_index);
+        }
+
+        // breadth first from the roots, so that a parent always comes before its children
+        std::vector<size_t>  order;
+        std::vector<int32_t> sorted_index_by_node(node_count, -1);
+        order.reserve(node_count);
+        for (size_t node_index = 0; node_index < node_count; ++node_index)
+        {
+            if (node_parents[node_index] < 0)
+            {
+                sorted_index_by_node[node_index] = static_cast<int32_t>(order.size());
+                order.push_back(node_index);
+            }
+        }
+        for (size_t order_index = 0; order_index < node_count; ++order_index)
+        {
+            if (order_index == order.size())
+            {
+                // what was not reached is part of a cycle, break it at the first node left
+                auto iter = std::find(sorted_index_by_node.begin(), sorted_index_by_node.end(), -1);
+                ASSERT(iter != sorted_index_by_node.end());
+
+                const size_t node_index = static_cast<size_t>(iter - sorted_index_by_node.begin());
+                LOG_WARN("transform parent cycle, detach {}", m_nodes[node_index]->m_parent_name);
+                m_nodes[node_index]->m_parent_id = k_invalid_gobject_id;
+                node_parents[node_index]         = -1;
+
+                sorted_index_by_node[node_index] = static_cast<int32_t>(order.size());
+                order.push_back(node_index);
+            }
+
+            for (size_t child_index : node_children[order[order_index]])
+            {
+                if (sorted_index_by_node[child_index] < 0)
+                {
+                    sorted_index_by_node[child_index] = static_cast<int32_t>(order.size());
+                    order.push_back(child_index);
+                }
+            }
+        }
+
+        m_transforms.resize(node_count);
+        m_object_ids.assign(node_count, k_invalid_gobject_id);
+        m_parent_indices.resize(node_count);
+        m_socket_animations.assign(node_count, nullptr);
+        m_socket_bone_indices.assign(node_count, -1);
+        m_local_matrices.resize(node_count);
+        m_parent_world_matrices.assign(node_count, Matrix4x4::IDENTITY);
+        m_world_matrices.resize(node_count);
+        m_dirty_flags.resize(node_count);
+        for (size_t sorted_index = 0; sorted_index < node_count; ++sorted_index)
+        {
+            const size_t        node_index   = order[sorted_index];
+            const int32_t       parent_index = node_parents[node_index];
+            TransformComponent* transform    = m_nodes[node_index];
+
+            m_transforms[sorted_index]     = transform;
+            m_object_ids[sorted_index]     = node_object_ids[node_index];
+            m_parent_indices[sorted_index] = parent_index < 0 ? -1 : sorted_index_by_node[parent_index];
+            // everything is recomputed once after a rebuild
+            transform->m_is_local_dirty = true;
+
+            if (parent_index < 0 || transform->m_parent_bone_name.empty())
+                continue;
+
+            std::shared_ptr<GObject> parent_object = m_nodes[parent_index]->m_parent_object.lock();
+            const AnimationComponent* animation_component =
+                parent_object ? parent_object->tryGetComponentConst(AnimationComponent) : nullptr;
+            const int32_t bone_index =
+                animation_component ? animation_component->getSkeleton().getBoneIndex(transform->m_parent_bone_name) :
+                                      -1;
+            if (bone_index < 0)
+            {
+                LOG_WARN("cannot find bone {} of {}, attach to the object instead",
+                         transform->m_parent_bone_name,
+                         transform->m_parent_name);
+                continue;
+            }
+            m_socket_animations[sorted_index]   = animation_component;
+            m_socket_bone_indices[sorted_index] = bone_index;
+        }
+
+        m_is_structure_dirty = false;
+    }
+
+    void TransformHierarchy::update()
+    {
+        PROFILE_SCOPE("TransformHierarchy::update");
+
+        if (m_is_structure_dirty)
+        {
+            rebuild();
+        }
+
+        const size_t node_count = m_transforms.size();
+
+        // gather the local transforms which changed, a bone moves with every animation tick
+        for (size_t index = 0; index < node_count; ++index)
+        {
+            TransformComponent& transform = *m_transforms[index];
+
+            const bool is_dirty = transform.m_is_local_dirty || m_socket_animations[index] != nullptr;
+            m_dirty_flags[index] = is_dirty;
+            if (is_dirty)
+            {
+                m_local_matrices[index]    = transform.getLocalMatrix();
+                transform.m_is_local_dirty = false;
+            }
+        }
+
+        // the parents come first, so one pass pushes the flags down the whole hierarchy
+        for (size_t index = 0; index < node_count; ++index)
+        {
+            const int32_t parent_index = m_parent_indices[index];
+            if (parent_index >= 0 && m_dirty_flags[parent_index])
+            {
+                // the cached local matrix is still valid, only the parent moved
+                m_dirty_flags[index] = true;
+            }
+        }
+
+        // linear pass over contiguous matrices, the world matrix of the parent is always ready
+        for (size_t index = 0; index < node_count; ++index)
+        {
+            if (!m_dirty_flags[index])
+                continue;
+
+            const int32_t parent_index = m_parent_indices[index];
+            if (parent_index < 0)
+            {
+                m_world_matrices[index] = m_local_matrices[index];
+                continue;
+            }
+
+            if (m_socket_animations[index])
+            {
+                m_parent_world_matrices[index] =
+                    m_world_matrices[parent_index] *
+                    m_socket_animations[index]->getSkeleton().getBoneModelMatrix(m_socket_bone_indices[index]);
+            }
+            else
+            {
+                m_parent_world_matrices[index] = m_world_matrices[parent_index];
+            }
+            m_world_matrices[index] = m_parent_world_matrices[index] * m_local_matrices[index];
+        }
+
+        // scatter back to the components, the dirty flag says the world matrix changed in this update and stays set
+        // until the next one, so the mesh sends the new matrix and the transform moves its rigid body
+        SpatialIndex& spatial_index = m_level.getSpatialIndex();
+        for (size_t index = 0; index < node_count; ++index)
+        {
+            TransformComponent& transform = *m_transforms[index];
+            if (!m_dirty_flags[index])
+            {
+                transform.m_is_dirty = false;
+                continue;
+            }
+
+            transform.m_world_matrix        = m_world_matrices[index];
+            transform.m_parent_world_matrix = m_parent_indices[index] < 0 ? Matrix4x4::IDENTITY :
+                                                                            m_parent_world_matrices[index];
+            spatial_index.updateObject(m_object_ids[index], m_world_matrices[index]);
+
+            // the object did not move in the last update, the mesh of the object may have fallen dormant since
+            if (!transform.m_is_dirty)
+            {
+                transform.m_is_dirty = true;
+                if (std::shared_ptr<GObject> object = transform.m_parent_object.lock())
+                {
+                    object->wakeTransformDependents();
+                }
+            }
+        }
+    }
+} // namespace Pilot
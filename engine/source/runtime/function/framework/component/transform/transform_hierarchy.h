@@ -0,0 +1,56 @@
+#pragma once
+
+#include "runtime/core/math/matrix4.h"
+
+#include "runtime/function/framework/object/object_id_allocator.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Pilot
+{
+    class AnimationComponent;
+    class Level;
+    class TransformComponent;
+
+    /// Parent/child relations of the transforms of a level.
+    /// The nodes are kept in SoA arrays sorted so that a parent always comes before its children. Once per frame,
+    /// update() propagates the dirty flags down the hierarchy and recomputes the dirty world matrices in one linear
+    /// pass, then caches them on the components.
+    class TransformHierarchy
+    {
+    public:
+        explicit TransformHierarchy(Level& level) : m_level(level) {}
+
+        void addNode(TransformComponent* transform);
+        void removeNode(TransformComponent* transform);
+        void clear();
+
+        // the parents have changed, the order is rebuilt on the next update
+        void setStructureDirty() { m_is_structure_dirty = true; }
+
+        void update();
+
+    private:
+        void rebuild();
+        void resolveParent(TransformComponent& transform);
+
+        Level& m_level;
+
+        // in no particular order, the source of rebuild()
+        std::vector<TransformComponent*> m_nodes;
+        bool                             m_is_structure_dirty {false};
+
+        // topological SoA arrays, index 0 to n - 1 with parents first
+        std::vector<TransformComponent*>       m_transforms;
+        std::vector<GObjectID>                 m_object_ids;
+        std::vector<int32_t>                   m_parent_indices;
+        std::vector<const AnimationComponent*> m_socket_animations;
+        std::vector<int32_t>                   m_socket_bone_indices;
+        std::vector<Matrix4x4>                 m_local_matrices;
+        // world matrix of the parent, times the bone model matrix for a socket
+        std::vector<Matrix4x4>                 m_parent_world_matrices;
+        std::vector<Matrix4x4>                 m_world_matrices;
+        std::vector<uint8_t>                   m_dirty_flags;
+    };
+} // namespace Pilot
@@ -1,12 +1,23 @@
 #include "runtime/function/framework/level/level.h"
 
 #include "runtime/core/base/macro.h"
+#include "runtime/core/job/job_system.h"
+#include "runtime/core/profile/profiler.h"
 
 #include "runtime/resource/asset_manager/asset_manager.h"
+#include "runtime/resource/config_manager/config_manager.h"
 #include "runtime/resource/res_type/common/level.h"
 
 #include "runtime/engine.h"
 #include "runtime/function/character/character.h"
+#include "runtime/function/framework/component/component_store.h"
+#include "runtime/function/framework/component/component_tick_scheduler.h"
+#include "runtime/function/framework/component/mesh/mesh_component.h"
+#include "runtime/function/framework/component/rigidbody/rigidbody_component.h"
+#include "runtime/function/framework/component/transform/transform_component.h"
+#include "runtime/function/framework/component/transform/transform_hierarchy.h"
+#include "runtime/function/framework/level/level_snapshot.h"
+#include "runtime/function/framework/level/spatial_index.h"
 #include "runtime/function/framework/object/object.h"
 #include "runtime/function/physics/physics_manager.h"
 #include "runtime/function/physics/physics_scene.h"
@@ -15,12 +26,29 @@
 
 namespace Pilot
 {
+    // share of the load progress taken by parsing the level resource
+    static constexpr float k_level_resource_load_progress = 0.1f;
+
+    Level::Level() :
+        m_transform_hierarchy(std::make_unique<TransformHierarchy>(*this)),
+        m_tick_scheduler(std::make_unique<ComponentTickScheduler>()),
+        m_spatial_index(std::make_unique<SpatialIndex>())
+    {}
+
     Level::~Level() { clear(); }
 
     void Level::clear()
     {
+        waitForSave();
+        m_saved_objects.clear();
+
         m_current_active_character.reset();
+        m_transform_hierarchy->clear();
+        m_tick_scheduler->clear();
+        m_spatial_index->clear();
         m_gobjects.clear();
+        m_object_ids_by_name.clear();
+        m_component_store.reset();
 
         ASSERT(g_runtime_global_context.m_physics_manager);
         g_runtime_global_context.m_physics_manager->deletePhysicsScene(m_physics_scene);
@@ -28,13 +56,20 @@ namespace Pilot
 
     GObjectID Level::createObject(const ObjectInstanceRes& object_instance_res)
     {
+        // the transform parents are saved by name, they resolve to the first object loaded with it
+        if (m_object_ids_by_name.find(object_instance_res.m_name) != m_object_ids_by_name.end())
+        {
+            LOG_WARN("object name {} is already used in the level, children find the first one",
+                     object_instance_res.m_name);
+        }
+
         GObjectID object_id = ObjectIDAllocator::alloc();
         ASSERT(object_id != k_invalid_gobject_id);
 
         std::shared_ptr<GObject> gobject;
         try
         {
-            gobject = std::make_shared<GObject>(object_id);
+            gobject = std::make_shared<GObject>(object_id, weak_from_this());
         }
         catch (const std::bad_alloc&)
         {
@@ -44,7 +79,34 @@ namespace Pilot
         bool is_loaded = gobject->load(object_instance_res);
         if (is_loaded)
         {
-            m_gobjects.emplace(object_id, gobject);
+            m_gobjects.insert(object_id, gobject);
+            m_object_ids_by_name.emplace(gobject->getName(), object_id);
+            m_tick_scheduler->addObject(*gobject);
+
+            TransformComponent* transform_component = gobject->tryGetComponent(TransformComponent);
+            if (transform_component)
+            {
+                m_transform_hierarchy->addNode(transform_component);
+
+                // union of the bounds of the components, the world matrix is refined by the transform hierarchy
+                // the mesh file is read for its bounds only when no other component, like the rigid body, gives them
+                const MeshComponent* mesh_component = gobject->tryGetComponentConst(MeshComponent);
+                AxisAlignedBox       local_bounds;
+                bool                 has_bounds = false;
+                for (const auto& component : gobject->getComponents())
+                {
+                    if (component && component.getPtr() != mesh_component)
+                    {
+                        has_bounds = component->getLocalBounds(local_bounds) || has_bounds;
+                    }
+                }
+                if (!has_bounds && mesh_component)
+                {
+                    has_bounds = mesh_component->getLocalBounds(local_bounds);
+                }
+                m_spatial_index->addObject(
+                    object_id, has_bounds ? &local_bounds : nullptr, transform_component->getMatrix());
+            }
         }
         else
         {
@@ -59,6 +121,7 @@ namespace Pilot
         LOG_INFO("loading level: {}", level_res_url);
 
         m_level_res_url = level_res_url;
+        m_load_progress = 0.f;
 
         LevelRes   level_res;
         const bool is_load_success = g_runtime_global_context.m_asset_manager->loadAsset(level_res_url, level_res);
@@ -67,18 +130,35 @@ namespace Pilot
             return false;
         }
 
+        m_gravity        = level_res.m_gravity;
+        m_character_name = level_res.m_character_name;
+
         ASSERT(g_runtime_global_context.m_physics_manager);
         m_physics_scene = g_runtime_global_context.m_physics_manager->createPhysicsScene(level_res.m_gravity);
 
+        if (g_runtime_global_context.m_config_manager->isComponentPoolEnabled())
+        {
+            m_component_store = std::make_shared<ComponentStore>();
+            m_component_store->registerPool<TransformComponent>("TransformComponent");
+        }
+
+        // the resource is parsed, the objects make up the rest of the progress
+        m_load_progress = k_level_resource_load_progress;
+
+        const size_t object_count  = level_res.m_objects.size();
+        size_t       created_count = 0;
         for (const ObjectInstanceRes& object_instance_res : level_res.m_objects)
         {
             createObject(object_instance_res);
+
+            ++created_count;
+            m_load_progress = k_level_resource_load_progress +
+                              (1.f - k_level_resource_load_progress) * created_count / static_cast<float>(object_count);
         }
 
         // create active character
-        for (const auto& object_pair : m_gobjects)
+        for (const std::shared_ptr<GObject>& object : m_gobjects)
         {
-            std::shared_ptr<GObject> object = object_pair.second;
             if (object == nullptr)
                 continue;
 
@@ -89,7 +169,8 @@ namespace Pilot
             }
         }
 
-        m_is_loaded = true;
+        m_is_loaded     = true;
+        m_load_progress = 1.f;
 
         LOG_INFO("level load succeed");
 
@@ -105,34 +186,65 @@ namespace Pilot
     bool Level::save()
     {
         LOG_INFO("saving level: {}", m_level_res_url);
-        LevelRes output_level_res;
+        PROFILE_SCOPE("Level::save");
 
-        const size_t                    object_cout    = m_gobjects.size();
-        std::vector<ObjectInstanceRes>& output_objects = output_level_res.m_objects;
-        output_objects.resize(object_cout);
+        // the previous save may still be writing the same file
+        waitForSave();
 
-        size_t object_index = 0;
-        for (const auto& id_object_pair : m_gobjects)
+        PJson::array object_jsons;
+        object_jsons.reserve(m_gobjects.size());
+        size_t serialized_count = 0;
+        for (const std::shared_ptr<GObject>& object : m_gobjects)
         {
-            if (id_object_pair.second)
+            if (object == nullptr)
+                continue;
+
+            // a field written without markSaveDirty() still changes the hash, it is not lost
+            const uint64_t field_hash = LevelSnapshot::hashObjectFields(*object);
+
+            auto iter = m_saved_objects.find(object->getID());
+            if (iter == m_saved_objects.end() || object->isSaveDirty() || iter->second.m_field_hash != field_hash)
             {
-                id_object_pair.second->save(output_objects[object_index]);
-                ++object_index;
+                // the json is immutable once built, it is the snapshot the loader thread writes
+                ObjectInstanceRes object_instance_res;
+                object->save(object_instance_res);
+
+                iter = m_saved_objects
+                           .insert_or_assign(object->getID(),
+                                             SavedObject {PSerializer::write(object_instance_res), field_hash})
+                           .first;
+                object->clearSaveDirty();
+                ++serialized_count;
             }
+            object_jsons.push_back(iter->second.m_json);
         }
 
-        const bool is_save_success =
-            g_runtime_global_context.m_asset_manager->saveAsset(output_level_res, m_level_res_url);
+        // same layout as PSerializer::write(LevelRes), without serializing the objects again
+        LevelRes output_level_res;
+        output_level_res.m_gravity        = m_gravity;
+        output_level_res.m_character_name = m_character_name;
 
-        if (is_save_success == false)
-        {
-            LOG_ERROR("failed to save {}", m_level_res_url);
-        }
-        else
+        const size_t object_count = object_jsons.size();
+
+        PJson::object level_json = PSerializer::write(output_level_res).object_items();
+        level_json.insert_or_assign("m_objects", PJson(std::move(object_jsons)));
+
+        LOG_INFO("serialized {} of {} objects", serialized_count, object_count);
+
+        m_save_future =
+            g_runtime_global_context.m_asset_manager->saveJsonAsync(PJson(std::move(level_json)), m_level_res_url);
+        return m_save_future.valid();
+    }
+
+    bool Level::waitForSave()
+    {
+        if (!m_save_future.valid())
         {
-            LOG_INFO("level save succeed");
+            return true;
         }
 
+        const bool is_save_success = m_save_future.get();
+        m_save_future              = std::shared_future<bool>();
         return is_save_success;
     }
 
@@ -143,14 +255,19 @@ namespace Pilot
             return;
         }
 
-        for (const auto& id_object_pair : m_gobjects)
+        PROFILE_SCOPE("Level::tick");
+
+        if (m_component_store)
         {
-            assert(id_object_pair.second);
-            if (id_object_pair.second)
-            {
-                id_object_pair.second->tick(delta_time);
-            }
+            m_component_store->tick(delta_time);
         }
+
+        JobSystem* job_system = g_runtime_global_context.m_config_manager->isParallelTickEnabled() ?
+                                    g_runtime_global_context.m_job_system.get() :
+                                    nullptr;
+
+        m_tick_scheduler->tickGroup(ComponentTickGroup::pre_physics, delta_time, job_system);
+
         if (m_current_active_character && g_is_editor_mode == false)
         {
             m_current_active_character->tick(delta_time);
@@ -160,32 +277,75 @@ namespace Pilot
         if (physics_scene)
         {
             physics_scene->tick(delta_time);
+
+            // push the interpolated poses of the moving bodies back to their objects
+            if (physics_scene->hasMovingBodies())
+            {
+                for (const std::shared_ptr<GObject>& object : m_gobjects)
+                {
+                    RigidBodyComponent* rigidbody_component = object->tryGetComponent(RigidBodyComponent);
+                    if (rigidbody_component)
+                    {
+                        rigidbody_component->updateTransformFromPhysics(*physics_scene);
+                    }
+                }
+            }
         }
+
+        // world matrices of what moved this frame, physics included, before the later groups read them
+        m_transform_hierarchy->update();
+
+        m_tick_scheduler->tickGroup(ComponentTickGroup::post_physics, delta_time, job_system);
+        m_tick_scheduler->tickGroup(ComponentTickGroup::late, delta_time, job_system);
     }
 
     std::weak_ptr<GObject> Level::getGObjectByID(GObjectID go_id) const
     {
-        auto iter = m_gobjects.find(go_id);
-        if (iter != m_gobjects.end())
+        return m_gobjects.find(go_id);
+    }
+
+    GObjectID Level::getGObjectIDByName(const std::string& name) const
+    {
+        auto iter = m_object_ids_by_name.find(name);
+        return iter != m_object_ids_by_name.end() ? iter->second : k_invalid_gobject_id;
+    }
+
+    void Level::removeObjectName(const GObject& object)
+    {
+        auto iter = m_object_ids_by_name.find(object.getName());
+        if (iter == m_object_ids_by_name.end() || iter->second != object.getID())
+            return;
+
+        // the name goes to the next object sharing it, if any
+        m_object_ids_by_name.erase(iter);
+        for (const std::shared_ptr<GObject>& other_object : m_gobjects)
         {
-            return iter->second;
+            if (other_object && other_object.get() != &object && other_object->getName() == object.getName())
+            {
+                m_object_ids_by_name.emplace(object.getName(), other_object->getID());
+                return;
+            }
         }
-
-        return std::weak_ptr<GObject>();
     }
 
     void Level::deleteGObjectByID(GObjectID go_id)
     {
-        auto iter = m_gobjects.find(go_id);
-        if (iter != m_gobjects.end())
+        const std::shared_ptr<GObject>& object = m_gobjects.find(go_id);
+        if (object)
         {
-            std::shared_ptr<GObject> object = iter->second;
-            if (object)
+            TransformComponent* transform_component = object->tryGetComponent(TransformComponent);
+            if (transform_component)
             {
-                if (m_current_active_character && m_current_active_character->getObjectID() == object->getID())
-                {
-                    m_current_active_character->setObject(nullptr);
-                }
+                m_transform_hierarchy->removeNode(transform_component);
+            }
+            m_tick_scheduler->removeObject(*object);
+            m_spatial_index->removeObject(go_id);
+            m_saved_objects.erase(go_id);
+            removeObjectName(*object);
+
+            if (m_current_active_character && m_current_active_character->getObjectID() == object->getID())
+            {
+                m_current_active_character->setObject(nullptr);
             }
         }
 
@@ -1,7 +1,14 @@
 #pragma once
 
+#include "runtime/core/math/vector3.h"
+#include "runtime/core/meta/json.h"
+
 #include "runtime/function/framework/object/object_id_allocator.h"
+#include "runtime/function/framework/object/object_slot_map.h"
 
+#include <atomic>
+#include <cstdint>
+#include <future>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -9,22 +16,36 @@
 namespace Pilot
 {
     class Character;
+    class ComponentStore;
+    class ComponentTickScheduler;
     class GObject;
     class ObjectInstanceRes;
     class PhysicsScene;
+    class SpatialIndex;
+    class TransformHierarchy;
 
-    using LevelObjectsMap = std::unordered_map<GObjectID, std::shared_ptr<GObject>>;
+    using LevelObjectsMap = GObjectSlotMap;
 
     /// The main class to manage all game objects
-    class Level
+    class Level : public std::enable_shared_from_this<Level>
     {
     public:
+        Level();
         virtual ~Level();
 
+        // can run on the streaming thread, the level must not be ticked before it returns
         bool load(const std::string& level_res_url);
         void unload();
 
+        bool isLoaded() const { return m_is_loaded; }
+        // from 0 to 1 while load() runs
+        float getLoadProgress() const { return m_load_progress.load(std::memory_order_relaxed); }
+
+        // serialize the objects changed since the last save, the file is written on a loader thread
+        // return false if the save could not be started
         bool save();
+        // block until the last save is written, return false if it failed
+        bool waitForSave();
 
         void tick(float delta_time);
 
@@ -33,6 +54,8 @@ namespace Pilot
         const LevelObjectsMap& getAllGObjects() const { return m_gobjects; }
 
         std::weak_ptr<GObject>   getGObjectByID(GObjectID go_id) const;
+        // the first object loaded with the name, k_invalid_gobject_id if there is no such object
+        GObjectID                getGObjectIDByName(const std::string& name) const;
         std::weak_ptr<Character> getCurrentActiveCharacter() const { return m_current_active_character; }
 
         GObjectID createObject(const ObjectInstanceRes& object_instance_res);
@@ -40,17 +63,50 @@ namespace Pilot
 
         std::weak_ptr<PhysicsScene> getPhysicsScene() const { return m_physics_scene; }
 
+        TransformHierarchy&     getTransformHierarchy() const { return *m_transform_hierarchy; }
+        ComponentTickScheduler& getTickScheduler() const { return *m_tick_scheduler; }
+        // bounds of the objects, for proximity, box and ray queries
+        SpatialIndex& getSpatialIndex() const { return *m_spatial_index; }
+
+        // null unless component pooling is enabled in the config
+        const std::shared_ptr<ComponentStore>& getComponentStore() const { return m_component_store; }
+
     protected:
         void clear();
+        void removeObjectName(const GObject& object);
 
-        bool        m_is_loaded {false};
-        std::string m_level_res_url;
+        bool               m_is_loaded {false};
+        std::atomic<float> m_load_progress {0.f};
+        std::string        m_level_res_url;
+        Vector3            m_gravity {0.f, 0.f, -9.8f};
+        std::string        m_character_name;
 
         // all game objects in this level, key: object id, value: object instance
         LevelObjectsMap m_gobjects;
 
+        // first object of each name, the transform parents are resolved by name
+        std::unordered_map<std::string, GObjectID> m_object_ids_by_name;
+
         std::shared_ptr<Character> m_current_active_character;
 
         std::weak_ptr<PhysicsScene> m_physics_scene;
+
+        std::shared_ptr<ComponentStore> m_component_store;
+
+        std::unique_ptr<TransformHierarchy>     m_transform_hierarchy;
+        std::unique_ptr<ComponentTickScheduler> m_tick_scheduler;
+        std::unique_ptr<SpatialIndex>           m_spatial_index;
+
+        struct SavedObject
+        {
+            // ObjectInstanceRes json of the object as of its last save
+            PJson m_json;
+            // LevelSnapshot::hashObjectFields when the json was written
+            uint64_t m_field_hash {0};
+        };
+
+        // reused while the object is not dirty and the hash of its fields is unchanged
+        std::unordered_map<GObjectID, SavedObject> m_saved_objects;
+        std::shared_future<bool>                   m_save_future;
     };
 } // namespace Pilot
@@ -0,0 +1,554 @@
+#include "runtime/function/framework/level/level_snapshot.h"
+
+#include "runtime/core/base/macro.h"
+#include "runtime/core/meta/reflection/reflection.h"
+#include "runtime/core/profile/profiler.h"
+
+#include "runtime/function/framework/component/component.h"
+#include "runtime/function/framework/level/level.h"
+#include "runtime/function/framework/object/object.h"
+
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace Pilot
+{
+    enum class SnapshotOpType : uint8_t
+    {
+        copy,
+        string,
+        array,
+        // reflected type, only used for the elements of an array
+        object,
+        // ReflectionPtr, the fields of the pointee are recorded with the layout of its dynamic type
+        pointer
+    };
+
+    // the layouts are shared by the threads capturing snapshots, the first one to meet an element compiles it
+    struct SnapshotElementLayout
+    {
+        std::once_flag               m_once_flag;
+        const LevelSnapshot::Layout* m_layout {nullptr};
+    };
+
+    struct SnapshotOp
+    {
+        SnapshotOpType m_type {SnapshotOpType::copy};
+        // from the start of the instance
+        size_t m_offset {0};
+        // byte count of a copy
+        size_t m_size {0};
+
+        mutable Reflection::ArrayAccessor m_array_accessor;
+        SnapshotOpType                    m_element_type {SnapshotOpType::copy};
+        size_t                            m_element_size {0};
+        std::string                       m_element_type_name;
+        // compiled from the first element met, an empty array does not need it
+        std::shared_ptr<SnapshotElementLayout> m_element_layout;
+    };
+
+    struct LevelSnapshot::Layout
+    {
+        std::vector<SnapshotOp> m_ops;
+    };
+
+    namespace
+    {
+        size_t getPrimitiveSize(const std::string& type_name)
+        {
+            static const std::unordered_map<std::string, size_t> s_primitive_sizes {
+                {"bool", sizeof(bool)},
+                {"char", sizeof(char)},
+                {"int", sizeof(int)},
+                {"unsigned int", sizeof(unsigned int)},
+                {"float", sizeof(float)},
+                {"double", sizeof(double)},
+                {"int8_t", sizeof(int8_t)},
+                {"uint8_t", sizeof(uint8_t)},
+                {"int16_t", sizeof(int16_t)},
+                {"uint16_t", sizeof(uint16_t)},
+                {"int32_t", sizeof(int32_t)},
+                {"uint32_t", sizeof(uint32_t)},
+                {"int64_t", sizeof(int64_t)},
+                {"uint64_t", sizeof(uint64_t)},
+                {"size_t", sizeof(size_t)}};
+
+            auto iter = s_primitive_sizes.find(type_name);
+            return iter != s_primitive_sizes.end() ? iter->second : 0;
+        }
+
+        bool isStringType(const std::string& type_name) { return type_name == "std::string"; }
+
+        void appendCopy(std::vector<SnapshotOp>& ops, size_t offset, size_t size)
+        {
+            // merge with the previous field when there is no padding in between
+            if (!ops.empty() && ops.back().m_type == SnapshotOpType::copy &&
+                ops.back().m_offset + ops.back().m_size == offset)
+            {
+                ops.back().m_size += size;
+                return;
+            }
+
+            SnapshotOp op;
+            op.m_type   = SnapshotOpType::copy;
+            op.m_offset = offset;
+            op.m_size   = size;
+            ops.push_back(op);
+        }
+
+        bool resolveElementType(SnapshotOp& op)
+        {
+            op.m_element_type_name = op.m_array_accessor.getElementTypeName();
+            op.m_element_size      = getPrimitiveSize(op.m_element_type_name);
+            if (op.m_element_size > 0)
+            {
+                op.m_element_type = SnapshotOpType::copy;
+                return true;
+            }
+            if (isStringType(op.m_element_type_name))
+            {
+                op.m_element_type = SnapshotOpType::string;
+                return true;
+            }
+            if (Reflection::isReflectionPtrType(op.m_element_type_name))
+            {
+                op.m_element_type = SnapshotOpType::pointer;
+                return true;
+            }
+
+            if (Reflection::TypeMeta::getMetaFromName(op.m_element_type_name).isValid())
+            {
+                op.m_element_type   = SnapshotOpType::object;
+                op.m_element_layout = std::make_shared<SnapshotElementLayout>();
+                return true;
+            }
+            return false;
+        }
+
+        // the accessors return the address of the fields, so the offsets found on one instance hold for all
+        void appendTypeOps(const Reflection::TypeMeta& meta, void* instance, uint8_t* root, std::vector<SnapshotOp>& ops)
+        {
+            // fields of the base classes first, each type only lists its own
+            Reflection::ReflectionInstance* base_instances = nullptr;
+            const int base_count = meta.getBaseClassReflectionInstanceList(base_instances, instance);
+            for (int base_index = 0; base_index < base_count; ++base_index)
+            {
+                appendTypeOps(base_instances[base_index].m_meta, base_instances[base_index].m_instance, root, ops);
+            }
+            delete[] base_instances;
+
+            for (Reflection::FieldAccessor field : meta.getFields())
+            {
+                const std::string field_type_name = field.getFieldTypeName();
+                uint8_t*          field_instance  = static_cast<uint8_t*>(field.get(instance));
+                const size_t      offset          = static_cast<size_t>(field_instance - root);
+
+                if (field.isArrayType())
+                {
+                    SnapshotOp op;
+                    op.m_type   = SnapshotOpType::array;
+                    op.m_offset = offset;
+                    if (field.getArrayAccessor(op.m_array_accessor) && resolveElementType(op))
+                    {
+                        ops.push_back(op);
+                    }
+                    continue;
+                }
+
+                const size_t primitive_size = getPrimitiveSize(field_type_name);
+                if (primitive_size > 0)
+                {
+                    appendCopy(ops, offset, primitive_size);
+                }
+                else if (isStringType(field_type_name))
+                {
+                    SnapshotOp op;
+                    op.m_type   = SnapshotOpType::string;
+                    op.m_offset = offset;
+                    ops.push_back(op);
+                }
+                else if (Reflection::isReflectionPtrType(field_type_name))
+                {
+                    SnapshotOp op;
+                    op.m_type   = SnapshotOpType::pointer;
+                    op.m_offset = offset;
+                    ops.push_back(op);
+                }
+                else
+                {
+                    // raw pointers and enums have no meta, they are not part of the snapshot
+                    Reflection::TypeMeta field_meta;
+                    if (field.getTypeMeta(field_meta))
+                    {
+                        appendTypeOps(field_meta, field_instance, root, ops);
+                    }
+                }
+            }
+        }
+
+        // compiled layouts are never freed, the snapshots point to them
+        const LevelSnapshot::Layout* getLayout(const std::string& type_name, void* instance)
+        {
+            thread_local std::unordered_map<std::string, const LevelSnapshot::Layout*> thread_layouts;
+
+            auto iter = thread_layouts.find(type_name);
+            if (iter != thread_layouts.end())
+            {
+                return iter->second;
+            }
+
+            static std::mutex                                                              s_layout_mutex;
+            static std::unordered_map<std::string, std::unique_ptr<LevelSnapshot::Layout>> s_layouts;
+
+            const LevelSnapshot::Layout* layout = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(s_layout_mutex);
+
+                std::unique_ptr<LevelSnapshot::Layout>& compiled_layout = s_layouts[type_name];
+                if (!compiled_layout)
+                {
+                    compiled_layout = std::make_unique<LevelSnapshot::Layout>();
+                    appendTypeOps(Reflection::TypeMeta::getMetaFromName(type_name),
+                                  instance,
+                                  static_cast<uint8_t*>(instance),
+                                  compiled_layout->m_ops);
+                }
+                layout = compiled_layout.get();
+            }
+            thread_layouts.emplace(type_name, layout);
+            return layout;
+        }
+
+        void writeBytes(std::vector<uint8_t>& data, const void* bytes, size_t size)
+        {
+            const uint8_t* first = static_cast<const uint8_t*>(bytes);
+            data.insert(data.end(), first, first + size);
+        }
+
+        template<typename T>
+        void writeValue(std::vector<uint8_t>& data, const T& value)
+        {
+            writeBytes(data, &value, sizeof(T));
+        }
+
+        void writeString(std::vector<uint8_t>& data, const std::string& value)
+        {
+            writeValue(data, static_cast<uint32_t>(value.size()));
+            writeBytes(data, value.data(), value.size());
+        }
+
+        struct SnapshotReader
+        {
+            const uint8_t* m_cursor {nullptr};
+            const uint8_t* m_end {nullptr};
+
+            const uint8_t* read(size_t size)
+            {
+                ASSERT(m_cursor + size <= m_end);
+                const uint8_t* bytes = m_cursor;
+                m_cursor += size;
+                return bytes;
+            }
+
+            template<typename T>
+            T readValue()
+            {
+                T value;
+                std::memcpy(&value, read(sizeof(T)), sizeof(T));
+                return value;
+            }
+        };
+
+        void captureFields(const LevelSnapshot::Layout& layout, uint8_t* instance, std::vector<uint8_t>& data);
+        void restoreFields(const LevelSnapshot::Layout& layout, uint8_t* instance, SnapshotReader& reader);
+
+        // the layout of the pointee, null for a null pointer, then its fields
+        void capturePointer(const Reflection::ErasedReflectionPtr& pointer, std::vector<uint8_t>& data)
+        {
+            const LevelSnapshot::Layout* layout =
+                pointer ? getLayout(pointer.getTypeName(), pointer.getPtr()) : nullptr;
+            writeValue(data, layout);
+            if (layout)
+            {
+                captureFields(*layout, reinterpret_cast<uint8_t*>(pointer.getPtr()), data);
+            }
+        }
+
+        // pointer is null to skip the pointee in the reader. A pointee replaced by another type since the capture is
+        // skipped as well, restore does not create objects
+        void restorePointer(const Reflection::ErasedReflectionPtr* pointer, SnapshotReader& reader)
+        {
+            const LevelSnapshot::Layout* layout = reader.readValue<const LevelSnapshot::Layout*>();
+            if (layout == nullptr)
+                return;
+
+            uint8_t* pointee = nullptr;
+            if (pointer && *pointer && getLayout(pointer->getTypeName(), pointer->getPtr()) == layout)
+            {
+                pointee = reinterpret_cast<uint8_t*>(pointer->getPtr());
+            }
+            restoreFields(*layout, pointee, reader);
+        }
+
+        void captureElement(const SnapshotOp& op, void* element, std::vector<uint8_t>& data)
+        {
+            switch (op.m_element_type)
+            {
+                case SnapshotOpType::copy:
+                    writeBytes(data, element, op.m_element_size);
+                    break;
+                case SnapshotOpType::string:
+                    writeString(data, *static_cast<const std::string*>(element));
+                    break;
+                case SnapshotOpType::object:
+                {
+                    SnapshotElementLayout& element_layout = *op.m_element_layout;
+                    std::call_once(element_layout.m_once_flag, [&op, &element_layout, element]() {
+                        element_layout.m_layout = getLayout(op.m_element_type_name, element);
+                    });
+                    captureFields(*element_layout.m_layout, static_cast<uint8_t*>(element), data);
+                    break;
+                }
+                case SnapshotOpType::pointer:
+                    capturePointer(*static_cast<const Reflection::ErasedReflectionPtr*>(element), data);
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        // element is null to skip the element in the reader
+        void restoreElement(const SnapshotOp& op, void* element, SnapshotReader& reader)
+        {
+            switch (op.m_element_type)
+            {
+                case SnapshotOpType::copy:
+                {
+                    const uint8_t* bytes = reader.read(op.m_element_size);
+                    if (element)
+                    {
+                        std::memcpy(element, bytes, op.m_element_size);
+                    }
+                    break;
+                }
+                case SnapshotOpType::string:
+                {
+                    const uint32_t length = reader.readValue<uint32_t>();
+                    const char*    chars  = reinterpret_cast<const char*>(reader.read(length));
+                    if (element)
+                    {
+                        static_cast<std::string*>(element)->assign(chars, length);
+                    }
+                    break;
+                }
+                case SnapshotOpType::object:
+                    // an element was captured, so its layout is known
+                    ASSERT(op.m_element_layout->m_layout);
+                    restoreFields(*op.m_element_layout->m_layout, static_cast<uint8_t*>(element), reader);
+                    break;
+                case SnapshotOpType::pointer:
+                    restorePointer(static_cast<const Reflection::ErasedReflectionPtr*>(element), reader);
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        void captureFields(const LevelSnapshot::Layout& layout, uint8_t* instance, std::vector<uint8_t>& data)
+        {
+            for (const SnapshotOp& op : layout.m_ops)
+            {
+                uint8_t* field = instance + op.m_offset;
+                switch (op.m_type)
+                {
+                    case SnapshotOpType::copy:
+                        writeBytes(data, field, op.m_size);
+                        break;
+                    case SnapshotOpType::string:
+                        writeString(data, *reinterpret_cast<const std::string*>(field));
+                        break;
+                    case SnapshotOpType::pointer:
+                        capturePointer(*reinterpret_cast<const Reflection::ErasedReflectionPtr*>(field), data);
+                        break;
+                    case SnapshotOpType::array:
+                    {
+                        const int element_count = op.m_array_accessor.getSize(field);
+                        writeValue(data, static_cast<uint32_t>(element_count));
+                        for (int element_index = 0; element_index < element_count; ++element_index)
+                        {
+                            captureElement(op, op.m_array_accessor.get(element_index, field), data);
+                        }
+                        break;
+                    }
+                    default:
+                        break;
+                }
+            }
+        }
+
+        // instance is null to skip the fields in the reader
+        void restoreFields(const LevelSnapshot::Layout& layout, uint8_t* instance, SnapshotReader& reader)
+        {
+            for (const SnapshotOp& op : layout.m_ops)
+            {
+                uint8_t* field = instance ? instance + op.m_offset : nullptr;
+                switch (op.m_type)
+                {
+                    case SnapshotOpType::copy:
+                    {
+                        const uint8_t* bytes = reader.read(op.m_size);
+                        if (field)
+                        {
+                            std::memcpy(field, bytes, op.m_size);
+                        }
+                        break;
+                    }
+                    case SnapshotOpType::string:
+                    {
+                        const uint32_t length = reader.readValue<uint32_t>();
+                        const char*    chars  = reinterpret_cast<const char*>(reader.read(length));
+                        if (field)
+                        {
+                            reinterpret_cast<std::string*>(field)->assign(chars, length);
+                        }
+                        break;
+                    }
+                    case SnapshotOpType::pointer:
+                        restorePointer(reinterpret_cast<const Reflection::ErasedReflectionPtr*>(field), reader);
+                        break;
+                    case SnapshotOpType::array:
+                    {
+                        // the accessors cannot resize, the elements past the current size are skipped
+                        const uint32_t element_count = reader.readValue<uint32_t>();
+                        const uint32_t live_count =
+                            field ? static_cast<uint32_t>(op.m_array_accessor.getSize(field)) : 0;
+                        for (uint32_t element_index = 0; element_index < element_count; ++element_index)
+                        {
+                            void* element = element_index < live_count ?
+                                                op.m_array_accessor.get(static_cast<int>(element_index), field) :
+                                                nullptr;
+                            restoreElement(op, element, reader);
+                        }
+                        break;
+                    }
+                    default:
+                        break;
+                }
+            }
+        }
+    } // namespace
+
+    void LevelSnapshot::capture(const Level& level)
+    {
+        PROFILE_SCOPE("LevelSnapshot::capture");
+
+        clear();
+        for (const std::shared_ptr<GObject>& object : level.getAllGObjects())
+        {
+            if (object == nullptr)
+                continue;
+
+            const std::vector<Reflection::ReflectionPtr<Component>>& components = object->getComponents();
+            writeValue(m_data, object->getID());
+            writeValue(m_data, static_cast<uint32_t>(components.size()));
+
+            for (const Reflection::ReflectionPtr<Component>& component : components)
+            {
+                // the reflection instance is the component itself, not a base class sub-object
+                void*         instance = component.getPtr();
+                const Layout* layout   = instance ? getLayout(component.getTypeName(), instance) : nullptr;
+
+                // the size lets restore skip the components it cannot match
+                const size_t size_offset = m_data.size();
+                writeValue(m_data, uint32_t {0});
+                if (layout)
+                {
+                    captureFields(*layout, static_cast<uint8_t*>(instance), m_data);
+                }
+                const uint32_t block_size = static_cast<uint32_t>(m_data.size() - size_offset - sizeof(uint32_t));
+                std::memcpy(m_data.data() + size_offset, &block_size, sizeof(block_size));
+
+                m_component_layouts.push_back(layout);
+            }
+        }
+    }
+
+    void LevelSnapshot::restore(Level& level) const
+    {
+        PROFILE_SCOPE("LevelSnapshot::restore");
+
+        SnapshotReader reader {m_data.data(), m_data.data() + m_data.size()};
+        size_t         layout_index = 0;
+        while (reader.m_cursor < reader.m_end)
+        {
+            const GObjectID object_id       = reader.readValue<GObjectID>();
+            const uint32_t  component_count = reader.readValue<uint32_t>();
+
+            // the generation of the id fails the lookup if the object was deleted, even if its slot is reused
+            std::shared_ptr<GObject> object = level.getGObjectByID(object_id).lock();
+
+            for (uint32_t component_index = 0; component_index < component_count; ++component_index, ++layout_index)
+            {
+                const uint32_t block_size = reader.readValue<uint32_t>();
+                const uint8_t* block_end  = reader.m_cursor + block_size;
+                const Layout*  layout     = m_component_layouts[layout_index];
+
+                Component* component = nullptr;
+                if (object && layout && component_index < object->getComponents().size())
+                {
+                    const Reflection::ReflectionPtr<Component>& live_component =
+                        object->getComponents()[component_index];
+                    if (live_component && getLayout(live_component.getTypeName(), live_component.getPtr()) == layout)
+                    {
+                        component = live_component.getPtr();
+                    }
+                }
+
+                if (component)
+                {
+                    restoreFields(*layout, static_cast<uint8_t*>(static_cast<void*>(component)), reader);
+                    ASSERT(reader.m_cursor == block_end);
+                    component->markSaveDirty();
+                    component->postRestoreState();
+                }
+                reader.m_cursor = block_end;
+            }
+        }
+    }
+
+    uint64_t LevelSnapshot::hashObjectFields(const GObject& object)
+    {
+        thread_local std::vector<uint8_t> s_field_data;
+        s_field_data.clear();
+
+        for (const Reflection::ReflectionPtr<Component>& component : object.getComponents())
+        {
+            void*         instance = component.getPtr();
+            const Layout* layout   = instance ? getLayout(component.getTypeName(), instance) : nullptr;
+            // the layout tells the component types apart
+            writeValue(s_field_data, layout);
+            if (layout)
+            {
+                captureFields(*layout, static_cast<uint8_t*>(instance), s_field_data);
+            }
+        }
+
+        // FNV-1a
+        uint64_t hash = 14695981039346656037ull;
+        for (const uint8_t byte : s_field_data)
+        {
+            hash = (hash ^ byte) * 1099511628211ull;
+        }
+        return hash;
+    }
+
+    void LevelSnapshot::clear()
+    {
+        // keep the capacity, the next capture is about the same size
+        m_data.clear();
+        m_component_layouts.clear();
+    }
+} // namespace Pilot
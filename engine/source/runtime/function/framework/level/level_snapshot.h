@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Pilot
+{
+    class GObject;
+    class Level;
+
+    /// In memory binary copy of the reflected fields of all components of a level.
+    /// The fields are read through layouts compiled once per type from the reflection accessors, trivially copyable
+    /// fields next to each other are copied in one go. The buffers are reused, so a snapshot can be captured every
+    /// frame for rewind, replay or rollback. Capture and restore from the thread ticking the level.
+    /// The objects behind ReflectionPtr fields are followed and recorded with the layout of their dynamic type.
+    /// Not covered: fields that are not reflected, raw pointers and enums, and the state kept outside the components
+    /// such as the physics bodies. A component rebuilds what it derives from its fields in postRestoreState.
+    class LevelSnapshot
+    {
+    public:
+        struct Layout;
+
+        // overwrite the snapshot with the current state of the level
+        void capture(const Level& level);
+        // write the state back into the objects, without creating or deleting any
+        // objects created since the capture are left untouched, arrays keep their current size
+        void restore(Level& level) const;
+
+        void clear();
+
+        // hash of the reflected fields of the components of an object, read with the same layouts as a capture
+        static uint64_t hashObjectFields(const GObject& object);
+
+        bool   isEmpty() const { return m_data.empty(); }
+        size_t getByteSize() const { return m_data.size(); }
+
+    private:
+        // per object: id, component count, then per component: byte size and fields
+        std::vector<uint8_t> m_data;
+        // layout of every component in m_data, in the same order
+        std::vector<const Layout*> m_component_layouts;
+    };
+} // namespace Pilot
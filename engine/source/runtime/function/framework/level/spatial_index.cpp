@@ -0,0 +1,561 @@
+#include "runtime/function/framework/level/spatial_index.h"
+
+#include "runtime/core/base/frame_allocator.h"
+#include "runtime/core/base/macro.h"
+
+#include "runtime/function/physics/ray.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace Pilot
+{
+    // enlargement of the leaf bounds, an object moving less than it stays in its leaf
+    static constexpr float k_bounds_margin = 0.2f;
+
+    namespace
+    {
+        template<typename TBounds>
+        TBounds combine(const TBounds& lhs, const TBounds& rhs)
+        {
+            TBounds result {lhs.m_min, lhs.m_max};
+            result.m_min.makeFloor(rhs.m_min);
+            result.m_max.makeCeil(rhs.m_max);
+            return result;
+        }
+
+        // half the surface area, the cost of a node in the insertion heuristic
+        template<typename TBounds>
+        float getPerimeter(const TBounds& bounds)
+        {
+            const Vector3 extent = bounds.m_max - bounds.m_min;
+            return extent.x * extent.y + extent.y * extent.z + extent.z * extent.x;
+        }
+
+        template<typename TBounds>
+        bool encloses(const TBounds& outer, const TBounds& inner)
+        {
+            return outer.m_min.x <= inner.m_min.x && outer.m_min.y <= inner.m_min.y &&
+                   outer.m_min.z <= inner.m_min.z && inner.m_max.x <= outer.m_max.x &&
+                   inner.m_max.y <= outer.m_max.y && inner.m_max.z <= outer.m_max.z;
+        }
+
+        bool overlapsBox(const Vector3& min_a, const Vector3& max_a, const Vector3& min_b, const Vector3& max_b)
+        {
+            return min_a.x <= max_b.x && min_b.x <= max_a.x && min_a.y <= max_b.y && min_b.y <= max_a.y &&
+                   min_a.z <= max_b.z && min_b.z <= max_a.z;
+        }
+
+        bool overlapsSphere(const Vector3& min, const Vector3& max, const Vector3& center, float radius)
+        {
+            // distance from the center to the closest point of the box
+            Vector3 closest_point = center;
+            closest_point.makeCeil(min);
+            closest_point.makeFloor(max);
+            return closest_point.squaredDistance(center) <= radius * radius;
+        }
+
+        // distance along the ray where it enters the box, false if it misses it before max_distance
+        bool intersectRay(const Vector3& min,
+                          const Vector3& max,
+                          const Vector3& origin,
+                          const Vector3& inverse_direction,
+                          float          max_distance,
+                          float&         out_distance)
+        {
+            float t_enter = 0.f;
+            float t_exit  = max_distance;
+            for (size_t axis = 0; axis < 3; ++axis)
+            {
+                float t0 = (min[axis] - origin[axis]) * inverse_direction[axis];
+                float t1 = (max[axis] - origin[axis]) * inverse_direction[axis];
+                if (t0 > t1)
+                {
+                    std::swap(t0, t1);
+                }
+                // a nan, from a ray parallel to a slab starting on its border, leaves the range as it is
+                t_enter = t0 > t_enter ? t0 : t_enter;
+                t_exit  = t1 < t_exit ? t1 : t_exit;
+                if (t_enter > t_exit)
+                {
+                    return false;
+                }
+            }
+            out_distance = t_enter;
+            return true;
+        }
+    } // namespace
+
+    const SpatialIndex::ObjectProxy* SpatialIndex::findProxy(GObjectID object_id) const
+    {
+        const uint32_t slot_index = ObjectIDAllocator::getSlotIndex(object_id);
+        if (object_id == k_invalid_gobject_id || slot_index >= m_proxies.size() ||
+            m_proxies[slot_index].m_object_id != object_id)
+        {
+            return nullptr;
+        }
+        return &m_proxies[slot_index];
+    }
+
+    SpatialIndex::ObjectProxy* SpatialIndex::findProxy(GObjectID object_id)
+    {
+        return const_cast<ObjectProxy*>(static_cast<const SpatialIndex*>(this)->findProxy(object_id));
+    }
+
+    SpatialIndex::Bounds SpatialIndex::transformBounds(const Bounds& local_bounds, const Matrix4x4& world_matrix)
+    {
+        // bounds of the transformed box, from its center and the absolute matrix applied to its half extent
+        const Vector3 local_center      = 0.5f * (local_bounds.m_min + local_bounds.m_max);
+        const Vector3 local_half_extent = 0.5f * (local_bounds.m_max - local_bounds.m_min);
+        const Vector3 world_center      = world_matrix.transformAffine(local_center);
+
+        Vector3 world_half_extent;
+        for (size_t row = 0; row < 3; ++row)
+        {
+            world_half_extent[row] = std::fabs(world_matrix[row][0]) * local_half_extent.x +
+                                     std::fabs(world_matrix[row][1]) * local_half_extent.y +
+                                     std::fabs(world_matrix[row][2]) * local_half_extent.z;
+        }
+        return {world_center - world_half_extent, world_center + world_half_extent};
+    }
+
+    void SpatialIndex::addObject(GObjectID object_id, const AxisAlignedBox* local_bounds, const Matrix4x4& world_matrix)
+    {
+        ASSERT(object_id != k_invalid_gobject_id);
+
+        const uint32_t slot_index = ObjectIDAllocator::getSlotIndex(object_id);
+        if (slot_index >= m_proxies.size())
+        {
+            m_proxies.resize(slot_index + 1);
+        }
+
+        ObjectProxy& proxy = m_proxies[slot_index];
+        if (proxy.m_object_id != k_invalid_gobject_id)
+        {
+            // the previous object of the slot is gone, its leaf is reused
+            removeObject(proxy.m_object_id);
+        }
+
+        proxy.m_object_id = object_id;
+        if (local_bounds)
+        {
+            proxy.m_local_bounds = {local_bounds->getMinCorner(), local_bounds->getMaxCorner()};
+        }
+        else
+        {
+            proxy.m_local_bounds = {Vector3::ZERO, Vector3::ZERO};
+        }
+
+        proxy.m_world_bounds = transformBounds(proxy.m_local_bounds, world_matrix);
+
+        const Vector3 margin(k_bounds_margin, k_bounds_margin, k_bounds_margin);
+        proxy.m_leaf                      = allocateNode();
+        m_nodes[proxy.m_leaf].m_height    = 0;
+        m_nodes[proxy.m_leaf].m_object_id = object_id;
+        m_nodes[proxy.m_leaf].m_bounds    = {proxy.m_world_bounds.m_min - margin, proxy.m_world_bounds.m_max + margin};
+        insertLeaf(proxy.m_leaf);
+
+        ++m_object_count;
+    }
+
+    void SpatialIndex::removeObject(GObjectID object_id)
+    {
+        ObjectProxy* proxy = findProxy(object_id);
+        if (proxy == nullptr)
+            return;
+
+        removeLeaf(proxy->m_leaf);
+        freeNode(proxy->m_leaf);
+
+        *proxy = ObjectProxy();
+        --m_object_count;
+    }
+
+    void SpatialIndex::updateObject(GObjectID object_id, const Matrix4x4& world_matrix)
+    {
+        ObjectProxy* proxy = findProxy(object_id);
+        if (proxy == nullptr)
+            return;
+
+        proxy->m_world_bounds = transformBounds(proxy->m_local_bounds, world_matrix);
+
+        TreeNode& leaf_node = m_nodes[proxy->m_leaf];
+        if (encloses(leaf_node.m_bounds, proxy->m_world_bounds))
+            return;
+
+        const int32_t leaf = proxy->m_leaf;
+        removeLeaf(leaf);
+        const Vector3 margin(k_bounds_margin, k_bounds_margin, k_bounds_margin);
+        m_nodes[leaf].m_bounds = {proxy->m_world_bounds.m_min - margin, proxy->m_world_bounds.m_max + margin};
+        insertLeaf(leaf);
+    }
+
+    void SpatialIndex::clear()
+    {
+        m_nodes.clear();
+        m_proxies.clear();
+        m_root         = k_null_node;
+        m_free_list    = k_null_node;
+        m_object_count = 0;
+    }
+
+    bool SpatialIndex::contains(GObjectID object_id) const { return findProxy(object_id) != nullptr; }
+
+    bool SpatialIndex::getWorldBounds(GObjectID object_id, AxisAlignedBox& out_bounds) const
+    {
+        const ObjectProxy* proxy = findProxy(object_id);
+        if (proxy == nullptr)
+            return false;
+
+        out_bounds.update(0.5f * (proxy->m_world_bounds.m_min + proxy->m_world_bounds.m_max),
+                          0.5f * (proxy->m_world_bounds.m_max - proxy->m_world_bounds.m_min));
+        return true;
+    }
+
+    template<typename TOverlaps, typename TVisit>
+    void SpatialIndex::walk(TOverlaps&& overlaps, TVisit&& visit) const
+    {
+        if (m_root == k_null_node)
+            return;
+
+        FrameVector<int32_t> stack;
+        stack.reserve(64);
+        stack.push_back(m_root);
+        while (!stack.empty())
+        {
+            const TreeNode& node = m_nodes[stack.back()];
+            stack.pop_back();
+
+            if (!overlaps(node.m_bounds.m_min, node.m_bounds.m_max))
+                continue;
+
+            if (node.isLeaf())
+            {
+                visit(m_proxies[ObjectIDAllocator::getSlotIndex(node.m_object_id)]);
+            }
+            else
+            {
+                stack.push_back(node.m_children[0]);
+                stack.push_back(node.m_children[1]);
+            }
+        }
+    }
+
+    void SpatialIndex::queryBox(const AxisAlignedBox& box, std::vector<GObjectID>& out_object_ids) const
+    {
+        const Vector3& box_min = box.getMinCorner();
+        const Vector3& box_max = box.getMaxCorner();
+        walk([&box_min, &box_max](const Vector3& min,
+                                  const Vector3& max) { return overlapsBox(min, max, box_min, box_max); },
+             [&box_min, &box_max, &out_object_ids](const ObjectProxy& proxy) {
+                 if (overlapsBox(proxy.m_world_bounds.m_min, proxy.m_world_bounds.m_max, box_min, box_max))
+                 {
+                     out_object_ids.push_back(proxy.m_object_id);
+                 }
+             });
+    }
+
+    void SpatialIndex::queryRadius(const Vector3& center, float radius, std::vector<GObjectID>& out_object_ids) const
+    {
+        walk([&center, radius](const Vector3& min,
+                               const Vector3& max) { return overlapsSphere(min, max, center, radius); },
+             [&center, radius, &out_object_ids](const ObjectProxy& proxy) {
+                 if (overlapsSphere(proxy.m_world_bounds.m_min, proxy.m_world_bounds.m_max, center, radius))
+                 {
+                     out_object_ids.push_back(proxy.m_object_id);
+                 }
+             });
+    }
+
+    void SpatialIndex::queryRay(const Ray& ray, float max_distance, std::vector<GObjectID>& out_object_ids) const
+    {
+        const Vector3 origin    = ray.getStartPoint();
+        const Vector3 direction = ray.getDirection().normalisedCopy();
+        const Vector3 inverse_direction(1.f / direction.x, 1.f / direction.y, 1.f / direction.z);
+
+        FrameVector<std::pair<float, GObjectID>> hits;
+        walk(
+            [&origin, &inverse_direction, max_distance](const Vector3& min, const Vector3& max) {
+                float distance;
+                return intersectRay(min, max, origin, inverse_direction, max_distance, distance);
+            },
+            [&origin, &inverse_direction, max_distance, &hits](const ObjectProxy& proxy) {
+                float distance;
+                if (intersectRay(proxy.m_world_bounds.m_min,
+                                 proxy.m_world_bounds.m_max,
+                                 origin,
+                                 inverse_direction,
+                                 max_distance,
+                                 distance))
+                {
+                    hits.emplace_back(distance, proxy.m_object_id);
+                }
+            });
+
+        std::sort(hits.begin(), hits.end());
+        for (const std::pair<float, GObjectID>& hit : hits)
+        {
+            out_object_ids.push_back(hit.second);
+        }
+    }
+
+    int32_t SpatialIndex::allocateNode()
+    {
+        if (m_free_list == k_null_node)
+        {
+            m_nodes.emplace_back();
+            return static_cast<int32_t>(m_nodes.size() - 1);
+        }
+
+        const int32_t node_index = m_free_list;
+        m_free_list              = m_nodes[node_index].m_next_free;
+        m_nodes[node_index]      = TreeNode();
+        return node_index;
+    }
+
+    void SpatialIndex::freeNode(int32_t node_index)
+    {
+        m_nodes[node_index].m_height    = -1;
+        m_nodes[node_index].m_next_free = m_free_list;
+        m_free_list                     = node_index;
+    }
+
+    void SpatialIndex::insertLeaf(int32_t leaf)
+    {
+        if (m_root == k_null_node)
+        {
+            m_root                 = leaf;
+            m_nodes[leaf].m_parent = k_null_node;
+            return;
+        }
+
+        // descend to the sibling with the lowest cost, the surface area heuristic of the dynamic aabb trees
+        const Bounds leaf_bounds = m_nodes[leaf].m_bounds;
+        int32_t      index       = m_root;
+        while (!m_nodes[index].isLeaf())
+        {
+            const TreeNode& node = m_nodes[index];
+
+            const float area          = getPerimeter(node.m_bounds);
+            const float combined_area = getPerimeter(combine(node.m_bounds, leaf_bounds));
+
+            // cost of a new parent for this node and the leaf
+            const float cost = 2.f * combined_area;
+            // cost pushed down to the children
+            const float inheritance_cost = 2.f * (combined_area - area);
+
+            float child_costs[2];
+            for (size_t child = 0; child < 2; ++child)
+            {
+                const TreeNode& child_node = m_nodes[node.m_children[child]];
+                const float     new_area   = getPerimeter(combine(child_node.m_bounds, leaf_bounds));
+                child_costs[child] =
+                    (child_node.isLeaf() ? new_area : new_area - getPerimeter(child_node.m_bounds)) + inheritance_cost;
+            }
+
+            if (cost < child_costs[0] && cost < child_costs[1])
+                break;
+
+            index = child_costs[0] < child_costs[1] ? node.m_children[0] : node.m_children[1];
+        }
+
+        const int32_t sibling    = index;
+        const int32_t old_parent = m_nodes[sibling].m_parent;
+        const int32_t new_parent = allocateNode();
+
+        m_nodes[new_parent].m_parent      = old_parent;
+        m_nodes[new_parent].m_bounds      = combine(leaf_bounds, m_nodes[sibling].m_bounds);
+        m_nodes[new_parent].m_height      = m_nodes[sibling].m_height + 1;
+        m_nodes[new_parent].m_children[0] = sibling;
+        m_nodes[new_parent].m_children[1] = leaf;
+        m_nodes[sibling].m_parent         = new_parent;
+        m_nodes[leaf].m_parent            = new_parent;
+
+        if (old_parent == k_null_node)
+        {
+            m_root = new_parent;
+        }
+        else if (m_nodes[old_parent].m_children[0] == sibling)
+        {
+            m_nodes[old_parent].m_children[0] = new_parent;
+        }
+        else
+        {
+            m_nodes[old_parent].m_children[1] = new_parent;
+        }
+
+        // refit and rebalance the ancestors
+        index = m_nodes[leaf].m_parent;
+        while (index != k_null_node)
+        {
+            index = balance(index);
+
+            TreeNode&       node    = m_nodes[index];
+            const TreeNode& child_0 = m_nodes[node.m_children[0]];
+            const TreeNode& child_1 = m_nodes[node.m_children[1]];
+            node.m_height           = 1 + std::max(child_0.m_height, child_1.m_height);
+            node.m_bounds           = combine(child_0.m_bounds, child_1.m_bounds);
+
+            index = node.m_parent;
+        }
+    }
+
+    void SpatialIndex::removeLeaf(int32_t leaf)
+    {
+        if (leaf == m_root)
+        {
+            m_root = k_null_node;
+            return;
+        }
+
+        const int32_t parent       = m_nodes[leaf].m_parent;
+        const int32_t grand_parent = m_nodes[parent].m_parent;
+        const int32_t sibling =
+            m_nodes[parent].m_children[0] == leaf ? m_nodes[parent].m_children[1] : m_nodes[parent].m_children[0];
+
+        if (grand_parent == k_null_node)
+        {
+            m_root                    = sibling;
+            m_nodes[sibling].m_parent = k_null_node;
+            freeNode(parent);
+            return;
+        }
+
+        // the sibling takes the place of the parent
+        if (m_nodes[grand_parent].m_children[0] == parent)
+        {
+            m_nodes[grand_parent].m_children[0] = sibling;
+        }
+        else
+        {
+            m_nodes[grand_parent].m_children[1] = sibling;
+        }
+        m_nodes[sibling].m_parent = grand_parent;
+        freeNode(parent);
+
+        int32_t index = grand_parent;
+        while (index != k_null_node)
+        {
+            index = balance(index);
+
+            TreeNode&       node    = m_nodes[index];
+            const TreeNode& child_0 = m_nodes[node.m_children[0]];
+            const TreeNode& child_1 = m_nodes[node.m_children[1]];
+            node.m_height           = 1 + std::max(child_0.m_height, child_1.m_height);
+            node.m_bounds           = combine(child_0.m_bounds, child_1.m_bounds);
+
+            index = node.m_parent;
+        }
+    }
+
+    int32_t SpatialIndex::balance(int32_t index_a)
+    {
+        // rotate the higher child up when the heights of the children differ by more than one
+        TreeNode& a = m_nodes[index_a];
+        if (a.isLeaf() || a.m_height < 2)
+            return index_a;
+
+        const int32_t index_b = a.m_children[0];
+        const int32_t index_c = a.m_children[1];
+        TreeNode&     b       = m_nodes[index_b];
+        TreeNode&     c       = m_nodes[index_c];
+
+        const int32_t height_difference = c.m_height - b.m_height;
+        if (height_difference > 1)
+        {
+            // c goes up, a takes the lower child of c
+            const int32_t index_f = c.m_children[0];
+            const int32_t index_g = c.m_children[1];
+            TreeNode&     f       = m_nodes[index_f];
+            TreeNode&     g       = m_nodes[index_g];
+
+            c.m_children[0] = index_a;
+            c.m_parent      = a.m_parent;
+            a.m_parent      = index_c;
+            if (c.m_parent == k_null_node)
+            {
+                m_root = index_c;
+            }
+            else if (m_nodes[c.m_parent].m_children[0] == index_a)
+            {
+                m_nodes[c.m_parent].m_children[0] = index_c;
+            }
+            else
+            {
+                m_nodes[c.m_parent].m_children[1] = index_c;
+            }
+
+            if (f.m_height > g.m_height)
+            {
+                c.m_children[1] = index_f;
+                a.m_children[1] = index_g;
+                g.m_parent      = index_a;
+                a.m_bounds      = combine(b.m_bounds, g.m_bounds);
+                c.m_bounds      = combine(a.m_bounds, f.m_bounds);
+                a.m_height      = 1 + std::max(b.m_height, g.m_height);
+                c.m_height      = 1 + std::max(a.m_height, f.m_height);
+            }
+            else
+            {
+                c.m_children[1] = index_g;
+                a.m_children[1] = index_f;
+                f.m_parent      = index_a;
+                a.m_bounds      = combine(b.m_bounds, f.m_bounds);
+                c.m_bounds      = combine(a.m_bounds, g.m_bounds);
+                a.m_height      = 1 + std::max(b.m_height, f.m_height);
+                c.m_height      = 1 + std::max(a.m_height, g.m_height);
+            }
+            return index_c;
+        }
+
+        if (height_difference < -1)
+        {
+            // b goes up, a takes the lower child of b
+            const int32_t index_d = b.m_children[0];
+            const int32_t index_e = b.m_children[1];
+            TreeNode&     d       = m_nodes[index_d];
+            TreeNode&     e       = m_nodes[index_e];
+
+            b.m_children[0] = index_a;
+            b.m_parent      = a.m_parent;
+            a.m_parent      = index_b;
+            if (b.m_parent == k_null_node)
+            {
+                m_root = index_b;
+            }
+            else if (m_nodes[b.m_parent].m_children[0] == index_a)
+            {
+                m_nodes[b.m_parent].m_children[0] = index_b;
+            }
+            else
+            {
+                m_nodes[b.m_parent].m_children[1] = index_b;
+            }
+
+            if (d.m_height > e.m_height)
+            {
+                b.m_children[1] = index_d;
+                a.m_children[0] = index_e;
+                e.m_parent      = index_a;
+                a.m_bounds      = combine(c.m_bounds, e.m_bounds);
+                b.m_bounds      = combine(a.m_bounds, d.m_bounds);
+                a.m_height      = 1 + std::max(c.m_height, e.m_height);
+                b.m_height      = 1 + std::max(a.m_height, d.m_height);
+            }
+            else
+            {
+                b.m_children[1] = index_e;
+                a.m_children[0] = index_d;
+                d.m_parent      = index_a;
+                a.m_bounds      = combine(c.m_bounds, d.m_bounds);
+                b.m_bounds      = combine(a.m_bounds, e.m_bounds);
+                a.m_height      = 1 + std::max(c.m_height, d.m_height);
+                b.m_height      = 1 + std::max(a.m_height, e.m_height);
+            }
+            return index_b;
+        }
+
+        return index_a;
+    }
+} // namespace Pilot
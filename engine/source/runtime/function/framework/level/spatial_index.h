@@ -0,0 +1,98 @@
+#pragma once
+
+#include "runtime/core/math/axis_aligned.h"
+#include "runtime/core/math/matrix4.h"
+#include "runtime/core/math/vector3.h"
+
+#include "runtime/function/framework/object/object_id_allocator.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Pilot
+{
+    class Ray;
+
+    /// Dynamic bounding volume hierarchy of the objects of a level.
+    /// Every object is a leaf holding its world bounds enlarged by a margin, so small moves do not touch the tree.
+    /// The tree is kept balanced with rotations, queries walk it in logarithmic time. It is updated by the level
+    /// before the components tick, query it from the components.
+    class SpatialIndex
+    {
+    public:
+        // bounds in object space, an object without bounds is indexed by its position
+        void addObject(GObjectID object_id, const AxisAlignedBox* local_bounds, const Matrix4x4& world_matrix);
+        void removeObject(GObjectID object_id);
+        // the world matrix of the object changed
+        void updateObject(GObjectID object_id, const Matrix4x4& world_matrix);
+        void clear();
+
+        bool contains(GObjectID object_id) const;
+        // tight world bounds of an object, false if it is not indexed
+        bool getWorldBounds(GObjectID object_id, AxisAlignedBox& out_bounds) const;
+
+        // objects whose bounds intersect the box
+        void queryBox(const AxisAlignedBox& box, std::vector<GObjectID>& out_object_ids) const;
+        // objects whose bounds intersect the sphere
+        void queryRadius(const Vector3& center, float radius, std::vector<GObjectID>& out_object_ids) const;
+        // objects whose bounds the ray enters before max_distance, nearest first
+        void queryRay(const Ray& ray, float max_distance, std::vector<GObjectID>& out_object_ids) const;
+
+        size_t getObjectCount() const { return m_object_count; }
+        // 0 when empty, about log2 of the object count when balanced
+        int32_t getHeight() const { return m_root < 0 ? 0 : m_nodes[m_root].m_height + 1; }
+
+    private:
+        static constexpr int32_t k_null_node = -1;
+
+        struct Bounds
+        {
+            Vector3 m_min;
+            Vector3 m_max;
+        };
+
+        struct TreeNode
+        {
+            Bounds  m_bounds;
+            int32_t m_parent {k_null_node};
+            int32_t m_children[2] {k_null_node, k_null_node};
+            // 0 for a leaf, -1 for a free node
+            int32_t   m_height {-1};
+            GObjectID m_object_id {k_invalid_gobject_id};
+            // link of the free list
+            int32_t m_next_free {k_null_node};
+
+            bool isLeaf() const { return m_children[0] == k_null_node; }
+        };
+
+        // indexed by the slot of the object id
+        struct ObjectProxy
+        {
+            GObjectID m_object_id {k_invalid_gobject_id};
+            int32_t   m_leaf {k_null_node};
+            Bounds    m_local_bounds;
+            Bounds    m_world_bounds;
+        };
+
+        static Bounds transformBounds(const Bounds& local_bounds, const Matrix4x4& world_matrix);
+
+        const ObjectProxy* findProxy(GObjectID object_id) const;
+        ObjectProxy*       findProxy(GObjectID object_id);
+
+        int32_t allocateNode();
+        void    freeNode(int32_t node_index);
+        void    insertLeaf(int32_t leaf);
+        void    removeLeaf(int32_t leaf);
+        int32_t balance(int32_t node_index);
+
+        // call visit(leaf object proxy) for every leaf whose enlarged bounds pass overlaps
+        template<typename TOverlaps, typename TVisit>
+        void walk(TOverlaps&& overlaps, TVisit&& visit) const;
+
+        std::vector<TreeNode>    m_nodes;
+        int32_t                  m_root {k_null_node};
+        int32_t                  m_free_list {k_null_node};
+        std::vector<ObjectProxy> m_proxies;
+        size_t                   m_object_count {0};
+    };
+} // namespace Pilot
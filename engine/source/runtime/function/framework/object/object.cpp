@@ -7,7 +7,11 @@
 #include "runtime/resource/asset_manager/asset_manager.h"
 
 #include "runtime/function/framework/component/component.h"
+#include "runtime/function/framework/component/component_store.h"
 #include "runtime/function/framework/component/transform/transform_component.h"
+#include "runtime/function/framework/level/level.h"
+#include "runtime/function/framework/object/object_definition_cache.h"
+#include "runtime/function/framework/world/world_manager.h"
 #include "runtime/function/global/global_context.h"
 
 #include <cassert>
@@ -17,34 +21,62 @@
 
 namespace Pilot
 {
-    bool shouldComponentTick(std::string component_type_name)
+    GObject::~GObject()
     {
-        if (g_is_editor_mode)
+        // a pooled component gives its slot back to its pool, m_component_store keeps the pool alive until then
+        for (auto& component : m_components)
         {
-            return g_editor_tick_component_types.find(component_type_name) != g_editor_tick_component_types.end();
+            PILOT_REFLECTION_DELETE(component);
         }
-        else
+        m_components.clear();
+
+        // nobody can reach the object anymore, its slot can be reused
+        ObjectIDAllocator::free(m_id);
+    }
+
+    void GObject::wakeComponents()
+    {
+        for (auto& component : m_components)
         {
-            return true;
+            if (component && component->isDormant())
+            {
+                component->setDormant(false);
+            }
         }
     }
 
-    GObject::~GObject()
+    void GObject::wakeTransformDependents()
     {
         for (auto& component : m_components)
         {
-            PILOT_REFLECTION_DELETE(component);
+            if (component && component->isDormant() && component->isWokenByTransform())
+            {
+                component->setDormant(false);
+            }
         }
-        m_components.clear();
     }
 
-    void GObject::tick(float delta_time)
+    bool GObject::isSaveDirty() const
+    {
+        if (m_is_save_dirty)
+            return true;
+
+        for (const auto& component : m_components)
+        {
+            if (component && component->isSaveDirty())
+                return true;
+        }
+        return false;
+    }
+
+    void GObject::clearSaveDirty()
     {
+        m_is_save_dirty = false;
         for (auto& component : m_components)
         {
-            if (shouldComponentTick(component.getTypeName()))
+            if (component)
             {
-                component->tick(delta_time);
+                component->clearSaveDirty();
             }
         }
     }
@@ -62,14 +94,48 @@ namespace Pilot
 
     bool GObject::load(const ObjectInstanceRes& object_instance_res)
     {
-        // clear old components
+        // drop the components of a previous load, a pooled one goes back to its pool
+        for (auto& component : m_components)
+        {
+            PILOT_REFLECTION_DELETE(component);
+        }
         m_components.clear();
 
         setName(object_instance_res.m_name);
 
         // load object instanced components
         m_components = object_instance_res.m_instanced_components;
-        for (auto component : m_components)
+
+        // load object definition components
+        m_definition_url = object_instance_res.m_definition;
+
+        // the definition is parsed once per url, its components are cloned from the prototype
+        std::shared_ptr<const ObjectPrototype> prototype =
+            g_runtime_global_context.m_world_manager->getObjectDefinitionCache().getPrototype(m_definition_url);
+        if (!prototype)
+            return false;
+
+        for (size_t component_index = 0; component_index < prototype->getComponentCount(); ++component_index)
+        {
+            // don't create component if it has been instanced
+            if (hasComponent(prototype->getComponentTypeName(component_index)))
+                continue;
+
+            m_components.push_back(prototype->cloneComponent(component_index));
+        }
+
+        // the components move into their pools before they are set up, no pointer taken by postLoadResource moves
+        std::shared_ptr<Level> level = m_level.lock();
+        if (level && level->getComponentStore())
+        {
+            m_component_store = level->getComponentStore();
+            m_component_store->adoptComponents(m_components);
+        }
+
+        // the components find their siblings by type in postLoadResource, the index holds the final addresses
+        updateComponentTypeIndex();
+
+        for (auto& component : m_components)
         {
             if (component)
             {
@@ -77,28 +143,50 @@ namespace Pilot
             }
         }
 
-        // load object definition components
-        m_definition_url = object_instance_res.m_definition;
+        updateConcurrentTickFlag();
 
-        ObjectDefinitionRes definition_res;
-
-        const bool is_loaded_success = g_runtime_global_context.m_asset_manager->loadAsset(m_definition_url, definition_res);
-        if (!is_loaded_success)
-            return false;
+        return true;
+    }
 
-        for (auto loaded_component : definition_res.m_components)
+    void GObject::updateComponentTypeIndex()
+    {
+        m_component_type_index.clear();
+        for (auto& component : m_components)
         {
-            const std::string type_name = loaded_component.getTypeName();
-            // don't create component if it has been instanced
-            if (hasComponent(type_name))
+            if (!component)
+            {
                 continue;
+            }
 
-            loaded_component->postLoadResource(weak_from_this());
+            const ComponentTypeId type_id = ComponentTypeRegistry::getTypeId(component.getTypeName());
+            if (type_id == k_invalid_component_type_id)
+            {
+                continue;
+            }
 
-            m_components.push_back(loaded_component);
+            if (type_id >= m_component_type_index.size())
+            {
+                m_component_type_index.resize(type_id + 1, nullptr);
+            }
+            // the first one wins, as it did with the linear search
+            if (m_component_type_index[type_id] == nullptr)
+            {
+                m_component_type_index[type_id] = component.getPtr();
+            }
         }
+    }
 
-        return true;
+    void GObject::updateConcurrentTickFlag()
+    {
+        m_can_tick_concurrently = true;
+        for (const auto& component : m_components)
+        {
+            if (component && !component->isPooled() && !component->canTickConcurrently())
+            {
+                m_can_tick_concurrently = false;
+                return;
+            }
+        }
     }
 
     void GObject::save(ObjectInstanceRes& out_object_instance_res)
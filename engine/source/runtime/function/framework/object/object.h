@@ -1,77 +1,105 @@
 #pragma once
 
 #include "runtime/function/framework/component/component.h"
+#include "runtime/function/framework/component/component_type.h"
 #include "runtime/function/framework/object/object_id_allocator.h"
 
 #include "runtime/resource/res_type/common/object.h"
 
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <unordered_set>
 #include <vector>
 
 namespace Pilot
 {
+    class ComponentStore;
+    class Level;
+
     /// GObject : Game Object base class
     class GObject : public std::enable_shared_from_this<GObject>
     {
         typedef std::unordered_set<std::string> TypeNameSet;
 
     public:
-        GObject(GObjectID id) : m_id {id} {}
+        GObject(GObjectID id, std::weak_ptr<Level> level = std::weak_ptr<Level>()) : m_id {id}, m_level {level} {}
         virtual ~GObject();
 
-        virtual void tick(float delta_time);
-
         bool load(const ObjectInstanceRes& object_instance_res);
         void save(ObjectInstanceRes& out_object_instance_res);
 
         GObjectID getID() const { return m_id; }
 
-        void               setName(std::string name) { m_name = name; }
+        // the level owning this object, also valid while the level is still loading
+        std::weak_ptr<Level> getLevel() const { return m_level; }
+
+        void               setName(std::string name)
+        {
+            m_name          = name;
+            m_is_save_dirty = true;
+        }
         const std::string& getName() const { return m_name; }
 
+        // string based lookups are linear, they are meant for the editor
         bool hasComponent(const std::string& compenent_type_name) const;
 
-        std::vector<Reflection::ReflectionPtr<Component>> getComponents() { return m_components; }
+        // the object or one of its components changed since the level last serialized it
+        bool isSaveDirty() const;
+        void clearSaveDirty();
+
+        // the components are ticked by the ComponentTickScheduler of the level, wake up the dormant ones
+        void wakeComponents();
+        // wake the components reading the world matrix, see Component::isWokenByTransform
+        void wakeTransformDependents();
+
+        // all components can tick on a worker thread, see Component::canTickConcurrently()
+        bool canTickConcurrently() const { return m_can_tick_concurrently; }
+
+        const std::vector<Reflection::ReflectionPtr<Component>>& getComponents() const { return m_components; }
+
+        Component* tryGetComponentByTypeId(ComponentTypeId type_id) const
+        {
+            return type_id < m_component_type_index.size() ? m_component_type_index[type_id] : nullptr;
+        }
 
         template<typename TComponent>
-        TComponent* tryGetComponent(const std::string& compenent_type_name)
+        TComponent* tryGetComponent(const char* compenent_type_name)
         {
-            for (auto& component : m_components)
-            {
-                if (component.getTypeName() == compenent_type_name)
-                {
-                    return static_cast<TComponent*>(component.operator->());
-                }
-            }
-
-            return nullptr;
+            const ComponentTypeId type_id = ComponentTypeRegistry::getTypeId<TComponent>(compenent_type_name);
+            return static_cast<TComponent*>(tryGetComponentByTypeId(type_id));
         }
 
         template<typename TComponent>
-        const TComponent* tryGetComponentConst(const std::string& compenent_type_name) const
+        const TComponent* tryGetComponentConst(const char* compenent_type_name) const
         {
-            for (const auto& component : m_components)
-            {
-                if (component.getTypeName() == compenent_type_name)
-                {
-                    return static_cast<const TComponent*>(component.operator->());
-                }
-            }
-            return nullptr;
+            const ComponentTypeId type_id =
+                ComponentTypeRegistry::getTypeId<std::remove_const_t<TComponent>>(compenent_type_name);
+            return static_cast<const TComponent*>(tryGetComponentByTypeId(type_id));
         }
 
 #define tryGetComponent(COMPONENT_TYPE) tryGetComponent<COMPONENT_TYPE>(#COMPONENT_TYPE)
 #define tryGetComponentConst(COMPONENT_TYPE) tryGetComponentConst<const COMPONENT_TYPE>(#COMPONENT_TYPE)
 
     protected:
-        GObjectID   m_id {k_invalid_gobject_id};
-        std::string m_name;
-        std::string m_definition_url;
+        GObjectID            m_id {k_invalid_gobject_id};
+        std::weak_ptr<Level> m_level;
+        std::string          m_name;
+        std::string          m_definition_url;
 
         // we have to use the ReflectionPtr due to that the components need to be reflected 
         // in editor, and it's polymorphism
         std::vector<Reflection::ReflectionPtr<Component>> m_components;
+        // set when the level pools components, keeps the pools alive until the components are released
+        std::shared_ptr<ComponentStore> m_component_store;
+
+        // component of each type, indexed by ComponentTypeId
+        std::vector<Component*> m_component_type_index;
+
+        bool m_can_tick_concurrently {false};
+        bool m_is_save_dirty {true};
+
+        void updateComponentTypeIndex();
+        void updateConcurrentTickFlag();
     };
 } // namespace Pilot
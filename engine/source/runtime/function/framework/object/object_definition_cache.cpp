@@ -0,0 +1,80 @@
+#include "runtime/function/framework/object/object_definition_cache.h"
+
+#include "runtime/core/base/macro.h"
+#include "runtime/core/profile/profiler.h"
+
+#include "runtime/resource/asset_manager/asset_manager.h"
+#include "runtime/resource/res_type/common/object.h"
+
+#include "runtime/function/framework/component/component.h"
+#include "runtime/function/global/global_context.h"
+
+#include "_generated/serializer/all_serializer.h"
+
+namespace Pilot
+{
+    ObjectPrototype::~ObjectPrototype()
+    {
+        for (auto& component : m_components)
+        {
+            PILOT_REFLECTION_DELETE(component);
+        }
+    }
+
+    bool ObjectPrototype::load(const std::string& definition_url)
+    {
+        PROFILE_SCOPE("ObjectPrototype::load");
+
+        ObjectDefinitionRes definition_res;
+        if (!g_runtime_global_context.m_asset_manager->loadAsset(definition_url, definition_res))
+            return false;
+
+        m_components = std::move(definition_res.m_components);
+        m_component_type_names.reserve(m_components.size());
+        for (auto& component : m_components)
+        {
+            m_component_type_names.push_back(component.getTypeName());
+        }
+        return true;
+    }
+
+    Reflection::ReflectionPtr<Component> ObjectPrototype::cloneComponent(size_t index) const
+    {
+        const std::string& type_name = m_component_type_names[index];
+
+        Reflection::ReflectionInstance instance =
+            Reflection::TypeMeta::newCopyFromName(type_name, m_components[index].getPtr());
+        return Reflection::ReflectionPtr<Component>(type_name, static_cast<Component*>(instance.m_instance));
+    }
+
+    std::shared_ptr<const ObjectPrototype> ObjectDefinitionCache::getPrototype(const std::string& definition_url)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            auto iter = m_prototypes.find(definition_url);
+            if (iter != m_prototypes.end())
+            {
+                return iter->second;
+            }
+        }
+
+        // loaded outside the lock, the streaming thread may be loading another definition meanwhile
+        std::shared_ptr<ObjectPrototype> prototype = std::make_shared<ObjectPrototype>();
+        if (!prototype->load(definition_url))
+        {
+            LOG_ERROR("cannot load object definition {}", definition_url);
+            return nullptr;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        // another thread may have loaded it first, keep a single prototype
+        return m_prototypes.emplace(definition_url, std::move(prototype)).first->second;
+    }
+
+    void ObjectDefinitionCache::clear()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_prototypes.clear();
+    }
+} // namespace Pilot
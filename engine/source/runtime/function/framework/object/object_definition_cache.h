@@ -0,0 +1,53 @@
+#pragma once
+
+#include "runtime/core/meta/reflection/reflection.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Pilot
+{
+    class Component;
+
+    /// Components of an object definition, deserialized once and cloned for every instance of the definition
+    class ObjectPrototype
+    {
+    public:
+        ObjectPrototype() = default;
+        ~ObjectPrototype();
+
+        ObjectPrototype(const ObjectPrototype&) = delete;
+        ObjectPrototype& operator=(const ObjectPrototype&) = delete;
+
+        bool load(const std::string& definition_url);
+
+        size_t             getComponentCount() const { return m_components.size(); }
+        const std::string& getComponentTypeName(size_t index) const { return m_component_type_names[index]; }
+
+        // deep copy of the reflected fields of a component, without a json round trip. The caller owns the new
+        // instance
+        Reflection::ReflectionPtr<Component> cloneComponent(size_t index) const;
+
+    private:
+        std::vector<Reflection::ReflectionPtr<Component>> m_components;
+        std::vector<std::string>                          m_component_type_names;
+    };
+
+    /// Object definitions by url, so a level parses each definition once whatever its number of instances
+    class ObjectDefinitionCache
+    {
+    public:
+        // null if the definition cannot be loaded
+        std::shared_ptr<const ObjectPrototype> getPrototype(const std::string& definition_url);
+
+        // drop every prototype, the definitions are read again on the next use
+        void clear();
+
+    private:
+        std::mutex                                                              m_mutex;
+        std::unordered_map<std::string, std::shared_ptr<const ObjectPrototype>> m_prototypes;
+    };
+} // namespace Pilot
@@ -4,18 +4,107 @@
 
 namespace Pilot
 {
-    std::atomic<GObjectID> ObjectIDAllocator::m_next_id {0};
+    std::atomic<ObjectIDAllocator::SlotBlock*> ObjectIDAllocator::m_slot_blocks[k_max_block_count] {};
+    std::atomic<uint32_t>                      ObjectIDAllocator::m_slot_count {0};
+    std::atomic<uint64_t> ObjectIDAllocator::m_free_list_head {static_cast<uint64_t>(k_no_slot)};
+
+    ObjectIDAllocator::SlotBlock& ObjectIDAllocator::getSlotBlock(uint32_t slot_index)
+    {
+        std::atomic<SlotBlock*>& block_pointer = m_slot_blocks[slot_index / k_slots_per_block];
+
+        SlotBlock* block = block_pointer.load(std::memory_order_acquire);
+        if (block == nullptr)
+        {
+            // several threads may race for a new block, only one of them publishes it
+            SlotBlock* new_block = new SlotBlock();
+            if (block_pointer.compare_exchange_strong(block, new_block, std::memory_order_acq_rel))
+            {
+                block = new_block;
+            }
+            else
+            {
+                delete new_block;
+            }
+        }
+        return *block;
+    }
 
     GObjectID ObjectIDAllocator::alloc()
     {
-        std::atomic<GObjectID> new_object_ret = m_next_id.load();
-        m_next_id++;
-        if (m_next_id >= k_invalid_gobject_id)
+        // reuse a freed slot first
+        uint64_t head = m_free_list_head.load(std::memory_order_acquire);
+        while (static_cast<uint32_t>(head) != k_no_slot)
+        {
+            const uint32_t slot_index = static_cast<uint32_t>(head);
+            SlotBlock&     block      = getSlotBlock(slot_index);
+
+            const uint32_t next_slot_index =
+                block.m_next_free_slots[slot_index % k_slots_per_block].load(std::memory_order_relaxed);
+            const uint64_t new_head = ((head >> 32) + 1) << 32 | next_slot_index;
+            if (m_free_list_head.compare_exchange_weak(
+                    head, new_head, std::memory_order_acquire, std::memory_order_acquire))
+            {
+                const uint32_t generation =
+                    block.m_generations[slot_index % k_slots_per_block].load(std::memory_order_acquire);
+                return makeID(slot_index, generation);
+            }
+        }
+
+        // levels are also loaded on the streaming thread, so reading and bumping the count must be one operation
+        const uint32_t slot_index = m_slot_count.fetch_add(1, std::memory_order_relaxed);
+        if (slot_index >= k_slots_per_block * k_max_block_count)
         {
             LOG_FATAL("gobject id overflow");
+            return k_invalid_gobject_id;
         }
 
-        return new_object_ret;
+        SlotBlock& block = getSlotBlock(slot_index);
+        return makeID(slot_index, block.m_generations[slot_index % k_slots_per_block].load(std::memory_order_acquire));
     }
 
+    void ObjectIDAllocator::free(GObjectID id)
+    {
+        if (id == k_invalid_gobject_id)
+        {
+            return;
+        }
+
+        const uint32_t slot_index = getSlotIndex(id);
+        uint32_t       generation = getGeneration(id);
+        SlotBlock&     block      = getSlotBlock(slot_index);
+
+        if (!block.m_generations[slot_index % k_slots_per_block].compare_exchange_strong(
+                generation, generation + 1, std::memory_order_acq_rel))
+        {
+            LOG_ERROR("gobject id freed twice");
+            return;
+        }
+
+        uint64_t head = m_free_list_head.load(std::memory_order_relaxed);
+        uint64_t new_head;
+        do
+        {
+            block.m_next_free_slots[slot_index % k_slots_per_block].store(static_cast<uint32_t>(head),
+                                                                          std::memory_order_relaxed);
+            new_head = ((head >> 32) + 1) << 32 | slot_index;
+        } while (!m_free_list_head.compare_exchange_weak(
+            head, new_head, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    bool ObjectIDAllocator::isAlive(GObjectID id)
+    {
+        if (id == k_invalid_gobject_id)
+        {
+            return false;
+        }
+
+        const uint32_t slot_index = getSlotIndex(id);
+        if (slot_index >= m_slot_count.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        return getSlotBlock(slot_index).m_generations[slot_index % k_slots_per_block].load(
+                   std::memory_order_acquire) == getGeneration(id);
+    }
 } // namespace Pilot
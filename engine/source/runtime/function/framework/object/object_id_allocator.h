@@ -1,20 +1,56 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 #include <limits>
 
 namespace Pilot
 {
+    /// Generational handle, the low 32 bits are a slot index and the high 32 bits the generation of the slot.
+    /// Slots are reused once their object is gone, the generation tells a stale id from the current one.
     using GObjectID = std::size_t;
 
+    static_assert(sizeof(GObjectID) >= sizeof(uint64_t), "GObjectID must hold a slot index and a generation");
+
     constexpr GObjectID k_invalid_gobject_id = std::numeric_limits<std::size_t>::max();
 
+    /// Lock-free allocator of GObjectIDs, shared by all levels so that ids stay unique in the render scene
     class ObjectIDAllocator
     {
     public:
         static GObjectID alloc();
+        // bump the generation of the slot and make it available again, the id must not be used afterwards
+        static void free(GObjectID id);
+
+        // false once the id was freed
+        static bool isAlive(GObjectID id);
+
+        static uint32_t getSlotIndex(GObjectID id) { return static_cast<uint32_t>(id & 0xffffffffu); }
+        static uint32_t getGeneration(GObjectID id) { return static_cast<uint32_t>(static_cast<uint64_t>(id) >> 32); }
 
     private:
-        static std::atomic<GObjectID> m_next_id;
+        static constexpr uint32_t k_slots_per_block = 4096;
+        static constexpr uint32_t k_max_block_count = 4096;
+        static constexpr uint32_t k_no_slot         = std::numeric_limits<uint32_t>::max();
+
+        struct SlotBlock
+        {
+            std::atomic<uint32_t> m_generations[k_slots_per_block] {};
+            // next slot of the free list
+            std::atomic<uint32_t> m_next_free_slots[k_slots_per_block] {};
+        };
+
+        static SlotBlock& getSlotBlock(uint32_t slot_index);
+
+        static GObjectID makeID(uint32_t slot_index, uint32_t generation)
+        {
+            return static_cast<GObjectID>(static_cast<uint64_t>(generation) << 32 | slot_index);
+        }
+
+        // blocks are created on demand and live until exit, so a slot read by a losing thread is never freed memory
+        static std::atomic<SlotBlock*> m_slot_blocks[k_max_block_count];
+        static std::atomic<uint32_t>   m_slot_count;
+        // slot index in the low 32 bits, a tag bumped by every change in the high 32 bits against ABA
+        static std::atomic<uint64_t> m_free_list_head;
     };
 } // namespace Pilot
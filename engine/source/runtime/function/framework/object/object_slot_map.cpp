@@ -0,0 +1,79 @@
+#include "runtime/function/framework/object/object_slot_map.h"
+
+#include "runtime/function/framework/object/object.h"
+
+namespace Pilot
+{
+    bool GObjectSlotMap::insert(GObjectID id, std::shared_ptr<GObject> object)
+    {
+        if (id == k_invalid_gobject_id || contains(id))
+        {
+            return false;
+        }
+
+        const uint32_t slot_index = ObjectIDAllocator::getSlotIndex(id);
+        if (slot_index >= m_dense_indices.size())
+        {
+            m_dense_indices.resize(slot_index + 1, k_no_index);
+        }
+
+        m_dense_indices[slot_index] = static_cast<uint32_t>(m_objects.size());
+        m_ids.push_back(id);
+        m_objects.push_back(std::move(object));
+        return true;
+    }
+
+    bool GObjectSlotMap::erase(GObjectID id)
+    {
+        const uint32_t dense_index = findDenseIndex(id);
+        if (dense_index == k_no_index)
+        {
+            return false;
+        }
+
+        // destroyed once the tables are consistent again
+        std::shared_ptr<GObject> erased_object = std::move(m_objects[dense_index]);
+
+        // move the last object into the hole
+        const uint32_t last_index = static_cast<uint32_t>(m_objects.size() - 1);
+        if (dense_index != last_index)
+        {
+            m_ids[dense_index]     = m_ids[last_index];
+            m_objects[dense_index] = std::move(m_objects[last_index]);
+            m_dense_indices[ObjectIDAllocator::getSlotIndex(m_ids[dense_index])] = dense_index;
+        }
+
+        m_dense_indices[ObjectIDAllocator::getSlotIndex(id)] = k_no_index;
+        m_ids.pop_back();
+        m_objects.pop_back();
+        return true;
+    }
+
+    void GObjectSlotMap::clear()
+    {
+        m_dense_indices.clear();
+        m_ids.clear();
+        m_objects.clear();
+    }
+
+    const std::shared_ptr<GObject>& GObjectSlotMap::find(GObjectID id) const
+    {
+        static const std::shared_ptr<GObject> s_null_object;
+
+        const uint32_t dense_index = findDenseIndex(id);
+        return dense_index != k_no_index ? m_objects[dense_index] : s_null_object;
+    }
+
+    uint32_t GObjectSlotMap::findDenseIndex(GObjectID id) const
+    {
+        const uint32_t slot_index = ObjectIDAllocator::getSlotIndex(id);
+        if (slot_index >= m_dense_indices.size())
+        {
+            return k_no_index;
+        }
+
+        // a stale id points to a reused slot, the full id with its generation must match
+        const uint32_t dense_index = m_dense_indices[slot_index];
+        return dense_index != k_no_index && m_ids[dense_index] == id ? dense_index : k_no_index;
+    }
+} // namespace Pilot
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "runtime/function/framework/object/object_id_allocator.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Pilot
+{
+    class GObject;
+
+    /// Objects of a level, stored densely and addressed by their generational GObjectID.
+    /// A lookup is an index into the sparse table plus a generation check, iteration walks the dense array.
+    /// Erasing moves the last object into the hole, so the iteration order is not stable.
+    class GObjectSlotMap
+    {
+    public:
+        using ObjectArray = std::vector<std::shared_ptr<GObject>>;
+
+        bool insert(GObjectID id, std::shared_ptr<GObject> object);
+        bool erase(GObjectID id);
+        void clear();
+
+        // null if the id is stale or not in this map
+        const std::shared_ptr<GObject>& find(GObjectID id) const;
+        bool                            contains(GObjectID id) const { return findDenseIndex(id) != k_no_index; }
+
+        size_t size() const { return m_objects.size(); }
+        bool   empty() const { return m_objects.empty(); }
+
+        ObjectArray::const_iterator begin() const { return m_objects.begin(); }
+        ObjectArray::const_iterator end() const { return m_objects.end(); }
+
+    private:
+        static constexpr uint32_t k_no_index = UINT32_MAX;
+
+        uint32_t findDenseIndex(GObjectID id) const;
+
+        // slot index to dense index
+        std::vector<uint32_t> m_dense_indices;
+        // parallel dense arrays
+        std::vector<GObjectID> m_ids;
+        ObjectArray            m_objects;
+    };
+} // namespace Pilot
@@ -1,12 +1,20 @@
 #include "runtime/function/framework/world/world_manager.h"
 
 #include "runtime/core/base/macro.h"
+#include "runtime/core/profile/profiler.h"
 
 #include "runtime/resource/asset_manager/asset_manager.h"
 #include "runtime/resource/config_manager/config_manager.h"
 
+#include "runtime/engine.h"
+#include "runtime/function/framework/component/transform/transform_component.h"
 #include "runtime/function/framework/level/level.h"
+#include "runtime/function/framework/object/object.h"
 #include "runtime/function/global/global_context.h"
+#include "runtime/function/render/render_swap_context.h"
+#include "runtime/function/render/render_system.h"
+
+#include <algorithm>
 
 #include "_generated/serializer/all_serializer.h"
 
@@ -22,6 +30,11 @@ namespace Pilot
 
     void WorldManager::clear()
     {
+        // levels in flight are finished by the streaming thread and dropped
+        stopStreamingThread();
+        m_streaming_tasks.clear();
+        m_pending_active_level_url.clear();
+
         // unload all loaded levels
         for (auto level_pair : m_loaded_levels)
         {
@@ -31,6 +44,8 @@ namespace Pilot
 
         m_current_active_level.reset();
 
+        m_object_definition_cache.clear();
+
         // clear world
         m_current_world_resource.reset();
         m_current_world_url.clear();
@@ -39,11 +54,15 @@ namespace Pilot
 
     void WorldManager::tick(float delta_time)
     {
+        PROFILE_SCOPE("WorldManager::tick");
+
         if (!m_is_world_loaded)
         {
             loadWorld(m_current_world_url);
         }
 
+        updateStreamingLevels();
+
         // tick the active level
         std::shared_ptr<Level> active_level = m_current_active_level.lock();
         if (active_level)
@@ -96,8 +115,6 @@ namespace Pilot
     bool WorldManager::loadLevel(const std::string& level_url)
     {
         std::shared_ptr<Level> level = std::make_shared<Level>();
-        // set current level temporary
-        m_current_active_level       = level;
 
         const bool is_level_load_success = level->load(level_url);
         if (is_level_load_success == false)
@@ -123,6 +140,9 @@ namespace Pilot
         active_level->unload();
         m_loaded_levels.erase(level_url);
 
+        // pick up the definitions edited since the last load
+        m_object_definition_cache.clear();
+
         const bool is_load_success = loadLevel(level_url);
         if (!is_load_success)
         {
@@ -151,4 +171,255 @@ namespace Pilot
 
         active_level->save();
     }
+
+    void WorldManager::streamLevel(const std::string& level_url)
+    {
+        if (level_url.empty() || m_loaded_levels.count(level_url) > 0 || m_streaming_tasks.count(level_url) > 0)
+        {
+            return;
+        }
+
+        std::shared_ptr<LevelStreamingTask> task = std::make_shared<LevelStreamingTask>();
+        task->m_level_url                        = level_url;
+        task->m_level                            = std::make_shared<Level>();
+        m_streaming_tasks.emplace(level_url, task);
+
+        startStreamingThread();
+        {
+            std::lock_guard<std::mutex> lock(m_streaming_mutex);
+            m_streaming_queue.push_back(task);
+        }
+        m_streaming_condition.notify_one();
+
+        LOG_INFO("streaming level: {}", level_url);
+    }
+
+    void WorldManager::prefetchNeighbourLevels(const std::string& level_url)
+    {
+        if (!m_current_world_resource)
+        {
+            return;
+        }
+
+        const std::vector<std::string>& level_urls = m_current_world_resource->m_level_urls;
+
+        auto iter = std::find(level_urls.begin(), level_urls.end(), level_url);
+        if (iter == level_urls.end())
+        {
+            LOG_WARN("level {} is not in world {}", level_url, m_current_world_url);
+            return;
+        }
+
+        if (iter != level_urls.begin())
+        {
+            streamLevel(*(iter - 1));
+        }
+        if (iter + 1 != level_urls.end())
+        {
+            streamLevel(*(iter + 1));
+        }
+    }
+
+    void WorldManager::activateLevel(const std::string& level_url)
+    {
+        m_pending_active_level_url = level_url;
+        streamLevel(level_url);
+    }
+
+    void WorldManager::unloadLevel(const std::string& level_url)
+    {
+        if (m_streaming_tasks.count(level_url) > 0)
+        {
+            LOG_WARN("level {} is still streaming", level_url);
+            return;
+        }
+
+        auto iter = m_loaded_levels.find(level_url);
+        if (iter == m_loaded_levels.end())
+        {
+            return;
+        }
+
+        if (iter->second == m_current_active_level.lock())
+        {
+            LOG_WARN("can not unload the active level {}", level_url);
+            return;
+        }
+
+        iter->second->unload();
+        m_loaded_levels.erase(iter);
+    }
+
+    LevelStreamingState WorldManager::getLevelStreamingState(const std::string& level_url) const
+    {
+        if (m_loaded_levels.count(level_url) > 0)
+        {
+            return LevelStreamingState::loaded;
+        }
+
+        auto iter = m_streaming_tasks.find(level_url);
+        if (iter != m_streaming_tasks.end())
+        {
+            return iter->second->m_state.load();
+        }
+
+        return LevelStreamingState::unloaded;
+    }
+
+    float WorldManager::getLevelStreamingProgress(const std::string& level_url) const
+    {
+        if (m_loaded_levels.count(level_url) > 0)
+        {
+            return 1.f;
+        }
+
+        auto iter = m_streaming_tasks.find(level_url);
+        if (iter != m_streaming_tasks.end())
+        {
+            return iter->second->m_level->getLoadProgress();
+        }
+
+        return 0.f;
+    }
+
+    void WorldManager::updateStreamingLevels()
+    {
+        for (auto iter = m_streaming_tasks.begin(); iter != m_streaming_tasks.end();)
+        {
+            const std::shared_ptr<LevelStreamingTask>& task  = iter->second;
+            const LevelStreamingState                  state = task->m_state.load();
+            if (state == LevelStreamingState::loading)
+            {
+                ++iter;
+                continue;
+            }
+
+            if (state == LevelStreamingState::loaded)
+            {
+                m_loaded_levels.emplace(task->m_level_url, task->m_level);
+                LOG_INFO("level streamed in: {}", task->m_level_url);
+            }
+            else
+            {
+                LOG_ERROR("stream level failed {}", task->m_level_url);
+                if (m_pending_active_level_url == task->m_level_url)
+                {
+                    m_pending_active_level_url.clear();
+                }
+            }
+            iter = m_streaming_tasks.erase(iter);
+        }
+
+        if (m_pending_active_level_url.empty())
+        {
+            return;
+        }
+
+        // the level is fully built, switch to it before anything ticks in this frame
+        auto iter = m_loaded_levels.find(m_pending_active_level_url);
+        if (iter != m_loaded_levels.end())
+        {
+            std::shared_ptr<Level> previous_level = m_current_active_level.lock();
+            if (previous_level != iter->second)
+            {
+                if (previous_level)
+                {
+                    removeLevelFromScene(*previous_level);
+                }
+                addLevelToScene(*iter->second);
+            }
+
+            m_current_active_level = iter->second;
+            m_pending_active_level_url.clear();
+
+            LOG_INFO("active level: {}", iter->first);
+        }
+    }
+
+    void WorldManager::removeLevelFromScene(const Level& level) const
+    {
+        if (g_is_headless_mode)
+        {
+            return;
+        }
+
+        RenderSwapData& logic_swap_data = g_runtime_global_context.m_render_system->getSwapContext().getLogicSwapData();
+        for (const std::shared_ptr<GObject>& object : level.getAllGObjects())
+        {
+            if (object)
+            {
+                logic_swap_data.addDeleteGameObject(GameObjectDesc {object->getID(), {}});
+            }
+        }
+    }
+
+    void WorldManager::addLevelToScene(const Level& level) const
+    {
+        // the meshes send their parts again on their next tick
+        for (const std::shared_ptr<GObject>& object : level.getAllGObjects())
+        {
+            if (!object)
+                continue;
+
+            TransformComponent* transform_component = object->tryGetComponent(TransformComponent);
+            if (transform_component)
+            {
+                transform_component->setLocalDirty();
+                object->wakeComponents();
+            }
+        }
+    }
+
+    void WorldManager::startStreamingThread()
+    {
+        if (m_streaming_thread.joinable())
+        {
+            return;
+        }
+
+        m_is_streaming_stopped = false;
+        m_streaming_thread     = std::thread(&WorldManager::streamingThreadMain, this);
+    }
+
+    void WorldManager::stopStreamingThread()
+    {
+        if (!m_streaming_thread.joinable())
+        {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_streaming_mutex);
+            m_is_streaming_stopped = true;
+            m_streaming_queue.clear();
+        }
+        m_streaming_condition.notify_all();
+
+        m_streaming_thread.join();
+    }
+
+    void WorldManager::streamingThreadMain()
+    {
+        PROFILE_THREAD("level streaming thread");
+
+        while (true)
+        {
+            std::shared_ptr<LevelStreamingTask> task;
+            {
+                std::unique_lock<std::mutex> lock(m_streaming_mutex);
+                m_streaming_condition.wait(lock,
+                                           [this] { return m_is_streaming_stopped || !m_streaming_queue.empty(); });
+                if (m_is_streaming_stopped)
+                {
+                    return;
+                }
+
+                task = m_streaming_queue.front();
+                m_streaming_queue.pop_front();
+            }
+
+            const bool is_load_success = task->m_level->load(task->m_level_url);
+            task->m_state = is_load_success ? LevelStreamingState::loaded : LevelStreamingState::failed;
+        }
+    }
 } // namespace Pilot
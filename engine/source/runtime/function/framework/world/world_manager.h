@@ -2,14 +2,30 @@
 
 #include "runtime/resource/res_type/common/world.h"
 
+#include "runtime/function/framework/object/object_definition_cache.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <filesystem>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
 
 namespace Pilot
 {
     class Level;
     class PhysicsScene;
 
+    enum class LevelStreamingState : unsigned char
+    {
+        unloaded,
+        loading,
+        loaded,
+        failed
+    };
+
     /// Manage all game worlds, it should be support multiple worlds, including game world and editor world.
     /// Currently, the implement just supports one active world and one active level
     class WorldManager
@@ -28,10 +44,41 @@ namespace Pilot
 
         std::weak_ptr<PhysicsScene> getCurrentActivePhysicsScene() const;
 
+        // shared by the levels, may be used from the streaming thread
+        ObjectDefinitionCache& getObjectDefinitionCache() { return m_object_definition_cache; }
+
+        /// load a level on the streaming thread, it joins the loaded levels at the start of the frame after it is done
+        void streamLevel(const std::string& level_url);
+        /// stream the levels next to the given one in the level list of the world
+        void prefetchNeighbourLevels(const std::string& level_url);
+        /// make the level active at the start of the next frame once it is loaded, stream it if needed
+        void activateLevel(const std::string& level_url);
+        void unloadLevel(const std::string& level_url);
+
+        LevelStreamingState getLevelStreamingState(const std::string& level_url) const;
+        float               getLevelStreamingProgress(const std::string& level_url) const;
+
     private:
+        struct LevelStreamingTask
+        {
+            std::string                      m_level_url;
+            std::shared_ptr<Level>           m_level;
+            std::atomic<LevelStreamingState> m_state {LevelStreamingState::loading};
+        };
+
         bool loadWorld(const std::string& world_url);
         bool loadLevel(const std::string& level_url);
 
+        // main thread side of streaming: collect finished levels and switch the active level
+        void updateStreamingLevels();
+        // the render scene only holds the objects of the active level
+        void removeLevelFromScene(const Level& level) const;
+        void addLevelToScene(const Level& level) const;
+
+        void startStreamingThread();
+        void stopStreamingThread();
+        void streamingThreadMain();
+
         bool                      m_is_world_loaded {false};
         std::string               m_current_world_url;
         std::shared_ptr<WorldRes> m_current_world_resource;
@@ -40,5 +87,18 @@ namespace Pilot
         std::unordered_map<std::string, std::shared_ptr<Level>> m_loaded_levels;
         // active level, currently we just support one active level
         std::weak_ptr<Level> m_current_active_level;
+        // level to activate once it is loaded
+        std::string m_pending_active_level_url;
+
+        // levels being streamed, only touched by the main thread
+        std::unordered_map<std::string, std::shared_ptr<LevelStreamingTask>> m_streaming_tasks;
+
+        std::thread                                     m_streaming_thread;
+        std::mutex                                      m_streaming_mutex;
+        std::condition_variable                         m_streaming_condition;
+        std::deque<std::shared_ptr<LevelStreamingTask>> m_streaming_queue;
+        bool                                            m_is_streaming_stopped {false};
+
+        ObjectDefinitionCache m_object_definition_cache;
     };
 } // namespace Pilot
@@ -2,6 +2,8 @@
 
 #include "core/log/log_system.h"
 
+#include "runtime/core/job/job_system.h"
+
 #include "runtime/engine.h"
 
 #include "runtime/platform/file_service/file_service.h"
@@ -14,6 +16,7 @@
 #include "runtime/function/input/input_system.h"
 #include "runtime/function/physics/physics_system.h"
 #include "runtime/function/physics/physics_manager.h"
+#include "runtime/function/render/render_camera.h"
 #include "runtime/function/render/render_system.h"
 #include "runtime/function/render/window_system.h"
 
@@ -25,12 +28,17 @@ namespace Pilot
     {
         m_config_manager = std::make_shared<ConfigManager>();
         m_config_manager->initialize(init_params);
+        PJsonParser::setBackend(m_config_manager->getJsonBackend());
 
         m_file_system = std::make_shared<FileSystem>();
 
         m_logger_system = std::make_shared<LogSystem>();
 
+        m_job_system = std::make_shared<JobSystem>();
+        m_job_system->initialize();
+
         m_asset_manager = std::make_shared<AssetManager>();
+        m_asset_manager->initialize();
 
         m_legacy_physics_system = std::make_shared<PhysicsSystem>();
 
@@ -40,6 +48,11 @@ namespace Pilot
         m_world_manager = std::make_shared<WorldManager>();
         m_world_manager->initialize();
 
+        if (init_params.m_is_headless)
+        {
+            return;
+        }
+
         m_window_system = std::make_shared<WindowSystem>();
         WindowCreateInfo window_create_info;
         m_window_system->initialize(window_create_info);
@@ -51,6 +64,9 @@ namespace Pilot
         RenderSystemInitInfo render_init_info;
         render_init_info.window_system = m_window_system;
         m_render_system->initialize(render_init_info);
+
+        // the render thread is not running yet
+        m_input_system->setCameraFOV(m_render_system->getRenderCamera()->getFOV());
     }
 
     void RuntimeGlobalContext::shutdownSystems()
@@ -67,11 +83,17 @@ namespace Pilot
         m_physics_manager->clear();
         m_physics_manager.reset();
 
-        m_input_system->clear();
-        m_input_system.reset();
+        if (m_input_system)
+        {
+            m_input_system->clear();
+            m_input_system.reset();
+        }
 
+        m_asset_manager->clear();
         m_asset_manager.reset();
 
+        m_job_system->clear();
+        m_job_system.reset();
 
         m_logger_system.reset();
 
@@ -5,6 +5,7 @@
 namespace Pilot
 {
     class LogSystem;
+    class JobSystem;
     class InputSystem;
     class PhysicsSystem;
     class PhysicsManager;
@@ -28,6 +29,7 @@ namespace Pilot
 
     public:
         std::shared_ptr<LogSystem>      m_logger_system;
+        std::shared_ptr<JobSystem>      m_job_system;
         std::shared_ptr<InputSystem>    m_input_system;
         std::shared_ptr<FileSystem>     m_file_system;
         std::shared_ptr<AssetManager>   m_asset_manager;
@@ -4,8 +4,6 @@
 
 #include "runtime/engine.h"
 #include "runtime/function/global/global_context.h"
-#include "runtime/function/render/render_camera.h"
-#include "runtime/function/render/render_system.h"
 #include "runtime/function/render/window_system.h"
 
 #include <GLFW/glfw3.h>
@@ -124,8 +122,7 @@ namespace Pilot
             return;
         }
 
-        std::shared_ptr<RenderCamera> render_camera = g_runtime_global_context.m_render_system->getRenderCamera();
-        const Vector2&                fov           = render_camera->getFOV();
+        const Vector2& fov = m_camera_fov;
 
         Radian cursor_delta_x(Math::degreesToRadians(m_cursor_delta_x));
         Radian cursor_delta_y(Math::degreesToRadians(m_cursor_delta_y));
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "runtime/core/math/math.h"
+#include "runtime/core/math/vector2.h"
 
 namespace Pilot
 {
@@ -39,6 +40,10 @@ namespace Pilot
         void resetGameCommand() { m_game_command = 0; }
         unsigned int getGameCommand() const { return m_game_command; }
 
+        // logic side copy of the render camera fov, the render camera itself belongs to the render thread
+        void           setCameraFOV(const Vector2& fov) { m_camera_fov = fov; }
+        const Vector2& getCameraFOV() const { return m_camera_fov; }
+
     private:
         void onKeyInGameMode(int key, int scancode, int action, int mods);
 
@@ -48,5 +53,7 @@ namespace Pilot
 
         int m_last_cursor_x {0};
         int m_last_cursor_y {0};
+
+        Vector2 m_camera_fov {Vector2::ZERO};
     };
 } // namespace Pilot
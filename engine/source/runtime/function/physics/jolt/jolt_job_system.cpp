@@ -0,0 +1,89 @@
+#include "runtime/function/physics/jolt/jolt_job_system.h"
+
+#include "runtime/core/job/job_system.h"
+
+#include <thread>
+
+namespace Pilot
+{
+    void JoltJobSystem::BarrierImpl::AddJob(const JPH::JobHandle& job)
+    {
+        // count first, the job may finish right after the barrier is set
+        m_unfinished_job_count.fetch_add(1, std::memory_order_acq_rel);
+        if (!job.GetPtr()->SetBarrier(this))
+        {
+            // already done, it will never report to this barrier
+            m_unfinished_job_count.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    }
+
+    void JoltJobSystem::BarrierImpl::AddJobs(const JPH::JobHandle* jobs, JPH::uint job_count)
+    {
+        for (JPH::uint job_index = 0; job_index < job_count; ++job_index)
+        {
+            AddJob(jobs[job_index]);
+        }
+    }
+
+    void JoltJobSystem::BarrierImpl::OnJobFinished(Job* job)
+    {
+        m_unfinished_job_count.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    JoltJobSystem::JoltJobSystem(std::shared_ptr<Pilot::JobSystem> job_system) : m_job_system(job_system) {}
+
+    int JoltJobSystem::GetMaxConcurrency() const { return static_cast<int>(m_job_system->getMaxConcurrency()); }
+
+    JPH::JobHandle JoltJobSystem::CreateJob(const char*        name,
+                                            JPH::ColorArg      color,
+                                            const JobFunction& job_function,
+                                            JPH::uint32        dependency_count)
+    {
+        Job* job = new Job(name, color, this, job_function, dependency_count);
+
+        // the handle keeps the job alive until it is queued
+        JPH::JobHandle handle(job);
+        if (dependency_count == 0)
+        {
+            QueueJob(job);
+        }
+
+        return handle;
+    }
+
+    JPH::JobSystem::Barrier* JoltJobSystem::CreateBarrier() { return new BarrierImpl(); }
+
+    void JoltJobSystem::DestroyBarrier(Barrier* barrier) { delete static_cast<BarrierImpl*>(barrier); }
+
+    void JoltJobSystem::WaitForJobs(Barrier* barrier)
+    {
+        BarrierImpl* barrier_impl = static_cast<BarrierImpl*>(barrier);
+        while (!barrier_impl->isDone())
+        {
+            // help the workers instead of blocking
+            if (!m_job_system->tryRunOneJob())
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void JoltJobSystem::QueueJob(Job* job)
+    {
+        job->AddRef();
+        m_job_system->run([job]() {
+            job->Execute();
+            job->Release();
+        });
+    }
+
+    void JoltJobSystem::QueueJobs(Job** jobs, JPH::uint job_count)
+    {
+        for (JPH::uint job_index = 0; job_index < job_count; ++job_index)
+        {
+            QueueJob(jobs[job_index]);
+        }
+    }
+
+    void JoltJobSystem::FreeJob(Job* job) { delete job; }
+} // namespace Pilot
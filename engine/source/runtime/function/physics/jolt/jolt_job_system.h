@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Jolt/Jolt.h"
+
+#include "Jolt/Core/JobSystem.h"
+
+#include <atomic>
+#include <memory>
+
+namespace Pilot
+{
+    class JobSystem;
+
+    /// Runs Jolt jobs on the engine job system, so physics shares the engine worker threads instead of owning a pool
+    class JoltJobSystem final : public JPH::JobSystem
+    {
+        class BarrierImpl final : public JPH::JobSystem::Barrier
+        {
+        public:
+            void AddJob(const JPH::JobHandle& job) override;
+            void AddJobs(const JPH::JobHandle* jobs, JPH::uint job_count) override;
+
+            bool isDone() const { return m_unfinished_job_count.load(std::memory_order_acquire) == 0; }
+
+        protected:
+            void OnJobFinished(Job* job) override;
+
+        private:
+            std::atomic<int> m_unfinished_job_count {0};
+        };
+
+    public:
+        JoltJobSystem(std::shared_ptr<Pilot::JobSystem> job_system);
+        ~JoltJobSystem() override = default;
+
+        int            GetMaxConcurrency() const override;
+        JPH::JobHandle CreateJob(const char*        name,
+                                 JPH::ColorArg      color,
+                                 const JobFunction& job_function,
+                                 JPH::uint32        dependency_count = 0) override;
+        Barrier*       CreateBarrier() override;
+        void           DestroyBarrier(Barrier* barrier) override;
+        void           WaitForJobs(Barrier* barrier) override;
+
+    protected:
+        void QueueJob(Job* job) override;
+        void QueueJobs(Job** jobs, JPH::uint job_count) override;
+        void FreeJob(Job* job) override;
+
+    private:
+        std::shared_ptr<Pilot::JobSystem> m_job_system;
+    };
+} // namespace Pilot
@@ -15,13 +15,11 @@ namespace Pilot
         uint32_t m_max_body_pairs {65536};
         uint32_t m_max_contact_constraints {10240};
 
-        // job setting
-        uint32_t m_max_job_count {1024};
-        uint32_t m_max_barrier_count {8};
-        uint32_t m_max_concurrent_job_count {4};
-
         Vector3 m_gravity {0.f, 0.f, -9.8f};
 
         float m_update_frequency {60.f};
+        // steps simulated at most in one frame, the rest of the frame time is dropped so a slow frame does not
+        // cause even more steps in the next one
+        uint32_t m_max_step_count_per_frame {4};
     };
 } // namespace Pilot
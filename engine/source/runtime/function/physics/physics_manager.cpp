@@ -8,6 +8,11 @@
 #include "runtime/function/physics/physics_scene.h"
 #include "runtime/function/render/render_system.h"
 
+#include "Jolt/Jolt.h"
+#include "Jolt/RegisterTypes.h"
+
+#include "Jolt/Core/Factory.h"
+
 #ifdef ENABLE_PHYSICS_DEBUG_RENDERER
 #include "TestFramework.h"
 
@@ -21,6 +26,10 @@ namespace Pilot
 {
     void PhysicsManager::initialize()
     {
+        // the jolt factory is global, it is shared by all scenes
+        JPH::Factory::sInstance = new JPH::Factory();
+        JPH::RegisterTypes();
+
 #ifdef ENABLE_PHYSICS_DEBUG_RENDERER
         std::shared_ptr<ConfigManager> config_manager = g_runtime_global_context.m_config_manager;
         ASSERT(config_manager);
@@ -39,7 +48,13 @@ namespace Pilot
 
     void PhysicsManager::clear()
     {
-        m_scenes.clear();
+        {
+            std::lock_guard<std::mutex> lock(m_scene_mutex);
+            m_scenes.clear();
+        }
+
+        delete JPH::Factory::sInstance;
+        JPH::Factory::sInstance = nullptr;
 
 #ifdef ENABLE_PHYSICS_DEBUG_RENDERER
         delete m_debug_renderer;
@@ -52,6 +67,7 @@ namespace Pilot
     {
         std::shared_ptr<PhysicsScene> physics_scene = std::make_shared<PhysicsScene>(gravity);
 
+        std::lock_guard<std::mutex> lock(m_scene_mutex);
         m_scenes.push_back(physics_scene);
 
         return physics_scene;
@@ -61,7 +77,8 @@ namespace Pilot
     {
         std::shared_ptr<PhysicsScene> deleted_scene = physics_scene.lock();
 
-        auto iter = std::find(m_scenes.begin(), m_scenes.end(), deleted_scene);
+        std::lock_guard<std::mutex> lock(m_scene_mutex);
+        auto                        iter = std::find(m_scenes.begin(), m_scenes.end(), deleted_scene);
         if (iter != m_scenes.end())
         {
             m_scenes.erase(iter);
@@ -3,6 +3,7 @@
 #include "runtime/core/math/vector3.h"
 
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #ifdef ENABLE_PHYSICS_DEBUG_RENDERER
@@ -34,6 +35,8 @@ namespace Pilot
 
 
     protected:
+        // scenes are created by levels streamed in on a background thread
+        std::mutex                                 m_scene_mutex;
         std::vector<std::shared_ptr<PhysicsScene>> m_scenes;
 
 #ifdef ENABLE_PHYSICS_DEBUG_RENDERER
@@ -2,17 +2,18 @@
 
 #include "core/base/macro.h"
 
+#include "runtime/core/profile/profiler.h"
+
 #include "runtime/resource/res_type/components/rigid_body.h"
 
+#include "runtime/function/global/global_context.h"
+#include "runtime/function/physics/jolt/jolt_job_system.h"
 #include "runtime/function/physics/jolt/utils.h"
 #include "runtime/function/physics/physics_config.h"
 
 #include "Jolt/Jolt.h"
-#include "Jolt/RegisterTypes.h"
 
-#include "Jolt/Core/Factory.h"
 #include "Jolt/Core/JobSystem.h"
-#include "Jolt/Core/JobSystemThreadPool.h"
 #include "Jolt/Core/TempAllocator.h"
 
 #include "Jolt/Physics/Body/BodyCreationSettings.h"
@@ -28,22 +29,20 @@
 #include "Jolt/Physics/Collision/ShapeCast.h"
 #include "Jolt/Physics/PhysicsSystem.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace Pilot
 {
     PhysicsScene::PhysicsScene(const Vector3& gravity)
     {
         static_assert(k_invalid_rigidbody_id == JPH::BodyID::cInvalidBodyID);
 
-        JPH::Factory::sInstance = new JPH::Factory();
-        JPH::RegisterTypes();
-
         m_physics.m_jolt_physics_system              = new JPH::PhysicsSystem();
         m_physics.m_jolt_broad_phase_layer_interface = new BPLayerInterfaceImpl();
 
-        m_physics.m_jolt_job_system =
-            new JPH::JobSystemThreadPool(m_config.m_max_job_count,
-                                         m_config.m_max_barrier_count,
-                                         static_cast<int>(m_config.m_max_concurrent_job_count));
+        // jolt runs on the engine job system instead of its own thread pool
+        m_physics.m_jolt_job_system = new JoltJobSystem(g_runtime_global_context.m_job_system);
 
         // 16M temp memory
         m_physics.m_temp_allocator = new JPH::TempAllocatorImpl(16 * 1024 * 1024);
@@ -68,9 +67,6 @@ namespace Pilot
         delete m_physics.m_jolt_job_system;
         delete m_physics.m_temp_allocator;
         delete m_physics.m_jolt_broad_phase_layer_interface;
-
-        delete JPH::Factory::sInstance;
-        JPH::Factory::sInstance = nullptr;
     }
 
     uint32_t PhysicsScene::createRigidBody(const Transform&             global_transform,
@@ -159,6 +155,24 @@ namespace Pilot
 
         body_interface.AddBody(jph_body->GetID(), JPH::EActivation::Activate);
 
+        if (motion_type != JPH::EMotionType::Static)
+        {
+            JPH::Vec3 body_position;
+            JPH::Quat body_rotation;
+            body_interface.GetPositionAndRotation(jph_body->GetID(), body_position, body_rotation);
+
+            BodyInterpolationState state;
+            state.m_previous_position = state.m_current_position = toVec3(body_position);
+            state.m_previous_rotation = state.m_current_rotation = toQuat(body_rotation);
+
+            const Quaternion inverse_body_rotation = state.m_current_rotation.inverse();
+            state.m_object_offset_rotation         = inverse_body_rotation * global_transform.m_rotation;
+            state.m_object_offset_position =
+                inverse_body_rotation * (global_transform.m_position - state.m_current_position);
+
+            m_body_interpolation_states[jph_body->GetID().GetIndexAndSequenceNumber()] = state;
+        }
+
         return jph_body->GetID().GetIndexAndSequenceNumber();
     }
 
@@ -179,13 +193,41 @@ namespace Pilot
 
     void PhysicsScene::tick(float delta_time)
     {
+        PROFILE_SCOPE("PhysicsScene::tick");
+
         const float time_step = 1.f / m_config.m_update_frequency;
 
-        m_physics.m_jolt_physics_system->Update(time_step,
-                                                m_physics.m_collision_steps,
-                                                m_physics.m_integration_substeps,
-                                                m_physics.m_temp_allocator,
-                                                m_physics.m_jolt_job_system);
+        m_time_accumulator += delta_time;
+
+        uint32_t step_count = static_cast<uint32_t>(m_time_accumulator / time_step);
+        if (step_count > m_config.m_max_step_count_per_frame)
+        {
+            // can not catch up, drop the time instead of spiraling into more and more steps
+            step_count         = m_config.m_max_step_count_per_frame;
+            m_time_accumulator = step_count * time_step + std::fmod(m_time_accumulator, time_step);
+        }
+
+        for (uint32_t step_index = 0; step_index < step_count; ++step_index)
+        {
+            if (step_index + 1 == step_count)
+            {
+                storeBodyTransforms(true);
+            }
+
+            PROFILE_SCOPE("PhysicsScene::step");
+            m_physics.m_jolt_physics_system->Update(time_step,
+                                                    m_physics.m_collision_steps,
+                                                    m_physics.m_integration_substeps,
+                                                    m_physics.m_temp_allocator,
+                                                    m_physics.m_jolt_job_system);
+            m_time_accumulator -= time_step;
+        }
+
+        if (step_count > 0)
+        {
+            storeBodyTransforms(false);
+        }
+        m_interpolation_alpha = std::clamp(m_time_accumulator / time_step, 0.f, 1.f);
 
         JPH::BodyInterface& body_interface = m_physics.m_jolt_physics_system->GetBodyInterface();
         for (uint32_t body_id : m_pending_remove_bodies)
@@ -193,10 +235,56 @@ namespace Pilot
             LOG_INFO("Remove Body {}", body_id)
                 body_interface.RemoveBody(JPH::BodyID(body_id));
             body_interface.DestroyBody(JPH::BodyID(body_id));
+            m_body_interpolation_states.erase(body_id);
         }
         m_pending_remove_bodies.clear();
     }
 
+    bool PhysicsScene::getInterpolatedObjectTransform(uint32_t    body_id,
+                                                      Vector3&    out_position,
+                                                      Quaternion& out_rotation) const
+    {
+        auto iter = m_body_interpolation_states.find(body_id);
+        if (iter == m_body_interpolation_states.end())
+        {
+            return false;
+        }
+
+        const BodyInterpolationState& state = iter->second;
+
+        const Vector3 body_position =
+            Vector3::lerp(state.m_previous_position, state.m_current_position, m_interpolation_alpha);
+        const Quaternion body_rotation =
+            Quaternion::nLerp(m_interpolation_alpha, state.m_previous_rotation, state.m_current_rotation, true);
+
+        out_rotation = body_rotation * state.m_object_offset_rotation;
+        out_position = body_position + body_rotation * state.m_object_offset_position;
+        return true;
+    }
+
+    void PhysicsScene::storeBodyTransforms(bool is_previous)
+    {
+        const JPH::BodyInterface& body_interface = m_physics.m_jolt_physics_system->GetBodyInterface();
+        for (auto& id_state_pair : m_body_interpolation_states)
+        {
+            JPH::Vec3 position;
+            JPH::Quat rotation;
+            body_interface.GetPositionAndRotation(JPH::BodyID(id_state_pair.first), position, rotation);
+
+            BodyInterpolationState& state = id_state_pair.second;
+            if (is_previous)
+            {
+                state.m_previous_position = toVec3(position);
+                state.m_previous_rotation = toQuat(rotation);
+            }
+            else
+            {
+                state.m_current_position = toVec3(position);
+                state.m_current_rotation = toQuat(rotation);
+            }
+        }
+    }
+
     bool PhysicsScene::raycast(Vector3                      ray_origin,
                                Vector3                      ray_directory,
                                float                        ray_length,
@@ -2,6 +2,11 @@
 
 #include "runtime/function/physics/physics_config.h"
 
+#include "runtime/core/math/quaternion.h"
+
+#include <unordered_map>
+#include <vector>
+
 namespace JPH
 {
     class PhysicsSystem;
@@ -42,6 +47,19 @@ namespace Pilot
             int m_integration_substeps {1};
         };
 
+        /// poses of a moving body around the last simulated step, used to interpolate between fixed steps
+        struct BodyInterpolationState
+        {
+            Vector3    m_previous_position;
+            Quaternion m_previous_rotation;
+            Vector3    m_current_position;
+            Quaternion m_current_rotation;
+
+            // pose of the owner object relative to the body
+            Vector3    m_object_offset_position;
+            Quaternion m_object_offset_rotation;
+        };
+
     public:
         PhysicsScene(const Vector3& gravity);
         virtual ~PhysicsScene();
@@ -53,8 +71,16 @@ namespace Pilot
 
         void updateRigidBodyGlobalTransform(uint32_t body_id, const Transform& global_transform);
 
+        /// advance the simulation in fixed steps of 1 / update frequency, the left over time is kept for the next
+        /// frame and used to interpolate the moving bodies
         void tick(float delta_time);
 
+        /// get the owner object pose of a moving body, interpolated between the last two simulated steps
+        /// @return: false if the body is static or unknown
+        bool getInterpolatedObjectTransform(uint32_t body_id, Vector3& out_position, Quaternion& out_rotation) const;
+
+        bool hasMovingBodies() const { return !m_body_interpolation_states.empty(); }
+
         /// cast a ray and find the hits
         /// @ray_origin: origin of ray
         /// @ray_direction: ray direction
@@ -87,11 +113,18 @@ namespace Pilot
 #endif
 
     protected:
+        void storeBodyTransforms(bool is_previous);
+
         // we use single Jolt physics system for each scene
         JoltPhysics m_physics;
 
         PhysicsConfig m_config;
 
         std::vector<uint32_t> m_pending_remove_bodies;
+
+        float m_time_accumulator {0.f};
+        float m_interpolation_alpha {1.f};
+
+        std::unordered_map<uint32_t, BodyInterpolationState> m_body_interpolation_states;
     };
 } // namespace Pilot
\ No newline at end of file
@@ -11,6 +11,9 @@ namespace Pilot
 {
     void PhysicsSystem::tick(float delta_time)
     {
+        // the helpers below iterate the actors, they only run under this lock
+        std::lock_guard<std::mutex> lock(m_actor_mutex);
+
         m_delta_time = delta_time;
 
         m_delta_time_offset += m_delta_time;
@@ -62,6 +65,7 @@ namespace Pilot
 
         actor->setGlobalTransform(actor_transform);
 
+        std::lock_guard<std::mutex> lock(m_actor_mutex);
         m_physics_actors.push_back(actor);
 
         return actor;
@@ -69,7 +73,8 @@ namespace Pilot
 
     void PhysicsSystem::removePhyicsActor(PhysicsActor* actor)
     {
-        auto iter = std::find(m_physics_actors.begin(), m_physics_actors.end(), actor);
+        std::lock_guard<std::mutex> lock(m_actor_mutex);
+        auto                        iter = std::find(m_physics_actors.begin(), m_physics_actors.end(), actor);
         if (iter != m_physics_actors.end())
         {
             m_physics_actors.erase(iter);
@@ -99,6 +104,8 @@ namespace Pilot
 
     bool PhysicsSystem::raycast(const Vector3& ray_start, const Vector3& ray_direction, Vector3& out_hit_position)
     {
+        std::lock_guard<std::mutex> lock(m_actor_mutex);
+
         bool is_hit = false;
 
         Ray   ray(ray_start, ray_direction);
@@ -122,6 +129,8 @@ namespace Pilot
 
     bool PhysicsSystem::overlapByCapsule(const Vector3& position, const Capsule& capsule)
     {
+        std::lock_guard<std::mutex> lock(m_actor_mutex);
+
         // currently only overlap by aabb
         const float    capsule_height = capsule.m_half_height + capsule.m_radius;
         Vector3        center         = position + capsule_height * Vector3::UNIT_Z;
@@ -7,6 +7,7 @@
 
 #include "runtime/resource/res_type/components/rigid_body.h"
 
+#include <mutex>
 #include <set>
 
 namespace Pilot
@@ -44,6 +45,8 @@ namespace Pilot
         bool isOverlap(const AxisAlignedBox& query_bouding);
 
     private:
+        // actors are created by levels streamed in on a background thread, every access to them holds the lock
+        std::mutex                 m_actor_mutex;
         std::vector<PhysicsActor*> m_physics_actors;
         std::set<CollisionInfo>    m_all_collisions;
 
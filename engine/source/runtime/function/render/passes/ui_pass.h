@@ -22,6 +22,6 @@ namespace Pilot
         void uploadFonts();
 
     private:
-        WindowUI* m_window_ui;
+        WindowUI* m_window_ui {nullptr};
     };
 } // namespace Pilot
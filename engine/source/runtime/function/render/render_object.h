@@ -86,10 +86,21 @@ namespace Pilot
         GameObjectDesc(size_t go_id, const std::vector<GameObjectPartDesc>& parts) :
             m_go_id(go_id), m_object_parts(parts)
         {}
+        template<typename TPartIterator>
+        GameObjectDesc(size_t go_id, TPartIterator parts_begin, TPartIterator parts_end) :
+            m_go_id(go_id), m_object_parts(parts_begin, parts_end)
+        {}
 
         GObjectID                              getId() const { return m_go_id; }
         const std::vector<GameObjectPartDesc>& getObjectParts() const { return m_object_parts; }
 
+        // copy assignment, the parts already held keep their capacity
+        void assign(GObjectID go_id, const std::vector<GameObjectPartDesc>& parts)
+        {
+            m_go_id        = go_id;
+            m_object_parts = parts;
+        }
+
     private:
         GObjectID                       m_go_id {k_invalid_gobject_id};
         std::vector<GameObjectPartDesc> m_object_parts;
@@ -91,43 +91,20 @@ namespace Pilot
 
         if (std::filesystem::path(source.m_mesh_file).extension() == ".obj")
         {
-            ret.m_static_mesh_data = loadStaticMesh(source.m_mesh_file, bounding_box);
+            // the cooked mesh is the obj already expanded, parse the obj when it is not cooked or out of date
+            MeshData mesh_data;
+            if (!asset_manager->loadCookedAsset(source.m_mesh_file, mesh_data))
+            {
+                loadObjMesh(source.m_mesh_file, mesh_data);
+            }
+            ret.m_static_mesh_data = createStaticMesh(mesh_data, bounding_box);
         }
         else if (std::filesystem::path(source.m_mesh_file).extension() == ".json")
         {
             std::shared_ptr<MeshData> bind_data = std::make_shared<MeshData>();
             asset_manager->loadAsset<MeshData>(source.m_mesh_file, *bind_data);
 
-            // vertex buffer
-            size_t vertex_size                     = bind_data->vertex_buffer.size() * sizeof(MeshVertexDataDefinition);
-            ret.m_static_mesh_data.m_vertex_buffer = std::make_shared<BufferData>(vertex_size);
-            MeshVertexDataDefinition* vertex =
-                (MeshVertexDataDefinition*)ret.m_static_mesh_data.m_vertex_buffer->m_data;
-            for (size_t i = 0; i < bind_data->vertex_buffer.size(); i++)
-            {
-                vertex[i].x  = bind_data->vertex_buffer[i].px;
-                vertex[i].y  = bind_data->vertex_buffer[i].py;
-                vertex[i].z  = bind_data->vertex_buffer[i].pz;
-                vertex[i].nx = bind_data->vertex_buffer[i].nx;
-                vertex[i].ny = bind_data->vertex_buffer[i].ny;
-                vertex[i].nz = bind_data->vertex_buffer[i].nz;
-                vertex[i].tx = bind_data->vertex_buffer[i].tx;
-                vertex[i].ty = bind_data->vertex_buffer[i].ty;
-                vertex[i].tz = bind_data->vertex_buffer[i].tz;
-                vertex[i].u  = bind_data->vertex_buffer[i].u;
-                vertex[i].v  = bind_data->vertex_buffer[i].v;
-
-                bounding_box.merge(Vector3(vertex[i].x, vertex[i].y, vertex[i].z));
-            }
-
-            // index buffer
-            size_t index_size                     = bind_data->index_buffer.size() * sizeof(uint16_t);
-            ret.m_static_mesh_data.m_index_buffer = std::make_shared<BufferData>(index_size);
-            uint16_t* index                       = (uint16_t*)ret.m_static_mesh_data.m_index_buffer->m_data;
-            for (size_t i = 0; i < bind_data->index_buffer.size(); i++)
-            {
-                index[i] = static_cast<uint16_t>(bind_data->index_buffer[i]);
-            }
+            ret.m_static_mesh_data = createStaticMesh(*bind_data, bounding_box);
 
             // skeleton binding buffer
             size_t data_size              = bind_data->bind.size() * sizeof(MeshVertexBindingDataDefinition);
@@ -148,6 +125,11 @@ namespace Pilot
         }
 
         m_bounding_box_cache_map.insert(std::make_pair(source, bounding_box));
+        // the level reads the box from there instead of reading the mesh again
+        if (bounding_box.getMinCorner().x <= bounding_box.getMaxCorner().x)
+        {
+            asset_manager->getMeshBoundsCache().storeBounds(source.m_mesh_file, bounding_box);
+        }
 
         return ret;
     }
@@ -173,10 +155,8 @@ namespace Pilot
         return AxisAlignedBox();
     }
 
-    StaticMeshData RenderResourceBase::loadStaticMesh(std::string filename, AxisAlignedBox& bounding_box)
+    bool RenderResourceBase::loadObjMesh(const std::string& filename, MeshData& out_mesh_data)
     {
-        StaticMeshData mesh_data;
-
         tinyobj::ObjReader       reader;
         tinyobj::ObjReaderConfig reader_config;
         reader_config.vertex_color = false;
@@ -186,7 +166,7 @@ namespace Pilot
             {
                 LOG_ERROR("loadMesh {} failed, error: {}", filename, reader.Error());
             }
-            assert(0);
+            return false;
         }
 
         if (!reader.Warning().empty())
@@ -197,7 +177,7 @@ namespace Pilot
         auto& attrib = reader.GetAttrib();
         auto& shapes = reader.GetShapes();
 
-        std::vector<MeshVertexDataDefinition> mesh_vertices;
+        out_mesh_data = MeshData();
 
         for (size_t s = 0; s < shapes.size(); s++)
         {
@@ -231,8 +211,6 @@ namespace Pilot
                     vertex[v].y = static_cast<float>(vy);
                     vertex[v].z = static_cast<float>(vz);
 
-                    bounding_box.merge(Vector3(vertex[v].x, vertex[v].y, vertex[v].z));
-
                     if (idx.normal_index >= 0)
                     {
                         auto nx = attrib.normals[3 * size_t(idx.normal_index) + 0];
@@ -301,11 +279,11 @@ namespace Pilot
 
                 for (size_t i = 0; i < 3; i++)
                 {
-                    MeshVertexDataDefinition mesh_vert {};
+                    Vertex mesh_vert {};
 
-                    mesh_vert.x = vertex[i].x;
-                    mesh_vert.y = vertex[i].y;
-                    mesh_vert.z = vertex[i].z;
+                    mesh_vert.px = vertex[i].x;
+                    mesh_vert.py = vertex[i].y;
+                    mesh_vert.pz = vertex[i].z;
 
                     mesh_vert.nx = normal[i].x;
                     mesh_vert.ny = normal[i].y;
@@ -318,26 +296,53 @@ namespace Pilot
                     mesh_vert.ty = tangent.y;
                     mesh_vert.tz = tangent.z;
 
-                    mesh_vertices.push_back(mesh_vert);
+                    out_mesh_data.index_buffer.push_back(static_cast<int>(out_mesh_data.vertex_buffer.size()));
+                    out_mesh_data.vertex_buffer.push_back(mesh_vert);
                 }
             }
         }
 
-        uint32_t stride           = sizeof(MeshVertexDataDefinition);
-        mesh_data.m_vertex_buffer = std::make_shared<BufferData>(mesh_vertices.size() * stride);
-        mesh_data.m_index_buffer  = std::make_shared<BufferData>(mesh_vertices.size() * sizeof(uint16_t));
+        return true;
+    }
 
-        assert(mesh_vertices.size() <= std::numeric_limits<uint16_t>::max()); // take care of the index range, should be
-                                                                              // consistent with the index range used by
-                                                                              // vulkan
+    StaticMeshData RenderResourceBase::createStaticMesh(const MeshData& mesh_data, AxisAlignedBox& bounding_box)
+    {
+        StaticMeshData ret;
 
-        uint16_t* indices = (uint16_t*)mesh_data.m_index_buffer->m_data;
-        for (size_t i = 0; i < mesh_vertices.size(); i++)
+        // vertex buffer
+        size_t vertex_size  = mesh_data.vertex_buffer.size() * sizeof(MeshVertexDataDefinition);
+        ret.m_vertex_buffer = std::make_shared<BufferData>(vertex_size);
+        MeshVertexDataDefinition* vertex = (MeshVertexDataDefinition*)ret.m_vertex_buffer->m_data;
+        for (size_t i = 0; i < mesh_data.vertex_buffer.size(); i++)
         {
-            ((MeshVertexDataDefinition*)(mesh_data.m_vertex_buffer->m_data))[i] = mesh_vertices[i];
-            indices[i]                                                          = static_cast<uint16_t>(i);
+            vertex[i].x  = mesh_data.vertex_buffer[i].px;
+            vertex[i].y  = mesh_data.vertex_buffer[i].py;
+            vertex[i].z  = mesh_data.vertex_buffer[i].pz;
+            vertex[i].nx = mesh_data.vertex_buffer[i].nx;
+            vertex[i].ny = mesh_data.vertex_buffer[i].ny;
+            vertex[i].nz = mesh_data.vertex_buffer[i].nz;
+            vertex[i].tx = mesh_data.vertex_buffer[i].tx;
+            vertex[i].ty = mesh_data.vertex_buffer[i].ty;
+            vertex[i].tz = mesh_data.vertex_buffer[i].tz;
+            vertex[i].u  = mesh_data.vertex_buffer[i].u;
+            vertex[i].v  = mesh_data.vertex_buffer[i].v;
+
+            bounding_box.merge(Vector3(vertex[i].x, vertex[i].y, vertex[i].z));
         }
 
-        return mesh_data;
+        assert(mesh_data.vertex_buffer.size() <= std::numeric_limits<uint16_t>::max()); // take care of the index range,
+                                                                                      // should be consistent with the
+                                                                                      // index range used by vulkan
+
+        // index buffer
+        size_t index_size  = mesh_data.index_buffer.size() * sizeof(uint16_t);
+        ret.m_index_buffer = std::make_shared<BufferData>(index_size);
+        uint16_t* index    = (uint16_t*)ret.m_index_buffer->m_data;
+        for (size_t i = 0; i < mesh_data.index_buffer.size(); i++)
+        {
+            index[i] = static_cast<uint16_t>(mesh_data.index_buffer[i]);
+        }
+
+        return ret;
     }
 } // namespace Pilot
@@ -11,6 +11,7 @@
 namespace Pilot
 {
     class RHI;
+    class MeshData;
     class RenderScene;
     class RenderCamera;
 
@@ -44,8 +45,11 @@ namespace Pilot
         RenderMaterialData           loadMaterialData(const MaterialSourceDesc& source);
         AxisAlignedBox               getCachedBoudingBox(const MeshSourceDesc& source) const;
 
+        // expand the triangles of an obj file, also used by PilotAssetCooker
+        static bool loadObjMesh(const std::string& mesh_file, MeshData& out_mesh_data);
+
     private:
-        StaticMeshData loadStaticMesh(std::string mesh_file, AxisAlignedBox& bounding_box);
+        static StaticMeshData createStaticMesh(const MeshData& mesh_data, AxisAlignedBox& bounding_box);
 
         std::unordered_map<MeshSourceDesc, AxisAlignedBox> m_bounding_box_cache_map;
     };
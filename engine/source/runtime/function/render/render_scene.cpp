@@ -1,4 +1,7 @@
 #include "runtime/function/render/render_scene.h"
+
+#include "runtime/core/base/frame_allocator.h"
+
 #include "runtime/function/render/glm_wrapper.h"
 #include "runtime/function/render/render_helper.h"
 #include "runtime/function/render/render_pass.h"
@@ -47,7 +50,7 @@ namespace Pilot
         {
             return find_it->second;
         }
-        return GObjectID();
+        return k_invalid_gobject_id;
     }
 
     void RenderScene::deleteEntityByGObjectID(GObjectID go_id)
@@ -132,7 +135,7 @@ namespace Pilot
     {
         m_point_lights_visible_mesh_nodes.clear();
 
-        std::vector<BoundingSphere> point_lights_bounding_spheres;
+        FrameVector<BoundingSphere> point_lights_bounding_spheres;
         uint32_t                    point_light_num = static_cast<uint32_t>(m_point_light_list.m_lights.size());
         point_lights_bounding_spheres.resize(point_light_num);
         for (size_t i = 0; i < point_light_num; i++)
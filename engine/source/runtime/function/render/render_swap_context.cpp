@@ -4,23 +4,62 @@
 
 namespace Pilot
 {
-    void GameObjectResourceDesc::add(GameObjectDesc desc) { m_game_object_descs.push_back(desc); }
+    namespace
+    {
+        bool hasGameObjects(const std::optional<GameObjectResourceDesc>& game_object_descs)
+        {
+            return game_object_descs.has_value() && !game_object_descs->isEmpty();
+        }
+    } // namespace
+
+    void GameObjectResourceDesc::add(GameObjectDesc desc) { allocateDesc() = std::move(desc); }
 
-    bool GameObjectResourceDesc::isEmpty() const { return m_game_object_descs.empty(); }
+    void GameObjectResourceDesc::add(GObjectID go_id, const std::vector<GameObjectPartDesc>& parts)
+    {
+        allocateDesc().assign(go_id, parts);
+    }
 
-    GameObjectDesc GameObjectResourceDesc::getNextProcessObject()
+    bool GameObjectResourceDesc::isEmpty() const { return m_process_index == m_game_object_count; }
+
+    const GameObjectDesc& GameObjectResourceDesc::getNextProcessObject() const
     {
-        if (!m_game_object_descs.empty())
+        if (!isEmpty())
         {
-            return m_game_object_descs.front();
+            return m_game_object_descs[m_process_index];
         }
         else
         {
-            return GameObjectDesc();
+            static const GameObjectDesc empty_desc;
+            return empty_desc;
         }
     }
 
-    void GameObjectResourceDesc::popProcessObject() { m_game_object_descs.pop_front(); }
+    void GameObjectResourceDesc::popProcessObject()
+    {
+        if (!isEmpty())
+        {
+            ++m_process_index;
+        }
+        if (isEmpty())
+        {
+            clear();
+        }
+    }
+
+    void GameObjectResourceDesc::clear()
+    {
+        m_game_object_count = 0;
+        m_process_index     = 0;
+    }
+
+    GameObjectDesc& GameObjectResourceDesc::allocateDesc()
+    {
+        if (m_game_object_count == m_game_object_descs.size())
+        {
+            m_game_object_descs.emplace_back();
+        }
+        return m_game_object_descs[m_game_object_count++];
+    }
 
     RenderSwapData& RenderSwapContext::getLogicSwapData() { return m_swap_data[m_logic_swap_data_index]; }
 
@@ -37,9 +76,10 @@ namespace Pilot
     bool RenderSwapContext::isReadyToSwap() const
     {
         return !(m_swap_data[m_render_swap_data_index].m_level_resource_desc.has_value() ||
-                 m_swap_data[m_render_swap_data_index].m_game_object_resource_desc.has_value() ||
-                 m_swap_data[m_render_swap_data_index].m_game_object_to_delete.has_value() ||
-                 m_swap_data[m_render_swap_data_index].m_camera_swap_data.has_value());
+                 hasGameObjects(m_swap_data[m_render_swap_data_index].m_game_object_resource_desc) ||
+                 hasGameObjects(m_swap_data[m_render_swap_data_index].m_game_object_to_delete) ||
+                 m_swap_data[m_render_swap_data_index].m_camera_swap_data.has_value() ||
+                 m_swap_data[m_render_swap_data_index].m_framebuffer_size.has_value());
     }
 
     void RenderSwapContext::resetLevelRsourceSwapData()
@@ -49,50 +89,126 @@ namespace Pilot
 
     void RenderSwapContext::resetGameObjectResourceSwapData()
     {
-        m_swap_data[m_render_swap_data_index].m_game_object_resource_desc.reset();
+        // the descs keep their storage for the next frame written to this swap data
+        std::optional<GameObjectResourceDesc>& game_object_descs =
+            m_swap_data[m_render_swap_data_index].m_game_object_resource_desc;
+        if (game_object_descs.has_value())
+        {
+            game_object_descs->clear();
+        }
     }
 
     void RenderSwapContext::resetGameObjectToDelete()
     {
-        m_swap_data[m_render_swap_data_index].m_game_object_to_delete.reset();
+        std::optional<GameObjectResourceDesc>& game_object_descs =
+            m_swap_data[m_render_swap_data_index].m_game_object_to_delete;
+        if (game_object_descs.has_value())
+        {
+            game_object_descs->clear();
+        }
     }
 
     void RenderSwapContext::resetCameraSwapData() { m_swap_data[m_render_swap_data_index].m_camera_swap_data.reset(); }
 
+    void RenderSwapContext::resetFramebufferSize() { m_swap_data[m_render_swap_data_index].m_framebuffer_size.reset(); }
+
     void RenderSwapContext::swap()
     {
         resetLevelRsourceSwapData();
         resetGameObjectResourceSwapData();
         resetGameObjectToDelete();
         resetCameraSwapData();
+        resetFramebufferSize();
         std::swap(m_logic_swap_data_index, m_render_swap_data_index);
     }
 
-    void RenderSwapData::addDirtyGameObject(GameObjectDesc desc)
+    void RenderSwapContext::submitLogicSwapData()
     {
-        if (m_game_object_resource_desc.has_value())
+        std::unique_lock<std::mutex> lock(m_handoff_mutex);
+        m_handoff_condition.wait(lock, [this] { return m_is_render_swap_data_consumed || m_is_handoff_stopped; });
+        if (m_is_handoff_stopped)
         {
-            m_game_object_resource_desc->add(desc);
+            return;
         }
-        else
+
+        // the render thread does not touch any swap data until the next acquire, so it is safe to swap here
+        swap();
+        m_is_render_swap_data_consumed = false;
+        ++m_submitted_frame_index;
+
+        lock.unlock();
+        m_handoff_condition.notify_all();
+    }
+
+    bool RenderSwapContext::acquireRenderSwapData()
+    {
+        std::unique_lock<std::mutex> lock(m_handoff_mutex);
+        m_handoff_condition.wait(
+            lock, [this] { return m_submitted_frame_index != m_acquired_frame_index || m_is_handoff_stopped; });
+        if (m_is_handoff_stopped)
         {
-            GameObjectResourceDesc go_descs;
-            go_descs.add(desc);
-            m_game_object_resource_desc = go_descs;
+            return false;
         }
+
+        m_acquired_frame_index = m_submitted_frame_index;
+        return true;
     }
 
-    void RenderSwapData::addDeleteGameObject(GameObjectDesc desc)
+    void RenderSwapContext::releaseRenderSwapData()
     {
-        if (m_game_object_to_delete.has_value())
         {
-            m_game_object_to_delete->add(desc);
+            std::lock_guard<std::mutex> lock(m_handoff_mutex);
+            m_is_render_swap_data_consumed = true;
         }
-        else
+        m_handoff_condition.notify_all();
+    }
+
+    void RenderSwapContext::startFrameHandoff()
+    {
+        std::lock_guard<std::mutex> lock(m_handoff_mutex);
+        m_is_handoff_stopped           = false;
+        m_is_render_swap_data_consumed = isReadyToSwap();
+        // pending render swap data is picked up by the first acquire
+        m_acquired_frame_index =
+            m_is_render_swap_data_consumed ? m_submitted_frame_index : m_submitted_frame_index - 1;
+    }
+
+    void RenderSwapContext::stopFrameHandoff()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_handoff_mutex);
+            m_is_handoff_stopped = true;
+        }
+        m_handoff_condition.notify_all();
+    }
+
+    void RenderSwapData::addDirtyGameObject(GameObjectDesc desc)
+    {
+        std::lock_guard<std::mutex> lock(m_game_object_mutex);
+        if (!m_game_object_resource_desc.has_value())
+        {
+            m_game_object_resource_desc.emplace();
+        }
+        m_game_object_resource_desc->add(std::move(desc));
+    }
+
+    void RenderSwapData::addDirtyGameObject(GObjectID go_id, const std::vector<GameObjectPartDesc>& parts)
+    {
+        std::lock_guard<std::mutex> lock(m_game_object_mutex);
+        if (!m_game_object_resource_desc.has_value())
+        {
+            m_game_object_resource_desc.emplace();
+        }
+        m_game_object_resource_desc->add(go_id, parts);
+    }
+
+    void RenderSwapData::addDeleteGameObject(GameObjectDesc desc)
+    {
+        std::lock_guard<std::mutex> lock(m_game_object_mutex);
+        if (!m_game_object_to_delete.has_value())
         {
-            GameObjectResourceDesc go_descs;
-            go_descs.add(desc);
-            m_game_object_to_delete = go_descs;
+            m_game_object_to_delete.emplace();
         }
+        m_game_object_to_delete->add(std::move(desc));
     }
 } // namespace Pilot
@@ -4,10 +4,13 @@
 #include "runtime/function/render/render_object.h"
 #include "runtime/resource/res_type/global/global_rendering.h"
 
+#include <array>
+#include <condition_variable>
 #include <cstdint>
-#include <deque>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <vector>
 
 namespace Pilot
 {
@@ -38,12 +41,21 @@ namespace Pilot
 
     struct GameObjectResourceDesc
     {
-        std::deque<GameObjectDesc> m_game_object_descs;
+        // processed descs stay in the array, the next frame overwrites them in place instead of allocating new parts
+        std::vector<GameObjectDesc> m_game_object_descs;
+        size_t                      m_game_object_count {0};
+        size_t                      m_process_index {0};
 
-        void                       add(GameObjectDesc desc);
-        bool                       isEmpty() const;
-        GameObjectDesc             getNextProcessObject();
-        void                       popProcessObject();
+        void                  add(GameObjectDesc desc);
+        void                  add(GObjectID go_id, const std::vector<GameObjectPartDesc>& parts);
+        bool                  isEmpty() const;
+        const GameObjectDesc& getNextProcessObject() const;
+        void                  popProcessObject();
+        // drop the descs, keep the storage
+        void                  clear();
+
+    private:
+        GameObjectDesc& allocateDesc();
     };
 
     struct RenderSwapData
@@ -52,9 +64,15 @@ namespace Pilot
         std::optional<GameObjectResourceDesc> m_game_object_resource_desc;
         std::optional<GameObjectResourceDesc> m_game_object_to_delete;
         std::optional<CameraSwapData>         m_camera_swap_data;
+        std::optional<std::array<int, 2>>     m_framebuffer_size;
 
+        // safe to call from components ticking in parallel
         void addDirtyGameObject(GameObjectDesc desc);
+        void addDirtyGameObject(GObjectID go_id, const std::vector<GameObjectPartDesc>& parts);
         void addDeleteGameObject(GameObjectDesc desc);
+
+    private:
+        std::mutex m_game_object_mutex;
     };
 
     enum SwapDataType : uint8_t
@@ -64,6 +82,10 @@ namespace Pilot
         SwapDataTypeCount
     };
 
+    /// Double buffer between the logic side and the render side.
+    /// The logic swap data is only touched by the logic thread and the render swap data only by the render thread,
+    /// the two sides meet at swap time. In single thread mode swapLogicRenderData() is enough, with a dedicated
+    /// render thread use submitLogicSwapData() / acquireRenderSwapData() / releaseRenderSwapData() to hand frames over.
     class RenderSwapContext
     {
     public:
@@ -74,12 +96,31 @@ namespace Pilot
         void            resetGameObjectResourceSwapData();
         void            resetGameObjectToDelete();
         void            resetCameraSwapData();
+        void            resetFramebufferSize();
+
+        // logic thread: wait until the render thread has consumed the previous frame, then publish the logic data
+        void submitLogicSwapData();
+        // render thread: wait until the logic thread publishes a frame, return false if the handoff is stopped
+        bool acquireRenderSwapData();
+        // render thread: the render swap data has been processed, the logic thread can swap again
+        void releaseRenderSwapData();
+
+        void startFrameHandoff();
+        void stopFrameHandoff();
 
     private:
         uint8_t        m_logic_swap_data_index {LogicSwapDataType};
         uint8_t        m_render_swap_data_index {RenderSwapDataType};
         RenderSwapData m_swap_data[SwapDataTypeCount];
 
+        // frame handoff between logic thread and render thread
+        std::mutex              m_handoff_mutex;
+        std::condition_variable m_handoff_condition;
+        bool                    m_is_render_swap_data_consumed {true};
+        bool                    m_is_handoff_stopped {false};
+        uint64_t                m_submitted_frame_index {0};
+        uint64_t                m_acquired_frame_index {0};
+
         bool isReadyToSwap() const;
         void swap();
     };
@@ -1,6 +1,9 @@
 #include "runtime/function/render/render_system.h"
 
 #include "runtime/core/base/macro.h"
+#include "runtime/core/profile/profiler.h"
+
+#include "runtime/function/input/input_system.h"
 
 #include "runtime/resource/asset_manager/asset_manager.h"
 #include "runtime/resource/config_manager/config_manager.h"
@@ -35,6 +38,8 @@ namespace Pilot
         m_rhi = std::make_shared<VulkanRHI>();
         m_rhi->initialize(rhi_init_info);
 
+        m_logic_framebuffer_size = init_info.window_system->getFramebufferSize();
+
         // global rendering resource
         GlobalRenderingRes global_rendering_res;
         const std::string& global_rendering_res_url = config_manager->getGlobalRenderingResUrl();
@@ -89,23 +94,38 @@ namespace Pilot
 
     void RenderSystem::tick()
     {
+        PROFILE_SCOPE("RenderSystem::tick");
+
         // process swap data between logic and render contexts
         processSwapData();
 
         // prepare render command context
-        m_rhi->prepareContext();
+        {
+            PROFILE_SCOPE("RenderSystem::prepareContext");
+            m_rhi->prepareContext();
+        }
 
         // update per-frame buffer
-        m_render_resource->updatePerFrameBuffer(m_render_scene, m_render_camera);
+        {
+            PROFILE_SCOPE("RenderSystem::updatePerFrameBuffer");
+            m_render_resource->updatePerFrameBuffer(m_render_scene, m_render_camera);
+        }
 
         // update per-frame visible objects
-        m_render_scene->updateVisibleObjects(std::static_pointer_cast<RenderResource>(m_render_resource),
-                                             m_render_camera);
+        {
+            PROFILE_SCOPE("RenderSystem::updateVisibleObjects");
+            m_render_scene->updateVisibleObjects(std::static_pointer_cast<RenderResource>(m_render_resource),
+                                                 m_render_camera);
+        }
 
         // prepare pipeline's render passes data
-        m_render_pipeline->preparePassData(m_render_resource);
+        {
+            PROFILE_SCOPE("RenderSystem::preparePassData");
+            m_render_pipeline->preparePassData(m_render_resource);
+        }
 
         // render one frame
+        PROFILE_SCOPE("RenderSystem::render");
         if (m_render_pipeline_type == RENDER_PIPELINE_TYPE::FORWARD_PIPELINE)
         {
             m_render_pipeline->forwardRender(m_rhi, m_render_resource);
@@ -126,6 +146,17 @@ namespace Pilot
 
     std::shared_ptr<RenderCamera> RenderSystem::getRenderCamera() const { return m_render_camera; }
 
+    void RenderSystem::updateFramebufferSize(const std::array<int, 2>& framebuffer_size)
+    {
+        if (framebuffer_size == m_logic_framebuffer_size)
+        {
+            return;
+        }
+
+        m_logic_framebuffer_size                             = framebuffer_size;
+        m_swap_context.getLogicSwapData().m_framebuffer_size = framebuffer_size;
+    }
+
     void RenderSystem::updateEngineContentViewport(float offset_x, float offset_y, float width, float height)
     {
         std::static_pointer_cast<VulkanRHI>(m_rhi)->m_viewport.x        = offset_x;
@@ -136,6 +167,9 @@ namespace Pilot
         std::static_pointer_cast<VulkanRHI>(m_rhi)->m_viewport.maxDepth = 1.0f;
 
         m_render_camera->setAspect(width / height);
+
+        // the editor resizes the viewport on the main thread and never runs a render thread
+        g_runtime_global_context.m_input_system->setCameraFOV(m_render_camera->getFOV());
     }
 
     EngineContentViewport RenderSystem::getEngineContentViewport() const
@@ -208,6 +242,8 @@ namespace Pilot
 
     void RenderSystem::processSwapData()
     {
+        PROFILE_SCOPE("RenderSystem::processSwapData");
+
         RenderSwapData& swap_data = m_swap_context.getRenderSwapData();
 
         std::shared_ptr<AssetManager> asset_manager = g_runtime_global_context.m_asset_manager;
@@ -227,7 +263,7 @@ namespace Pilot
         {
             while (!swap_data.m_game_object_resource_desc->isEmpty())
             {
-                GameObjectDesc gobject = swap_data.m_game_object_resource_desc->getNextProcessObject();
+                const GameObjectDesc& gobject = swap_data.m_game_object_resource_desc->getNextProcessObject();
 
                 for (size_t part_index = 0; part_index < gobject.getObjectParts().size(); part_index++)
                 {
@@ -340,7 +376,7 @@ namespace Pilot
         {
             while (!swap_data.m_game_object_to_delete->isEmpty())
             {
-                GameObjectDesc gobject = swap_data.m_game_object_to_delete->getNextProcessObject();
+                const GameObjectDesc& gobject = swap_data.m_game_object_to_delete->getNextProcessObject();
                 m_render_scene->deleteEntityByGObjectID(gobject.getId());
                 swap_data.m_game_object_to_delete->popProcessObject();
             }
@@ -368,5 +404,17 @@ namespace Pilot
 
             m_swap_context.resetCameraSwapData();
         }
+
+        // the swapchain is recreated with the size recorded on the main thread
+        if (swap_data.m_framebuffer_size.has_value())
+        {
+            std::static_pointer_cast<VulkanRHI>(m_rhi)->setFramebufferSize((*swap_data.m_framebuffer_size)[0],
+                                                                          (*swap_data.m_framebuffer_size)[1]);
+
+            m_swap_context.resetFramebufferSize();
+        }
+
+        // everything is consumed, let the logic thread publish the next frame
+        m_swap_context.releaseRenderSwapData();
     }
 } // namespace Pilot
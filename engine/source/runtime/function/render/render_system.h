@@ -45,6 +45,9 @@ namespace Pilot
         RenderSwapContext&            getSwapContext();
         std::shared_ptr<RenderCamera> getRenderCamera() const;
 
+        // logic thread: hand the framebuffer size recorded by the window system over to the render side
+        void updateFramebufferSize(const std::array<int, 2>& framebuffer_size);
+
         void      setRenderPipelineType(RENDER_PIPELINE_TYPE pipeline_type);
         void      initializeUIRenderBackend(WindowUI* window_ui);
         void      updateEngineContentViewport(float offset_x, float offset_y, float width, float height);
@@ -64,7 +67,8 @@ namespace Pilot
     private:
         RENDER_PIPELINE_TYPE m_render_pipeline_type {RENDER_PIPELINE_TYPE::DEFERRED_PIPELINE};
 
-        RenderSwapContext m_swap_context;
+        RenderSwapContext  m_swap_context;
+        std::array<int, 2> m_logic_framebuffer_size {0, 0};
 
         std::shared_ptr<RHI>                m_rhi;
         std::shared_ptr<RenderCamera>       m_render_camera;
@@ -84,7 +84,9 @@ namespace Pilot
     {
         m_window = init_info.window_system->getWindow();
 
-        std::array<int, 2> window_size = init_info.window_system->getWindowSize();
+        std::array<int, 2> window_size      = init_info.window_system->getWindowSize();
+        std::array<int, 2> framebuffer_size = init_info.window_system->getFramebufferSize();
+        setFramebufferSize(framebuffer_size[0], framebuffer_size[1]);
 
         m_viewport = {0.0f, 0.0f, (float)window_size[0], (float)window_size[1], 0.0f, 1.0f};
         m_scissor  = {{0, 0}, {(uint32_t)window_size[0], (uint32_t)window_size[1]}};
@@ -200,14 +202,18 @@ namespace Pilot
 
         if (VK_ERROR_OUT_OF_DATE_KHR == acquire_image_result)
         {
-            recreateSwapchain();
-            passUpdateAfterRecreateSwapchain();
+            if (recreateSwapchain())
+            {
+                passUpdateAfterRecreateSwapchain();
+            }
             return true;
         }
         else if (VK_SUBOPTIMAL_KHR == acquire_image_result)
         {
-            recreateSwapchain();
-            passUpdateAfterRecreateSwapchain();
+            if (recreateSwapchain())
+            {
+                passUpdateAfterRecreateSwapchain();
+            }
 
             // NULL submit to wait semaphore
             VkPipelineStageFlags wait_stages[] = {VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT};
@@ -286,8 +292,10 @@ namespace Pilot
         VkResult present_result = vkQueuePresentKHR(m_present_queue, &present_info);
         if (VK_ERROR_OUT_OF_DATE_KHR == present_result || VK_SUBOPTIMAL_KHR == present_result)
         {
-            recreateSwapchain();
-            passUpdateAfterRecreateSwapchain();
+            if (recreateSwapchain())
+            {
+                passUpdateAfterRecreateSwapchain();
+            }
         }
         else
         {
@@ -858,15 +866,12 @@ namespace Pilot
         vkDestroySwapchainKHR(m_device, m_swapchain, NULL); // also swapchain images
     }
 
-    void VulkanRHI::recreateSwapchain()
+    bool VulkanRHI::recreateSwapchain()
     {
-        int width  = 0;
-        int height = 0;
-        glfwGetFramebufferSize(m_window, &width, &height);
-        while (width == 0 || height == 0) // minimized 0,0, pause for now
+        // minimized 0,0, the main thread waits for the window to come back
+        if (m_framebuffer_width == 0 || m_framebuffer_height == 0)
         {
-            glfwGetFramebufferSize(m_window, &width, &height);
-            glfwWaitEvents();
+            return false;
         }
 
         VkResult res_wait_for_fences =
@@ -886,6 +891,14 @@ namespace Pilot
         createSwapchain();
         createSwapchainImageViews();
         createFramebufferImageAndView();
+
+        return true;
+    }
+
+    void VulkanRHI::setFramebufferSize(int width, int height)
+    {
+        m_framebuffer_width  = width;
+        m_framebuffer_height = height;
     }
 
     VkResult VulkanRHI::createDebugUtilsMessengerEXT(VkInstance                                instance,
@@ -1089,10 +1102,8 @@ namespace Pilot
         }
         else
         {
-            int width, height;
-            glfwGetFramebufferSize(m_window, &width, &height);
-
-            VkExtent2D actualExtent = {static_cast<uint32_t>(width), static_cast<uint32_t>(height)};
+            VkExtent2D actualExtent = {static_cast<uint32_t>(m_framebuffer_width),
+                                       static_cast<uint32_t>(m_framebuffer_height)};
 
             actualExtent.width =
                 std::clamp(actualExtent.width, capabilities.minImageExtent.width, capabilities.maxImageExtent.width);
@@ -41,7 +41,10 @@ namespace Pilot
         // swapchain
         void createSwapchain();
         void clearSwapchain();
-        void recreateSwapchain();
+        // false if the window is minimized, the old swapchain is kept
+        bool recreateSwapchain();
+        // render thread: the size recorded by the window system on the main thread
+        void setFramebufferSize(int width, int height);
 
         void createSwapchainImageViews();
         void createFramebufferImageAndView();
@@ -115,6 +118,8 @@ namespace Pilot
         VkExtent2D               m_swapchain_extent;
         std::vector<VkImage>     m_swapchain_images;
         std::vector<VkImageView> m_swapchain_imageviews;
+        int                      m_framebuffer_width {0};
+        int                      m_framebuffer_height {0};
 
         VkImage        m_depth_image {VK_NULL_HANDLE};
         VkDeviceMemory m_depth_image_memory {VK_NULL_HANDLE};
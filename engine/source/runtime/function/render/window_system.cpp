@@ -41,12 +41,24 @@ namespace Pilot
         glfwSetScrollCallback(m_window, scrollCallback);
         glfwSetDropCallback(m_window, dropCallback);
         glfwSetWindowSizeCallback(m_window, windowSizeCallback);
+        glfwSetFramebufferSizeCallback(m_window, framebufferSizeCallback);
         glfwSetWindowCloseCallback(m_window, windowCloseCallback);
 
         glfwSetInputMode(m_window, GLFW_RAW_MOUSE_MOTION, GLFW_FALSE);
+
+        glfwGetFramebufferSize(m_window, &m_framebuffer_width, &m_framebuffer_height);
     }
 
-    void WindowSystem::pollEvents() const { glfwPollEvents(); }
+    void WindowSystem::pollEvents() const
+    {
+        glfwPollEvents();
+
+        // minimized 0,0, pause for now
+        while ((m_framebuffer_width == 0 || m_framebuffer_height == 0) && !shouldClose())
+        {
+            glfwWaitEvents();
+        }
+    }
 
     bool WindowSystem::shouldClose() const { return glfwWindowShouldClose(m_window); }
 
@@ -56,6 +68,11 @@ namespace Pilot
 
     std::array<int, 2> WindowSystem::getWindowSize() const { return std::array<int, 2>({m_width, m_height}); }
 
+    std::array<int, 2> WindowSystem::getFramebufferSize() const
+    {
+        return std::array<int, 2>({m_framebuffer_width, m_framebuffer_height});
+    }
+
     void WindowSystem::setFocusMode(bool mode)
     {
         m_is_focus_mode = mode;
@@ -28,6 +28,8 @@ namespace Pilot
         void               setTile(const char* title);
         GLFWwindow*        getWindow() const;
         std::array<int, 2> getWindowSize() const;
+        // recorded on the main thread, the render thread gets it through the swap data
+        std::array<int, 2> getFramebufferSize() const;
 
         typedef std::function<void()>                   onResetFunc;
         typedef std::function<void(int, int, int, int)> onKeyFunc;
@@ -139,6 +141,15 @@ namespace Pilot
                 app->m_height = height;
             }
         }
+        static void framebufferSizeCallback(GLFWwindow* window, int width, int height)
+        {
+            WindowSystem* app = (WindowSystem*)glfwGetWindowUserPointer(window);
+            if (app)
+            {
+                app->m_framebuffer_width  = width;
+                app->m_framebuffer_height = height;
+            }
+        }
         static void windowCloseCallback(GLFWwindow* window) { glfwSetWindowShouldClose(window, true); }
 
         void onReset()
@@ -196,6 +207,8 @@ namespace Pilot
         GLFWwindow* m_window {nullptr};
         int         m_width {0};
         int         m_height {0};
+        int         m_framebuffer_width {0};
+        int         m_framebuffer_height {0};
 
         bool m_is_focus_mode {false};
 
@@ -0,0 +1,111 @@
+#include "runtime/platform/file_service/mapped_file.h"
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Pilot
+{
+    bool MappedFile::open(const std::filesystem::path& path)
+    {
+        close();
+
+        // the view keeps the file mapped, the handles are closed right away
+#if defined(_WIN32)
+        HANDLE file_handle = CreateFileW(
+            path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_handle == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(file_handle, &file_size))
+        {
+            CloseHandle(file_handle);
+            return false;
+        }
+        if (file_size.QuadPart == 0)
+        {
+            CloseHandle(file_handle);
+            return true;
+        }
+
+        HANDLE mapping_handle = CreateFileMappingW(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file_handle);
+        if (mapping_handle == nullptr)
+        {
+            return false;
+        }
+
+        void* view = MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping_handle);
+        if (view == nullptr)
+        {
+            return false;
+        }
+
+        m_data = static_cast<const char*>(view);
+        m_size = static_cast<size_t>(file_size.QuadPart);
+#else
+        const int file_descriptor = ::open(path.c_str(), O_RDONLY);
+        if (file_descriptor < 0)
+        {
+            return false;
+        }
+
+        struct stat file_stat;
+        if (fstat(file_descriptor, &file_stat) != 0)
+        {
+            ::close(file_descriptor);
+            return false;
+        }
+        if (file_stat.st_size == 0)
+        {
+            ::close(file_descriptor);
+            return true;
+        }
+
+        const size_t file_size = static_cast<size_t>(file_stat.st_size);
+        void*        view      = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+        ::close(file_descriptor);
+        if (view == MAP_FAILED)
+        {
+            return false;
+        }
+        // read front to back once
+        madvise(view, file_size, MADV_SEQUENTIAL);
+
+        m_data = static_cast<const char*>(view);
+        m_size = file_size;
+#endif
+        return true;
+    }
+
+    void MappedFile::close()
+    {
+        if (m_data == nullptr)
+        {
+            return;
+        }
+
+#if defined(_WIN32)
+        UnmapViewOfFile(m_data);
+#else
+        munmap(const_cast<char*>(m_data), m_size);
+#endif
+        m_data = nullptr;
+        m_size = 0;
+    }
+} // namespace Pilot
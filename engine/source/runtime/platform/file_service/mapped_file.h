@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+
+namespace Pilot
+{
+    /// Read only view of a whole file mapped into memory, the pages are loaded by the os when first touched.
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        ~MappedFile() { close(); }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        // an empty file is opened with no data
+        bool open(const std::filesystem::path& path);
+        void close();
+
+        const char* data() const { return m_data; }
+        size_t      size() const { return m_size; }
+
+    private:
+        const char* m_data {nullptr};
+        size_t      m_size {0};
+    };
+} // namespace Pilot
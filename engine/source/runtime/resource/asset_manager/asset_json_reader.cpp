@@ -0,0 +1,270 @@
+#include "runtime/resource/asset_manager/asset_json_reader.h"
+
+#include "runtime/core/base/macro.h"
+#include "runtime/core/meta/serializer/serializer.h"
+
+#include "runtime/resource/res_type/common/level.h"
+#include "runtime/resource/res_type/data/animation_clip.h"
+#include "runtime/resource/res_type/data/mesh_data.h"
+
+#include "runtime/function/framework/component/component.h"
+
+#include <algorithm>
+#include <string_view>
+#include <vector>
+
+#include "_generated/serializer/all_serializer.h"
+
+namespace Pilot
+{
+    namespace
+    {
+        // declared first, the vector reader finds the element readers by ordinary lookup only
+        void readField(PJsonReader& reader, int& out_value);
+        void readField(PJsonReader& reader, float& out_value);
+        void readField(PJsonReader& reader, std::string& out_value);
+        void readField(PJsonReader& reader, Vector3& out_value);
+        void readField(PJsonReader& reader, Quaternion& out_value);
+        void readField(PJsonReader& reader, Vertex& out_value);
+        void readField(PJsonReader& reader, SkeletonBinding& out_value);
+        void readField(PJsonReader& reader, AnimNodeMap& out_value);
+        void readField(PJsonReader& reader, AnimationChannel& out_value);
+        void readField(PJsonReader& reader, AnimationClip& out_value);
+        void readField(PJsonReader& reader, ObjectInstanceRes& out_value);
+        void readField(PJsonReader& reader, Reflection::ReflectionPtr<Component>& out_value);
+
+        template<typename T>
+        void readField(PJsonReader& reader, std::vector<T>& out_values)
+        {
+            if (reader.peekType() != PJson::ARRAY)
+            {
+                // the generated reader takes anything else as an empty array
+                reader.skipValue();
+                out_values.clear();
+                return;
+            }
+
+            size_t value_count = 0;
+            reader.beginArray();
+            while (reader.nextElement())
+            {
+                if (value_count == out_values.size())
+                {
+                    out_values.emplace_back();
+                }
+                readField(reader, out_values[value_count++]);
+            }
+            out_values.resize(value_count);
+        }
+
+        // visit(name, field) for every member the reader knows, the same lists are checked against the reflection
+        template<typename Visitor>
+        void visitMembers(Vector3& value, Visitor&& visit)
+        {
+            visit("x", value.x);
+            visit("y", value.y);
+            visit("z", value.z);
+        }
+
+        template<typename Visitor>
+        void visitMembers(Quaternion& value, Visitor&& visit)
+        {
+            visit("w", value.w);
+            visit("x", value.x);
+            visit("y", value.y);
+            visit("z", value.z);
+        }
+
+        template<typename Visitor>
+        void visitMembers(Vertex& value, Visitor&& visit)
+        {
+            visit("px", value.px);
+            visit("py", value.py);
+            visit("pz", value.pz);
+            visit("nx", value.nx);
+            visit("ny", value.ny);
+            visit("nz", value.nz);
+            visit("tx", value.tx);
+            visit("ty", value.ty);
+            visit("tz", value.tz);
+            visit("u", value.u);
+            visit("v", value.v);
+        }
+
+        template<typename Visitor>
+        void visitMembers(SkeletonBinding& value, Visitor&& visit)
+        {
+            visit("index0", value.index0);
+            visit("index1", value.index1);
+            visit("index2", value.index2);
+            visit("index3", value.index3);
+            visit("weight0", value.weight0);
+            visit("weight1", value.weight1);
+            visit("weight2", value.weight2);
+            visit("weight3", value.weight3);
+        }
+
+        template<typename Visitor>
+        void visitMembers(AnimNodeMap& value, Visitor&& visit)
+        {
+            visit("convert", value.convert);
+        }
+
+        template<typename Visitor>
+        void visitMembers(AnimationChannel& value, Visitor&& visit)
+        {
+            visit("name", value.name);
+            visit("position_keys", value.position_keys);
+            visit("rotation_keys", value.rotation_keys);
+            visit("scaling_keys", value.scaling_keys);
+        }
+
+        template<typename Visitor>
+        void visitMembers(AnimationClip& value, Visitor&& visit)
+        {
+            visit("total_frame", value.total_frame);
+            visit("node_count", value.node_count);
+            visit("node_channels", value.node_channels);
+        }
+
+        template<typename Visitor>
+        void visitMembers(ObjectInstanceRes& value, Visitor&& visit)
+        {
+            visit("m_name", value.m_name);
+            visit("m_definition", value.m_definition);
+            visit("m_instanced_components", value.m_instanced_components);
+        }
+
+        template<typename Visitor>
+        void visitMembers(AnimationAsset& value, Visitor&& visit)
+        {
+            visit("node_map", value.node_map);
+            visit("clip_data", value.clip_data);
+            visit("skeleton_file_path", value.skeleton_file_path);
+        }
+
+        template<typename Visitor>
+        void visitMembers(MeshData& value, Visitor&& visit)
+        {
+            visit("vertex_buffer", value.vertex_buffer);
+            visit("index_buffer", value.index_buffer);
+            visit("bind", value.bind);
+        }
+
+        template<typename Visitor>
+        void visitMembers(LevelRes& value, Visitor&& visit)
+        {
+            visit("m_gravity", value.m_gravity);
+            visit("m_character_name", value.m_character_name);
+            visit("m_objects", value.m_objects);
+        }
+
+        // a null or unknown member keeps its value
+        template<typename T>
+        void readMembers(PJsonReader& reader, T& out_value)
+        {
+            if (reader.peekType() != PJson::OBJECT)
+            {
+                reader.skipValue();
+                return;
+            }
+
+            std::string_view key;
+            reader.beginObject();
+            while (reader.nextMember(key))
+            {
+                if (reader.skipNull())
+                    continue;
+
+                bool is_read = false;
+                visitMembers(out_value, [&](std::string_view member_name, auto& out_member) {
+                    if (!is_read && key == member_name)
+                    {
+                        readField(reader, out_member);
+                        is_read = true;
+                    }
+                });
+                if (!is_read)
+                {
+                    reader.skipValue();
+                }
+            }
+        }
+
+        // every reflected field of T must be visited, or the reader would silently skip it
+        template<typename T>
+        bool checkMembers(const char* type_name)
+        {
+            T                             value;
+            std::vector<std::string_view> member_names;
+            visitMembers(value, [&](std::string_view member_name, auto&) { member_names.push_back(member_name); });
+
+            const Reflection::TypeMeta& type_meta = Reflection::TypeMeta::getMetaFromName(type_name);
+            if (!type_meta.isValid())
+            {
+                LOG_ERROR("asset json reader of {} has no reflected type", type_name);
+                return false;
+            }
+
+            bool is_complete = true;
+            for (const Reflection::FieldAccessor& field : type_meta.getFields())
+            {
+                const std::string_view field_name = field.getFieldName();
+                if (std::find(member_names.begin(), member_names.end(), field_name) == member_names.end())
+                {
+                    LOG_ERROR("asset json reader of {} does not read field {}", type_name, field.getFieldName());
+                    is_complete = false;
+                }
+            }
+            return is_complete;
+        }
+
+        void readField(PJsonReader& reader, int& out_value) { out_value = static_cast<int>(reader.readNumber()); }
+
+        void readField(PJsonReader& reader, float& out_value) { out_value = static_cast<float>(reader.readNumber()); }
+
+        void readField(PJsonReader& reader, std::string& out_value) { reader.readString(out_value); }
+
+        void readField(PJsonReader& reader, Vector3& out_value) { readMembers(reader, out_value); }
+
+        void readField(PJsonReader& reader, Quaternion& out_value) { readMembers(reader, out_value); }
+
+        void readField(PJsonReader& reader, Vertex& out_value) { readMembers(reader, out_value); }
+
+        void readField(PJsonReader& reader, SkeletonBinding& out_value) { readMembers(reader, out_value); }
+
+        void readField(PJsonReader& reader, AnimNodeMap& out_value) { readMembers(reader, out_value); }
+
+        void readField(PJsonReader& reader, AnimationChannel& out_value) { readMembers(reader, out_value); }
+
+        void readField(PJsonReader& reader, AnimationClip& out_value) { readMembers(reader, out_value); }
+
+        void readField(PJsonReader& reader, ObjectInstanceRes& out_value) { readMembers(reader, out_value); }
+
+        void readField(PJsonReader& reader, Reflection::ReflectionPtr<Component>& out_value)
+        {
+            // the component type is only known from "$typeName", the generated reader builds it
+            const PJson component_json = reader.readValue();
+            PSerializer::read(component_json, out_value);
+        }
+    } // namespace
+
+    bool AssetJsonReader::checkFields()
+    {
+        // & instead of && to report every missing field at once
+        return checkMembers<Vector3>("Vector3") & checkMembers<Quaternion>("Quaternion") &
+               checkMembers<Vertex>("Vertex") & checkMembers<SkeletonBinding>("SkeletonBinding") &
+               checkMembers<AnimNodeMap>("AnimNodeMap") & checkMembers<AnimationChannel>("AnimationChannel") &
+               checkMembers<AnimationClip>("AnimationClip") & checkMembers<ObjectInstanceRes>("ObjectInstanceRes") &
+               checkMembers<AnimationAsset>("AnimationAsset") & checkMembers<MeshData>("MeshData") &
+               checkMembers<LevelRes>("LevelRes");
+    }
+
+    void AssetJsonReader::read(PJsonReader& reader, AnimationAsset& out_asset) { readMembers(reader, out_asset); }
+
+    void AssetJsonReader::read(PJsonReader& reader, AnimationClip& out_asset) { readField(reader, out_asset); }
+
+    void AssetJsonReader::read(PJsonReader& reader, MeshData& out_asset) { readMembers(reader, out_asset); }
+
+    void AssetJsonReader::read(PJsonReader& reader, LevelRes& out_asset) { readMembers(reader, out_asset); }
+} // namespace Pilot
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "runtime/core/meta/json_reader.h"
+
+#include <type_traits>
+#include <utility>
+
+namespace Pilot
+{
+    class AnimationAsset;
+    class AnimationClip;
+    class MeshData;
+    class LevelRes;
+
+    /// Readers of the largest assets straight from the json text, without the PJson tree.
+    /// They read like the generated PSerializer::read: a null or missing member keeps its value and an array
+    /// takes the size of the json array. Components held by ReflectionPtr still go through PSerializer.
+    class AssetJsonReader
+    {
+    public:
+        static void read(PJsonReader& reader, AnimationAsset& out_asset);
+        static void read(PJsonReader& reader, AnimationClip& out_asset);
+        static void read(PJsonReader& reader, MeshData& out_asset);
+        static void read(PJsonReader& reader, LevelRes& out_asset);
+
+        // after the reflection is registered: false, with an error for each, if a reflected field is not read
+        static bool checkFields();
+    };
+
+    template<typename T, typename = void>
+    struct has_asset_json_reader : std::false_type
+    {};
+
+    template<typename T>
+    struct has_asset_json_reader<
+        T,
+        std::void_t<decltype(AssetJsonReader::read(std::declval<PJsonReader&>(), std::declval<T&>()))>>
+        : std::true_type
+    {};
+} // namespace Pilot
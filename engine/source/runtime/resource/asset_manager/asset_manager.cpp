@@ -1,13 +1,243 @@
 #include "runtime/resource/asset_manager/asset_manager.h"
 
+#include "runtime/core/meta/serializer/binary_serializer.h"
+#include "runtime/core/profile/profiler.h"
+
+#include "runtime/resource/asset_manager/cooked_asset.h"
 #include "runtime/resource/config_manager/config_manager.h"
 
 #include "runtime/function/global/global_context.h"
 
 namespace Pilot
 {
+    AssetManager::~AssetManager() { clear(); }
+
+    void AssetManager::initialize(uint32_t loader_thread_count)
+    {
+        clear();
+
+        // a field added to one of these types would be silently skipped when loading
+        if (!AssetJsonReader::checkFields())
+        {
+            LOG_FATAL("the asset json readers do not match the reflected types");
+        }
+
+        m_is_loader_stopped = false;
+        for (uint32_t thread_index = 0; thread_index < loader_thread_count; ++thread_index)
+        {
+            m_loader_threads.emplace_back(&AssetManager::loaderThreadMain, this);
+        }
+    }
+
+    void AssetManager::clear()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_load_mutex);
+            m_is_loader_stopped = true;
+        }
+        m_load_condition.notify_all();
+
+        for (std::thread& loader_thread : m_loader_threads)
+        {
+            loader_thread.join();
+        }
+        m_loader_threads.clear();
+
+        // finish what is left so that every future gets a value
+        while (true)
+        {
+            std::shared_ptr<AssetLoadTask> task;
+            {
+                std::lock_guard<std::mutex> lock(m_load_mutex);
+                task = popLoadTask();
+            }
+            if (!task)
+            {
+                break;
+            }
+            task->m_load_func();
+        }
+    }
+
     std::filesystem::path AssetManager::getFullPath(const std::string& relative_path) const
     {
         return g_runtime_global_context.m_config_manager->getRootFolder() / relative_path;
     }
-} // namespace Pilot
\ No newline at end of file
+
+    std::filesystem::path AssetManager::getCookedPath(const std::string& asset_url) const
+    {
+        const std::shared_ptr<ConfigManager>& config_manager = g_runtime_global_context.m_config_manager;
+        if (config_manager->getCookedFolder().empty())
+        {
+            return std::filesystem::path();
+        }
+
+        std::filesystem::path relative_path = asset_url;
+        if (relative_path.is_absolute())
+        {
+            relative_path = relative_path.lexically_relative(config_manager->getRootFolder());
+        }
+        return CookedAsset::getCookedPath(config_manager->getCookedFolder(), relative_path.generic_string());
+    }
+
+    bool AssetManager::readCookedJson(const std::string& asset_url, PJson& out_json) const
+    {
+        const std::filesystem::path cooked_path = getCookedPath(asset_url);
+        if (cooked_path.empty())
+        {
+            return false;
+        }
+
+        MappedFile cooked_file;
+        if (!cooked_file.open(cooked_path))
+        {
+            // not cooked
+            return false;
+        }
+
+        PROFILE_SCOPE("AssetManager::readCookedJson");
+
+        const uint8_t* cooked_data = reinterpret_cast<const uint8_t*>(cooked_file.data());
+
+        CookedAssetHeader header;
+        size_t            archive_offset = 0;
+        if (!CookedAsset::readHeader(cooked_data, cooked_file.size(), header, archive_offset))
+        {
+            LOG_WARN("cooked asset {} is invalid, load the source", asset_url);
+            return false;
+        }
+
+        const std::filesystem::path& root_folder = g_runtime_global_context.m_config_manager->getRootFolder();
+        for (const CookedAssetDependency& dependency : header.m_dependencies)
+        {
+            if (!CookedAsset::isUpToDate(root_folder, dependency))
+            {
+                LOG_INFO("cooked asset {} is out of date, load the source", asset_url);
+                return false;
+            }
+        }
+
+        // fails if a reflected field changed since the asset was cooked
+        if (!PBinarySerializer::readJson(cooked_data + archive_offset,
+                                         cooked_file.size() - archive_offset,
+                                         header.m_type_name,
+                                         out_json))
+        {
+            LOG_INFO("cooked asset {} does not match the current schema, load the source", asset_url);
+            return false;
+        }
+        return true;
+    }
+
+    bool AssetManager::writeTextFile(const std::string& asset_url, const std::string& text) const
+    {
+        const std::filesystem::path asset_path     = getFullPath(asset_url);
+        std::filesystem::path       temporary_path = asset_path;
+        temporary_path += ".tmp";
+
+        {
+            std::ofstream asset_file(temporary_path, std::ios::binary | std::ios::trunc);
+            if (!asset_file)
+            {
+                LOG_ERROR("open file {} failed!", asset_url);
+                return false;
+            }
+
+            asset_file.write(text.data(), static_cast<std::streamsize>(text.size()));
+            if (!asset_file.flush())
+            {
+                LOG_ERROR("write file {} failed!", asset_url);
+                return false;
+            }
+        }
+
+        std::error_code error;
+        std::filesystem::rename(temporary_path, asset_path, error);
+        if (error)
+        {
+            LOG_ERROR("replace file {} failed: {}", asset_url, error.message());
+            return false;
+        }
+        return true;
+    }
+
+    std::shared_future<bool> AssetManager::saveJsonAsync(PJson asset_json, const std::string& asset_url)
+    {
+        std::shared_ptr<std::promise<bool>> promise = std::make_shared<std::promise<bool>>();
+        std::shared_future<bool>            future  = promise->get_future().share();
+
+        // not registered in m_load_tasks, two saves of one url must not be merged
+        std::shared_ptr<AssetLoadTask> task = std::make_shared<AssetLoadTask>();
+        task->m_load_key                    = asset_url;
+        task->m_load_func = [this, asset_json = std::move(asset_json), asset_url, promise]() {
+            PROFILE_SCOPE("AssetManager::saveJsonAsync");
+            const bool is_save_success = writeTextFile(asset_url, asset_json.dump());
+            if (is_save_success)
+            {
+                LOG_INFO("saved {}", asset_url);
+            }
+            promise->set_value(is_save_success);
+        };
+
+        std::unique_lock<std::mutex> lock(m_load_mutex);
+        if (m_loader_threads.empty())
+        {
+            // no loader thread, save right here
+            task->m_is_started = true;
+            lock.unlock();
+            task->m_load_func();
+            return future;
+        }
+
+        pushLoadTask(task);
+        return future;
+    }
+
+    void AssetManager::pushLoadTask(const std::shared_ptr<AssetLoadTask>& task)
+    {
+        m_load_queue.push({task->m_priority, m_load_sequence++, task});
+        m_load_condition.notify_one();
+    }
+
+    std::shared_ptr<AssetManager::AssetLoadTask> AssetManager::popLoadTask()
+    {
+        while (!m_load_queue.empty())
+        {
+            std::shared_ptr<AssetLoadTask> task = m_load_queue.top().m_task;
+            m_load_queue.pop();
+
+            // a task is queued again when its priority is raised, the older entry is skipped
+            if (!task->m_is_started)
+            {
+                task->m_is_started = true;
+                return task;
+            }
+        }
+        return nullptr;
+    }
+
+    void AssetManager::loaderThreadMain()
+    {
+        PROFILE_THREAD("asset loader thread");
+
+        while (true)
+        {
+            std::shared_ptr<AssetLoadTask> task;
+            {
+                std::unique_lock<std::mutex> lock(m_load_mutex);
+                m_load_condition.wait(lock, [this] { return m_is_loader_stopped || !m_load_queue.empty(); });
+                if (m_is_loader_stopped)
+                {
+                    return;
+                }
+
+                task = popLoadTask();
+            }
+
+            if (task)
+            {
+                task->m_load_func();
+            }
+        }
+    }
+} // namespace Pilot
@@ -1,42 +1,119 @@
 #pragma once
 
 #include "runtime/core/base/macro.h"
+#include "runtime/core/meta/json_parser.h"
 #include "runtime/core/meta/serializer/serializer.h"
 
+#include "runtime/resource/asset_manager/asset_json_reader.h"
+#include "runtime/resource/asset_manager/cooked_asset.h"
+#include "runtime/resource/asset_manager/mesh_bounds_cache.h"
+
+#include "runtime/platform/file_service/mapped_file.h"
+
+#include <condition_variable>
 #include <filesystem>
 #include <fstream>
 #include <functional>
-#include <sstream>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
 #include <string>
+#include <thread>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
 
 #include "_generated/serializer/all_serializer.h"
 
 namespace Pilot
 {
+    enum class AssetLoadPriority : unsigned char
+    {
+        low,
+        normal,
+        high, // gameplay critical, jumps the queue
+    };
+
     class AssetManager
     {
     public:
+        template<typename AssetType>
+        using AssetFuture = std::shared_future<std::shared_ptr<const AssetType>>;
+        template<typename AssetType>
+        using AssetCallback = std::function<void(std::shared_ptr<const AssetType>)>;
+
+        ~AssetManager();
+
+        // start the loader threads used by loadAssetAsync
+        void initialize(uint32_t loader_thread_count = 2);
+        // stop the loader threads, queued loads are finished on the calling thread
+        void clear();
+
         template<typename AssetType>
         bool loadAsset(const std::string& asset_url, AssetType& out_asset) const
         {
-            // read json file to string
-            std::ifstream asset_json_file(getFullPath(asset_url));
-            if (!asset_json_file)
+            if constexpr (is_cookable_asset<AssetType>::value)
             {
-                LOG_ERROR("open file: {} failed!", asset_url);
-                return false;
+                // an up to date cooked asset skips the json parsing
+                if (loadCookedAsset(asset_url, out_asset))
+                {
+                    return true;
+                }
+            }
+
+            if constexpr (has_asset_json_reader<AssetType>::value)
+            {
+                // read the mapped file straight into the asset, no copy of the text and no PJson tree
+                // a file failing to parse may leave the asset partly read
+                MappedFile asset_file;
+                if (!asset_file.open(getFullPath(asset_url)))
+                {
+                    LOG_ERROR("open file: {} failed!", asset_url);
+                    return false;
+                }
+
+                PJsonReader asset_reader(asset_file.data(), asset_file.size());
+                AssetJsonReader::read(asset_reader, out_asset);
+                if (!asset_reader.isValid() || !asset_reader.isAtEnd())
+                {
+                    LOG_ERROR("parse json file {} failed!", asset_url);
+                    return false;
+                }
+                return true;
             }
+            else
+            {
+                MappedFile asset_file;
+                if (!asset_file.open(getFullPath(asset_url)))
+                {
+                    LOG_ERROR("open file: {} failed!", asset_url);
+                    return false;
+                }
+
+                // parse to json object and read to runtime res object
+                std::string error;
+                auto&&      asset_json = PJsonParser::parse(asset_file.data(), asset_file.size(), error);
+                if (!error.empty())
+                {
+                    LOG_ERROR("parse json file {} failed!", asset_url);
+                    return false;
+                }
+
+                PSerializer::read(asset_json, out_asset);
+                return true;
+            }
+        }
 
-            std::stringstream buffer;
-            buffer << asset_json_file.rdbuf();
-            std::string asset_json_text(buffer.str());
+        /// load the asset written by PilotAssetCooker for asset_url, false if there is none or a source changed since
+        template<typename AssetType>
+        bool loadCookedAsset(const std::string& asset_url, AssetType& out_asset) const
+        {
+            static_assert(is_cookable_asset<AssetType>::value, "PilotAssetCooker does not cook this type");
 
-            // parse to json object and read to runtime res object
-            std::string error;
-            auto&&      asset_json = PJson::parse(asset_json_text, error);
-            if (!error.empty())
+            PJson asset_json;
+            if (!readCookedJson(asset_url, asset_json))
             {
-                LOG_ERROR("parse json file {} failed!", asset_url);
                 return false;
             }
 
@@ -47,25 +124,151 @@ namespace Pilot
         template<typename AssetType>
         bool saveAsset(const AssetType& out_asset, const std::string& asset_url) const
         {
-            std::ofstream asset_json_file(getFullPath(asset_url));
-            if (!asset_json_file)
-            {
-                LOG_ERROR("open file {} failed!", asset_url);
-                return false;
-            }
-
             // write to json object and dump to string
             auto&&        asset_json      = PSerializer::write(out_asset);
             std::string&& asset_json_text = asset_json.dump();
 
-            // write to file
-            asset_json_file << asset_json_text;
-            asset_json_file.flush();
+            return writeTextFile(asset_url, asset_json_text);
+        }
 
-            return true;
+        /// dump and write a json already built from the asset on a loader thread.
+        /// The json is immutable, so the asset can change meanwhile. Saves are run in no particular order, wait for
+        /// the previous save of an url before starting the next one
+        std::shared_future<bool> saveJsonAsync(PJson asset_json, const std::string& asset_url);
+
+        /// load the asset on a loader thread, the result is null if loading failed.
+        /// Concurrent requests for the same url and type share one load, the callback runs on the loader thread
+        template<typename AssetType>
+        AssetFuture<AssetType> loadAssetAsync(const std::string&       asset_url,
+                                              AssetLoadPriority        priority = AssetLoadPriority::normal,
+                                              AssetCallback<AssetType> callback = nullptr)
+        {
+            const std::string load_key = asset_url + '|' + typeid(AssetType).name();
+
+            std::unique_lock<std::mutex> lock(m_load_mutex);
+
+            auto iter = m_load_tasks.find(load_key);
+            if (iter != m_load_tasks.end())
+            {
+                // already requested, join it
+                std::shared_ptr<AssetLoadTask>         task  = iter->second;
+                std::shared_ptr<AssetLoadState<AssetType>> state =
+                    std::static_pointer_cast<AssetLoadState<AssetType>>(task->m_state);
+                if (callback)
+                {
+                    state->m_callbacks.push_back(std::move(callback));
+                }
+                if (priority > task->m_priority && !task->m_is_started)
+                {
+                    task->m_priority = priority;
+                    pushLoadTask(task);
+                }
+                return state->m_future;
+            }
+
+            std::shared_ptr<AssetLoadState<AssetType>> state = std::make_shared<AssetLoadState<AssetType>>();
+            state->m_future                                  = state->m_promise.get_future().share();
+            if (callback)
+            {
+                state->m_callbacks.push_back(std::move(callback));
+            }
+
+            std::shared_ptr<AssetLoadTask> task = std::make_shared<AssetLoadTask>();
+            task->m_load_key                    = load_key;
+            task->m_priority                    = priority;
+            task->m_state                       = state;
+            task->m_load_func                   = [this, asset_url, load_key, state]() {
+                std::shared_ptr<AssetType> asset = std::make_shared<AssetType>();
+                if (!loadAsset(asset_url, *asset))
+                {
+                    asset.reset();
+                }
+
+                // no request can join once the task is gone, so no callback is missed
+                std::vector<AssetCallback<AssetType>> callbacks;
+                {
+                    std::lock_guard<std::mutex> lock(m_load_mutex);
+                    m_load_tasks.erase(load_key);
+                    callbacks.swap(state->m_callbacks);
+                }
+
+                state->m_promise.set_value(asset);
+                for (const AssetCallback<AssetType>& callback : callbacks)
+                {
+                    callback(asset);
+                }
+            };
+            m_load_tasks.emplace(load_key, task);
+
+            if (m_loader_threads.empty())
+            {
+                // no loader thread, load right here
+                task->m_is_started = true;
+                lock.unlock();
+                task->m_load_func();
+                return state->m_future;
+            }
+
+            pushLoadTask(task);
+            return state->m_future;
         }
 
         std::filesystem::path getFullPath(const std::string& relative_path) const;
 
+        // boxes of the mesh files, measured by the render resource or by the level indexing an object first
+        MeshBoundsCache& getMeshBoundsCache() { return m_mesh_bounds_cache; }
+        // empty if no cooked folder is configured, asset_url may be a full path under the root folder
+        std::filesystem::path getCookedPath(const std::string& asset_url) const;
+
+    private:
+        template<typename AssetType>
+        struct AssetLoadState
+        {
+            std::promise<std::shared_ptr<const AssetType>> m_promise;
+            AssetFuture<AssetType>                         m_future;
+            std::vector<AssetCallback<AssetType>>          m_callbacks;
+        };
+
+        struct AssetLoadTask
+        {
+            std::string           m_load_key;
+            AssetLoadPriority     m_priority {AssetLoadPriority::normal};
+            bool                  m_is_started {false};
+            std::shared_ptr<void> m_state;
+            std::function<void()> m_load_func;
+        };
+
+        struct AssetLoadQueueEntry
+        {
+            AssetLoadPriority              m_priority;
+            uint64_t                       m_sequence;
+            std::shared_ptr<AssetLoadTask> m_task;
+
+            // higher priority first, then first come first served
+            bool operator<(const AssetLoadQueueEntry& rhs) const
+            {
+                return m_priority != rhs.m_priority ? m_priority < rhs.m_priority : m_sequence > rhs.m_sequence;
+            }
+        };
+
+        bool readCookedJson(const std::string& asset_url, PJson& out_json) const;
+        // write to a temporary file first, so a failed write keeps the previous file
+        bool writeTextFile(const std::string& asset_url, const std::string& text) const;
+
+        // m_load_mutex must be held
+        void pushLoadTask(const std::shared_ptr<AssetLoadTask>& task);
+        // m_load_mutex must be held, return null if the queue is empty
+        std::shared_ptr<AssetLoadTask> popLoadTask();
+        void                           loaderThreadMain();
+
+        std::mutex                                                      m_load_mutex;
+        std::condition_variable                                         m_load_condition;
+        std::priority_queue<AssetLoadQueueEntry>                        m_load_queue;
+        std::unordered_map<std::string, std::shared_ptr<AssetLoadTask>> m_load_tasks;
+        uint64_t                                                        m_load_sequence {0};
+        bool                                                            m_is_loader_stopped {false};
+        std::vector<std::thread>                                        m_loader_threads;
+
+        MeshBoundsCache m_mesh_bounds_cache;
     };
 } // namespace Pilot
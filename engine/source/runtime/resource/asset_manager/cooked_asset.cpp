@@ -0,0 +1,200 @@
+#include "runtime/resource/asset_manager/cooked_asset.h"
+
+#include <cstring>
+#include <fstream>
+
+namespace Pilot
+{
+    namespace
+    {
+        constexpr uint32_t k_cooked_asset_magic = 0x444B4350; // "PCKD"
+
+        template<typename T>
+        void appendValue(std::vector<uint8_t>& data, const T& value)
+        {
+            const uint8_t* first = reinterpret_cast<const uint8_t*>(&value);
+            data.insert(data.end(), first, first + sizeof(T));
+        }
+
+        void appendString(std::vector<uint8_t>& data, const std::string& text)
+        {
+            appendValue(data, static_cast<uint32_t>(text.size()));
+            data.insert(data.end(), text.begin(), text.end());
+        }
+
+        class CookedAssetReader
+        {
+        public:
+            CookedAssetReader(const uint8_t* data, size_t size) : m_begin(data), m_cursor(data), m_end(data + size) {}
+
+            bool   isValid() const { return m_is_valid; }
+            size_t getOffset() const { return static_cast<size_t>(m_cursor - m_begin); }
+
+            template<typename T>
+            T readValue()
+            {
+                T value {};
+                if (!m_is_valid || static_cast<size_t>(m_end - m_cursor) < sizeof(T))
+                {
+                    m_is_valid = false;
+                    return value;
+                }
+                std::memcpy(&value, m_cursor, sizeof(T));
+                m_cursor += sizeof(T);
+                return value;
+            }
+
+            std::string readString()
+            {
+                const uint32_t length = readValue<uint32_t>();
+                if (!m_is_valid || static_cast<size_t>(m_end - m_cursor) < length)
+                {
+                    m_is_valid = false;
+                    return std::string();
+                }
+                std::string text(reinterpret_cast<const char*>(m_cursor), length);
+                m_cursor += length;
+                return text;
+            }
+
+        private:
+            const uint8_t* m_begin;
+            const uint8_t* m_cursor;
+            const uint8_t* m_end;
+            bool           m_is_valid {true};
+        };
+
+        bool getFileStamp(const std::filesystem::path& path, uint64_t& out_file_size, int64_t& out_write_time)
+        {
+            std::error_code error;
+            out_file_size = std::filesystem::file_size(path, error);
+            if (error)
+            {
+                return false;
+            }
+            out_write_time = std::filesystem::last_write_time(path, error).time_since_epoch().count();
+            return !error;
+        }
+
+        bool hashFile(const std::filesystem::path& path, uint64_t& out_hash)
+        {
+            std::ifstream file(path, std::ios::binary | std::ios::ate);
+            if (!file)
+            {
+                return false;
+            }
+
+            const std::streamsize file_size = file.tellg();
+            file.seekg(0, std::ios::beg);
+
+            std::vector<uint8_t> content(static_cast<size_t>(file_size));
+            if (file_size != 0 && !file.read(reinterpret_cast<char*>(content.data()), file_size))
+            {
+                return false;
+            }
+            out_hash = CookedAsset::hashContent(content.data(), content.size());
+            return true;
+        }
+    } // namespace
+
+    std::filesystem::path CookedAsset::getCookedPath(const std::filesystem::path& cooked_folder,
+                                                     const std::string&           asset_url)
+    {
+        std::filesystem::path cooked_path = cooked_folder / std::filesystem::path(asset_url).relative_path();
+        cooked_path += ".bin";
+        return cooked_path;
+    }
+
+    bool CookedAsset::makeDependency(const std::filesystem::path& root_folder,
+                                     const std::string&           url,
+                                     CookedAssetDependency&       out_dependency)
+    {
+        const std::filesystem::path path = root_folder / url;
+
+        out_dependency.m_url = url;
+        return getFileStamp(path, out_dependency.m_file_size, out_dependency.m_write_time) &&
+               hashFile(path, out_dependency.m_content_hash);
+    }
+
+    bool CookedAsset::isUpToDate(const std::filesystem::path& root_folder, const CookedAssetDependency& dependency)
+    {
+        const std::filesystem::path path = root_folder / dependency.m_url;
+
+        uint64_t file_size  = 0;
+        int64_t  write_time = 0;
+        if (!getFileStamp(path, file_size, write_time) || file_size != dependency.m_file_size)
+        {
+            return false;
+        }
+        if (write_time == dependency.m_write_time)
+        {
+            return true;
+        }
+
+        // touched or copied, only the content tells
+        uint64_t content_hash = 0;
+        return hashFile(path, content_hash) && content_hash == dependency.m_content_hash;
+    }
+
+    void CookedAsset::write(const CookedAssetHeader&    header,
+                            const std::vector<uint8_t>& archive,
+                            std::vector<uint8_t>&       out_data)
+    {
+        out_data.clear();
+        appendValue(out_data, k_cooked_asset_magic);
+        appendValue(out_data, k_cook_version);
+        appendString(out_data, header.m_type_name);
+
+        appendValue(out_data, static_cast<uint32_t>(header.m_dependencies.size()));
+        for (const CookedAssetDependency& dependency : header.m_dependencies)
+        {
+            appendString(out_data, dependency.m_url);
+            appendValue(out_data, dependency.m_file_size);
+            appendValue(out_data, dependency.m_write_time);
+            appendValue(out_data, dependency.m_content_hash);
+        }
+
+        out_data.insert(out_data.end(), archive.begin(), archive.end());
+    }
+
+    bool CookedAsset::readHeader(const uint8_t*     data,
+                                 size_t             size,
+                                 CookedAssetHeader& out_header,
+                                 size_t&            out_archive_offset)
+    {
+        CookedAssetReader reader(data, size);
+        if (reader.readValue<uint32_t>() != k_cooked_asset_magic || reader.readValue<uint32_t>() != k_cook_version)
+        {
+            return false;
+        }
+
+        out_header.m_type_name = reader.readString();
+
+        const uint32_t dependency_count = reader.readValue<uint32_t>();
+        out_header.m_dependencies.clear();
+        for (uint32_t dependency_index = 0; dependency_index < dependency_count && reader.isValid(); ++dependency_index)
+        {
+            CookedAssetDependency dependency;
+            dependency.m_url          = reader.readString();
+            dependency.m_file_size    = reader.readValue<uint64_t>();
+            dependency.m_write_time   = reader.readValue<int64_t>();
+            dependency.m_content_hash = reader.readValue<uint64_t>();
+            out_header.m_dependencies.push_back(std::move(dependency));
+        }
+
+        out_archive_offset = reader.getOffset();
+        return reader.isValid();
+    }
+
+    uint64_t CookedAsset::hashContent(const uint8_t* data, size_t size)
+    {
+        // FNV-1a
+        uint64_t hash = 0xCBF29CE484222325ull;
+        for (size_t index = 0; index < size; ++index)
+        {
+            hash ^= data[index];
+            hash *= 0x100000001B3ull;
+        }
+        return hash;
+    }
+} // namespace Pilot
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Pilot
+{
+    class AnimationAsset;
+    class AnimSkelMap;
+    class BoneBlendMask;
+    class MaterialRes;
+    class MeshData;
+    class SkeletonData;
+
+    // the types PilotAssetCooker cooks, AssetManager::loadAsset only looks for a cooked file for them
+    template<typename T>
+    struct is_cookable_asset : std::false_type
+    {};
+
+    template<>
+    struct is_cookable_asset<AnimationAsset> : std::true_type
+    {};
+
+    template<>
+    struct is_cookable_asset<AnimSkelMap> : std::true_type
+    {};
+
+    template<>
+    struct is_cookable_asset<BoneBlendMask> : std::true_type
+    {};
+
+    template<>
+    struct is_cookable_asset<MaterialRes> : std::true_type
+    {};
+
+    template<>
+    struct is_cookable_asset<MeshData> : std::true_type
+    {};
+
+    template<>
+    struct is_cookable_asset<SkeletonData> : std::true_type
+    {};
+
+    // a source file the cooked asset was built from
+    struct CookedAssetDependency
+    {
+        std::string m_url;
+        uint64_t    m_file_size {0};
+        int64_t     m_write_time {0};
+        // FNV-1a of the file content
+        uint64_t m_content_hash {0};
+    };
+
+    struct CookedAssetHeader
+    {
+        // reflected type of the archive
+        std::string                        m_type_name;
+        std::vector<CookedAssetDependency> m_dependencies;
+    };
+
+    /// Asset converted offline by PilotAssetCooker, stored as root/cooked/<asset url>.bin.
+    /// The file is a header listing the source files it was built from followed by a PBinarySerializer archive.
+    /// The archive is decoded back into a PJson before PSerializer::read, so cooking skips the text parsing only.
+    /// A dependency whose size and write time are unchanged is up to date without being read, otherwise its content
+    /// hash is compared, so copying the asset folder does not invalidate everything.
+    class CookedAsset
+    {
+    public:
+        // bump when the cooked file layout changes
+        static constexpr uint32_t k_cook_version = 1;
+
+        static std::filesystem::path getCookedPath(const std::filesystem::path& cooked_folder,
+                                                   const std::string&           asset_url);
+
+        // fill size, write time and content hash from the file, return false if it can not be read
+        static bool makeDependency(const std::filesystem::path& root_folder,
+                                   const std::string&           url,
+                                   CookedAssetDependency&       out_dependency);
+        static bool isUpToDate(const std::filesystem::path& root_folder, const CookedAssetDependency& dependency);
+
+        static void write(const CookedAssetHeader&    header,
+                          const std::vector<uint8_t>& archive,
+                          std::vector<uint8_t>&       out_data);
+        // out_archive_offset is where the PBinarySerializer archive starts in data
+        static bool readHeader(const uint8_t* data, size_t size, CookedAssetHeader& out_header, size_t& out_archive_offset);
+
+        static uint64_t hashContent(const uint8_t* data, size_t size);
+    };
+} // namespace Pilot
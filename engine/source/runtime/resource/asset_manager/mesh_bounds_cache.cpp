@@ -0,0 +1,67 @@
+#include "runtime/resource/asset_manager/mesh_bounds_cache.h"
+
+#include <filesystem>
+
+namespace Pilot
+{
+    bool MeshBoundsCache::getBounds(const std::string&  mesh_file,
+                                    const BoundsLoader& load_bounds,
+                                    AxisAlignedBox&     out_bounds)
+    {
+        const int64_t write_time = getWriteTime(mesh_file);
+
+        std::promise<MeshBounds>       promise;
+        std::shared_future<MeshBounds> bounds_future;
+        bool                           is_loader = false;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            Entry& entry = m_entries[mesh_file];
+            if (!entry.m_bounds.valid() || entry.m_write_time != write_time)
+            {
+                entry.m_write_time = write_time;
+                entry.m_bounds     = promise.get_future().share();
+                is_loader          = true;
+            }
+            bounds_future = entry.m_bounds;
+        }
+
+        if (is_loader)
+        {
+            MeshBounds mesh_bounds;
+            mesh_bounds.m_is_valid = load_bounds(mesh_bounds.m_bounds);
+            promise.set_value(mesh_bounds);
+        }
+
+        const MeshBounds& mesh_bounds = bounds_future.get();
+        if (mesh_bounds.m_is_valid)
+        {
+            out_bounds = mesh_bounds.m_bounds;
+        }
+        return mesh_bounds.m_is_valid;
+    }
+
+    void MeshBoundsCache::storeBounds(const std::string& mesh_file, const AxisAlignedBox& bounds)
+    {
+        std::promise<MeshBounds> promise;
+        promise.set_value({true, bounds});
+
+        const int64_t write_time = getWriteTime(mesh_file);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_entries[mesh_file] = {write_time, promise.get_future().share()};
+    }
+
+    void MeshBoundsCache::clear()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_entries.clear();
+    }
+
+    int64_t MeshBoundsCache::getWriteTime(const std::string& mesh_file)
+    {
+        std::error_code error;
+        const auto      write_time = std::filesystem::last_write_time(mesh_file, error);
+        return error ? 0 : static_cast<int64_t>(write_time.time_since_epoch().count());
+    }
+} // namespace Pilot
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "runtime/core/math/axis_aligned.h"
+
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace Pilot
+{
+    /// Object space boxes of the mesh files, shared by the render resource which computes them while loading the
+    /// meshes and the level which indexes the objects. A box is kept with the write time of its file, so a mesh
+    /// written again is measured again.
+    class MeshBoundsCache
+    {
+    public:
+        using BoundsLoader = std::function<bool(AxisAlignedBox& out_bounds)>;
+
+        // false if the mesh has no vertices. load_bounds runs without the lock when the box is not known, a thread
+        // asking for a mesh being measured waits for it while the other meshes go on
+        bool getBounds(const std::string& mesh_file, const BoundsLoader& load_bounds, AxisAlignedBox& out_bounds);
+        // the box of a mesh measured elsewhere
+        void storeBounds(const std::string& mesh_file, const AxisAlignedBox& bounds);
+
+        void clear();
+
+    private:
+        struct MeshBounds
+        {
+            bool           m_is_valid {false};
+            AxisAlignedBox m_bounds;
+        };
+
+        struct Entry
+        {
+            int64_t                        m_write_time {0};
+            std::shared_future<MeshBounds> m_bounds;
+        };
+
+        static int64_t getWriteTime(const std::string& mesh_file);
+
+        std::mutex                             m_mutex;
+        std::unordered_map<std::string, Entry> m_entries;
+    };
+} // namespace Pilot
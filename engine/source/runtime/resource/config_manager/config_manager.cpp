@@ -24,6 +24,10 @@ namespace Pilot
                 {
                     m_asset_folder = m_root_folder / value;
                 }
+                else if (name == "CookedFolder")
+                {
+                    m_cooked_folder = m_root_folder / value;
+                }
                 else if (name == "SchemaFolder")
                 {
                     m_schema_folder = m_root_folder / value;
@@ -48,6 +52,22 @@ namespace Pilot
                 {
                     m_global_rendering_res_url = value;
                 }
+                else if (name == "EnableRenderThread")
+                {
+                    m_enable_render_thread = (value == "true" || value == "1");
+                }
+                else if (name == "EnableParallelTick")
+                {
+                    m_enable_parallel_tick = (value == "true" || value == "1");
+                }
+                else if (name == "EnableComponentPool")
+                {
+                    m_enable_component_pool = (value == "true" || value == "1");
+                }
+                else if (name == "JsonBackend")
+                {
+                    m_json_backend = value == "json11" ? PJsonBackend::json11 : PJsonBackend::reader;
+                }
 #ifdef ENABLE_PHYSICS_DEBUG_RENDERER
                 else if (name == "JoltAssetFolder")
                 {
@@ -62,6 +82,8 @@ namespace Pilot
 
     const std::filesystem::path& ConfigManager::getAssetFolder() const { return m_asset_folder; }
 
+    const std::filesystem::path& ConfigManager::getCookedFolder() const { return m_cooked_folder; }
+
     const std::filesystem::path& ConfigManager::getSchemaFolder() const { return m_schema_folder; }
 
     const std::filesystem::path& ConfigManager::getEditorBigIconPath() const { return m_editor_big_icon_path; }
@@ -74,6 +96,14 @@ namespace Pilot
 
     const std::string& ConfigManager::getGlobalRenderingResUrl() const { return m_global_rendering_res_url; }
 
+    bool ConfigManager::isRenderThreadEnabled() const { return m_enable_render_thread; }
+
+    bool ConfigManager::isParallelTickEnabled() const { return m_enable_parallel_tick; }
+
+    bool ConfigManager::isComponentPoolEnabled() const { return m_enable_component_pool; }
+
+    PJsonBackend ConfigManager::getJsonBackend() const { return m_json_backend; }
+
 #ifdef ENABLE_PHYSICS_DEBUG_RENDERER
     const std::filesystem::path& ConfigManager::getJoltPhysicsAssetFolder() const { return m_jolt_physics_asset_folder; }
 #endif
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "runtime/core/meta/json_parser.h"
+
 #include <filesystem>
 
 namespace Pilot
@@ -13,6 +15,8 @@ namespace Pilot
 
         const std::filesystem::path& getRootFolder() const;
         const std::filesystem::path& getAssetFolder() const;
+        // empty if cooked assets are not used
+        const std::filesystem::path& getCookedFolder() const;
         const std::filesystem::path& getSchemaFolder() const;
         const std::filesystem::path& getEditorBigIconPath() const;
         const std::filesystem::path& getEditorSmallIconPath() const;
@@ -25,9 +29,16 @@ namespace Pilot
         const std::string& getDefaultWorldUrl() const;
         const std::string& getGlobalRenderingResUrl() const;
 
+        bool isRenderThreadEnabled() const;
+        bool isParallelTickEnabled() const;
+        bool isComponentPoolEnabled() const;
+        // JsonBackend=json11 parses the assets with PJson::parse instead of the vectorized reader
+        PJsonBackend getJsonBackend() const;
+
     private:
         std::filesystem::path m_root_folder;
         std::filesystem::path m_asset_folder;
+        std::filesystem::path m_cooked_folder;
         std::filesystem::path m_schema_folder;
         std::filesystem::path m_editor_big_icon_path;
         std::filesystem::path m_editor_small_icon_path;
@@ -39,5 +50,11 @@ namespace Pilot
 
         std::string m_default_world_url;
         std::string m_global_rendering_res_url;
+
+        bool m_enable_render_thread {false};
+        bool m_enable_parallel_tick {false};
+        bool m_enable_component_pool {false};
+
+        PJsonBackend m_json_backend {PJsonBackend::reader};
     };
 } // namespace Pilot
@@ -1,4 +1,5 @@
 #pragma once
+#include "runtime/core/math/vector3.h"
 #include "runtime/core/meta/reflection/reflection.h"
 
 #include "runtime/resource/res_type/common/object.h"
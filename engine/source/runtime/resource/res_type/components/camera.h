@@ -33,7 +33,9 @@ namespace Pilot
         META(Enable)
         float m_horizontal_offset {3.f};
         META(Enable)
-        float      m_vertical_offset {2.5f};
+        float m_vertical_offset {2.5f};
+        // look state of the player, saved with the level and part of the level snapshots
+        META(Enable)
         Quaternion m_cursor_pitch;
         Quaternion m_cursor_yaw;
     };
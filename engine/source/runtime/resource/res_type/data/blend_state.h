@@ -80,12 +80,14 @@ namespace Pilot
         std::vector<std::string> m_blend_mask_file_path;
         std::vector<float>       m_blend_ratio;
         virtual ~BlendState() override {}
-        virtual float getLength() const override
+        virtual float getLength() const override { return getLength(m_blend_weight); }
+        // length with the weights of a blend being played
+        float getLength(const std::vector<float>& blend_weights) const
         {
             float length = 0;
             for (int i = 0; i < m_clip_count; i++)
             {
-                auto curweight = m_blend_weight[i];
+                auto curweight = blend_weights[i];
                 length += curweight * m_blend_clip_file_length[i];
             }
             return length;